@@ -303,8 +303,8 @@ function(sfml_add_test target SOURCES DEPENDS)
         target_link_libraries(${target} PRIVATE ${DEPENDS})
     endif()
     
-    # Add the test
-    add_test(${target} ${target})
+    # Add the test, run from the test directory so that it finds its resources
+    add_test(NAME ${target} COMMAND ${target} WORKING_DIRECTORY "${PROJECT_SOURCE_DIR}/test")
 
     # If building shared libs on windows we must copy the dependencies into the folder
     if (WIN32 AND BUILD_SHARED_LIBS)
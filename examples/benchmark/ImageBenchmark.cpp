@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Size of the processed image, typical of a large texture
+    const unsigned int imageSize = 1024;
+
+    // Number of passes per measurement
+    const int passCount = 100;
+
+    // Defeat dead code elimination by consuming the results
+    unsigned int checksum = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// Run a function several times and return the throughput in millions of pixels per second
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Function>
+    float measure(Function function)
+    {
+        sf::Clock clock;
+
+        for (int pass = 0; pass < passCount; ++pass)
+            function();
+
+        float seconds = clock.getElapsedTime().asSeconds();
+        return static_cast<float>(imageSize * imageSize) * static_cast<float>(passCount) / seconds / 1000000.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Print a result line
+    ///
+    ////////////////////////////////////////////////////////////
+    void report(const char* name, float scalar, float vectorized, const sf::Image& expected, const sf::Image& result)
+    {
+        bool identical = std::equal(expected.getPixelsPtr(), expected.getPixelsPtr() + imageSize * imageSize * 4, result.getPixelsPtr());
+
+        std::cout << std::setw(20) << std::left << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << scalar << " Mpx/s"
+                  << std::setw(10) << vectorized << " Mpx/s"
+                  << std::setw(9) << std::setprecision(2) << (vectorized / scalar) << "x"
+                  << (identical ? "   identical" : "   MISMATCH") << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Reference versions of the operations, one pixel at a time
+    ////////////////////////////////////////////////////////////
+    void maskScalar(sf::Uint8* pixels, std::size_t count, const sf::Color& color, sf::Uint8 alpha)
+    {
+        for (sf::Uint8* ptr = pixels; ptr < pixels + count * 4; ptr += 4)
+        {
+            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
+                ptr[3] = alpha;
+        }
+    }
+
+    void blendScalar(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count * 4; i += 4)
+        {
+            sf::Uint8 alpha = src[i + 3];
+            dst[i + 0] = static_cast<sf::Uint8>((src[i + 0] * alpha + dst[i + 0] * (255 - alpha)) / 255);
+            dst[i + 1] = static_cast<sf::Uint8>((src[i + 1] * alpha + dst[i + 1] * (255 - alpha)) / 255);
+            dst[i + 2] = static_cast<sf::Uint8>((src[i + 2] * alpha + dst[i + 2] * (255 - alpha)) / 255);
+            dst[i + 3] = static_cast<sf::Uint8>(alpha + dst[i + 3] * (255 - alpha) / 255);
+        }
+    }
+
+    void flipHorizontallyScalar(sf::Uint8* pixels, unsigned int width, unsigned int height)
+    {
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            sf::Uint8* left  = pixels + y * width * 4;
+            sf::Uint8* right = left + (width - 1) * 4;
+            for (unsigned int x = 0; x < width / 2; ++x)
+            {
+                std::swap_ranges(left, left + 4, right);
+                left += 4;
+                right -= 4;
+            }
+        }
+    }
+
+    void flipVerticallyScalar(sf::Uint8* pixels, unsigned int width, unsigned int height)
+    {
+        std::size_t rowSize = width * 4;
+        for (unsigned int y = 0; y < height / 2; ++y)
+            std::swap_ranges(pixels + y * rowSize, pixels + (y + 1) * rowSize, pixels + (height - 1 - y) * rowSize);
+    }
+
+    void premultiplyScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        for (sf::Uint8* ptr = pixels; ptr < pixels + count * 4; ptr += 4)
+        {
+            ptr[0] = static_cast<sf::Uint8>((ptr[0] * ptr[3] + 127) / 255);
+            ptr[1] = static_cast<sf::Uint8>((ptr[1] * ptr[3] + 127) / 255);
+            ptr[2] = static_cast<sf::Uint8>((ptr[2] * ptr[3] + 127) / 255);
+        }
+    }
+
+    void swizzleScalar(sf::Uint8* pixels, std::size_t count)
+    {
+        for (sf::Uint8* ptr = pixels; ptr < pixels + count * 4; ptr += 4)
+            std::swap(ptr[0], ptr[2]);
+    }
+
+    void fillScalar(sf::Uint8* pixels, std::size_t count, const sf::Color& color)
+    {
+        for (sf::Uint8* ptr = pixels; ptr < pixels + count * 4; ptr += 4)
+        {
+            ptr[0] = color.r;
+            ptr[1] = color.g;
+            ptr[2] = color.b;
+            ptr[3] = color.a;
+        }
+    }
+
+    // Writable access to the pixels of an image, for the reference versions
+    sf::Uint8* pixelsOf(sf::Image& image)
+    {
+        return const_cast<sf::Uint8*>(image.getPixelsPtr());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    const std::size_t pixelCount = imageSize * imageSize;
+
+    // Build the input images, with a color key on a quarter of the pixels
+    // and fully opaque or transparent pixels mixed with translucent ones
+    const sf::Color key(255, 0, 255);
+    std::vector<sf::Uint8> pixels(pixelCount * 4);
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        sf::Uint8* pixel = &pixels[i * 4];
+        if (std::rand() % 4 == 0)
+        {
+            pixel[0] = key.r;
+            pixel[1] = key.g;
+            pixel[2] = key.b;
+            pixel[3] = key.a;
+        }
+        else
+        {
+            pixel[0] = static_cast<sf::Uint8>(std::rand());
+            pixel[1] = static_cast<sf::Uint8>(std::rand());
+            pixel[2] = static_cast<sf::Uint8>(std::rand());
+            pixel[3] = static_cast<sf::Uint8>(std::rand() % 3 == 0 ? 255 : std::rand());
+        }
+    }
+
+    sf::Image source;
+    source.create(imageSize, imageSize, &pixels[0]);
+
+    sf::Image scalar, vectorized;
+
+    std::cout << "Processing " << imageSize << "x" << imageSize << " pixels, " << passCount << " passes" << std::endl << std::endl;
+    std::cout << std::setw(20) << std::left << "operation" << std::right << std::setw(16) << "scalar loop" << std::setw(16) << "sf::Image" << std::setw(10) << "speedup" << std::endl;
+
+    // createMaskFromColor (the first pass masks the pixels, the next ones find no match)
+    scalar = source;
+    vectorized = source;
+    float scalarSpeed = measure([&] { maskScalar(pixelsOf(scalar), pixelCount, key, 0); checksum += scalar.getPixelsPtr()[3]; });
+    float vectorizedSpeed = measure([&] { vectorized.createMaskFromColor(key, 0); checksum += vectorized.getPixelsPtr()[3]; });
+    report("createMaskFromColor", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // copy with alpha blending (accumulates the source over the destination)
+    scalar = source;
+    vectorized = source;
+    scalarSpeed = measure([&] { blendScalar(source.getPixelsPtr(), pixelsOf(scalar), pixelCount); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.copy(source, 0, 0, sf::IntRect(0, 0, 0, 0), true); checksum += vectorized.getPixelsPtr()[0]; });
+    report("copy (applyAlpha)", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // flipHorizontally (an even number of passes restores the image)
+    scalar = source;
+    vectorized = source;
+    scalarSpeed = measure([&] { flipHorizontallyScalar(pixelsOf(scalar), imageSize, imageSize); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.flipHorizontally(); checksum += vectorized.getPixelsPtr()[0]; });
+    report("flipHorizontally", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // flipVertically
+    scalar = source;
+    vectorized = source;
+    scalarSpeed = measure([&] { flipVerticallyScalar(pixelsOf(scalar), imageSize, imageSize); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.flipVertically(); checksum += vectorized.getPixelsPtr()[0]; });
+    report("flipVertically", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // premultiplyAlpha (repeated passes keep darkening the image)
+    scalar = source;
+    vectorized = source;
+    scalarSpeed = measure([&] { premultiplyScalar(pixelsOf(scalar), pixelCount); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.premultiplyAlpha(); checksum += vectorized.getPixelsPtr()[0]; });
+    report("premultiplyAlpha", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // swizzleChannels (RGBA <-> BGRA)
+    scalar = source;
+    vectorized = source;
+    scalarSpeed = measure([&] { swizzleScalar(pixelsOf(scalar), pixelCount); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.swizzleChannels(2, 1, 0, 3); checksum += vectorized.getPixelsPtr()[0]; });
+    report("swizzleChannels", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    // fillRect over the whole image
+    const sf::Color fill(12, 34, 56, 78);
+    scalarSpeed = measure([&] { fillScalar(pixelsOf(scalar), pixelCount, fill); checksum += scalar.getPixelsPtr()[0]; });
+    vectorizedSpeed = measure([&] { vectorized.fillRect(sf::IntRect(0, 0, imageSize, imageSize), fill); checksum += vectorized.getPixelsPtr()[0]; });
+    report("fillRect", scalarSpeed, vectorizedSpeed, scalar, vectorized);
+
+    std::cout << std::endl << "(checksum " << checksum << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Size of the laid out string, in characters
+    const std::size_t stringLength = 1024 * 1024;
+
+    // Number of layouts per measurement
+    const int passCount = 20;
+
+    // Defeat dead code elimination by consuming the results
+    float checksum = 0.f;
+
+    ////////////////////////////////////////////////////////////
+    /// Run a function several times and return the throughput in megabytes of text per second
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Function>
+    float measure(Function function, int passes = passCount)
+    {
+        sf::Clock clock;
+
+        for (int pass = 0; pass < passes; ++pass)
+            function();
+
+        float seconds = clock.getElapsedTime().asSeconds();
+        return static_cast<float>(stringLength) * static_cast<float>(passes) / seconds / (1024.f * 1024.f);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Print a result line
+    ///
+    ////////////////////////////////////////////////////////////
+    void report(const char* name, float throughput)
+    {
+        std::cout << std::setw(24) << std::left << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(1) << throughput << " MB/s" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::Font font;
+    if (!font.loadFromFile("resources/tuffy.ttf"))
+        return EXIT_FAILURE;
+
+    // Build 1 MB of Latin-1 text, split into lines of 80 characters
+    const char* words[] = {"lorem ", "ipsum ", "dolor ", "sit ", "amet, ", "gr\xe4" "\xdf" "e ", "caf\xe9 ", "na\xefve ", "SFML "};
+    std::basic_string<sf::Uint32> characters;
+    characters.reserve(stringLength);
+    while (characters.size() < stringLength)
+    {
+        for (const char* word = words[std::rand() % (sizeof(words) / sizeof(*words))]; *word && (characters.size() < stringLength); ++word)
+        {
+            characters.push_back(static_cast<unsigned char>(*word));
+            if (characters.size() % 80 == 0)
+                characters.push_back('\n');
+        }
+    }
+    characters.resize(stringLength);
+    sf::String string(characters);
+
+    sf::Text text(string, font, 16);
+
+    std::cout << "Laying out " << stringLength << " characters, " << passCount << " passes" << std::endl << std::endl;
+
+    // First layout: loads and rasterizes the glyphs
+    report("first layout", measure([&]
+    {
+        checksum += text.getLocalBounds().width;
+    }, 1));
+
+    // Geometry rebuilds with all the glyphs in the cache
+    float lineSpacing = 1.f;
+    report("text layout", measure([&]
+    {
+        lineSpacing = (lineSpacing == 1.f) ? 1.01f : 1.f;
+        text.setLineSpacing(lineSpacing);
+        checksum += text.getLocalBounds().width;
+    }));
+
+    // Glyph lookups alone, the part of the layout that depends on the font cache
+    report("glyph lookups", measure([&]
+    {
+        float advance = 0.f;
+        for (std::size_t i = 0; i < stringLength; ++i)
+            advance += font.getGlyph(characters[i], 16, false).advance;
+        checksum += advance;
+    }));
+
+    // Copying the resulting geometry, as a lower bound
+    std::vector<sf::Vertex> source(stringLength * 6), destination(stringLength * 6);
+    report("vertex memcpy", measure([&]
+    {
+        std::memcpy(&destination[0], &source[0], source.size() * sizeof(sf::Vertex));
+        checksum += destination[stringLength].position.x;
+    }));
+
+    std::cout << std::endl << "(checksum " << checksum << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    // Number of points transformed per pass, typical of a large batch
+    const std::size_t pointCount = 16384;
+
+    // Number of passes per measurement
+    const int passCount = 500;
+
+    // Defeat dead code elimination by consuming the results
+    float checksum = 0.f;
+
+    ////////////////////////////////////////////////////////////
+    /// Run a function several times and return the throughput in millions of points per second
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Function>
+    float measure(Function function)
+    {
+        sf::Clock clock;
+
+        for (int pass = 0; pass < passCount; ++pass)
+            function();
+
+        float seconds = clock.getElapsedTime().asSeconds();
+        return static_cast<float>(pointCount) * static_cast<float>(passCount) / seconds / 1000000.f;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Print a result line
+    ///
+    ////////////////////////////////////////////////////////////
+    void report(const char* name, float scalar, float batched, float error)
+    {
+        std::cout << std::setw(10) << name
+                  << std::setw(12) << std::fixed << std::setprecision(1) << scalar << " Mpts/s"
+                  << std::setw(12) << batched << " Mpts/s"
+                  << std::setw(9) << std::setprecision(2) << (batched / scalar) << "x"
+                  << "   max error " << std::scientific << error << std::defaultfloat << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    sf::Transform transform;
+    transform.translate(120.f, 45.f).rotate(33.f).scale(1.5f, 0.75f);
+
+    // Build the input data
+    std::vector<sf::Vector2f> points(pointCount);
+    std::vector<sf::Vertex>   vertices(pointCount);
+    std::vector<sf::Vertex3D> vertices3D(pointCount);
+
+    for (std::size_t i = 0; i < pointCount; ++i)
+    {
+        float x = static_cast<float>(std::rand() % 1000);
+        float y = static_cast<float>(std::rand() % 1000);
+        float z = static_cast<float>(std::rand() % 1000);
+
+        points[i]     = sf::Vector2f(x, y);
+        vertices[i]   = sf::Vertex(sf::Vector2f(x, y), sf::Colors::White, sf::Vector2f(x, y));
+        vertices3D[i] = sf::Vertex3D(sf::Vector3f(x, y, z), sf::Colors::White, sf::Vector2f(x, y));
+    }
+
+    std::vector<sf::Vector2f> scalarPoints(pointCount), batchedPoints(pointCount);
+    std::vector<sf::Vertex>   scalarVertices(pointCount), batchedVertices(pointCount);
+    std::vector<sf::Vertex3D> scalarVertices3D(pointCount), batchedVertices3D(pointCount);
+
+    std::cout << "Transforming " << pointCount << " points, " << passCount << " passes" << std::endl << std::endl;
+    std::cout << std::setw(10) << "data" << std::setw(19) << "scalar loop" << std::setw(19) << "transformPoints" << std::setw(10) << "speedup" << std::endl;
+
+    // Vector2f
+    {
+        float scalar = measure([&]
+        {
+            for (std::size_t i = 0; i < pointCount; ++i)
+                scalarPoints[i] = transform.transformPoint(points[i]);
+            checksum += scalarPoints[pointCount / 2].x;
+        });
+
+        float batched = measure([&]
+        {
+            transform.transformPoints(&points[0], &batchedPoints[0], pointCount);
+            checksum += batchedPoints[pointCount / 2].x;
+        });
+
+        float error = 0.f;
+        for (std::size_t i = 0; i < pointCount; ++i)
+            error = std::max(error, std::max(std::fabs(scalarPoints[i].x - batchedPoints[i].x), std::fabs(scalarPoints[i].y - batchedPoints[i].y)));
+
+        report("Vector2f", scalar, batched, error);
+    }
+
+    // Vertex
+    {
+        float scalar = measure([&]
+        {
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                scalarVertices[i].position  = transform.transformPoint(vertices[i].position);
+                scalarVertices[i].color     = vertices[i].color;
+                scalarVertices[i].texCoords = vertices[i].texCoords;
+            }
+            checksum += scalarVertices[pointCount / 2].position.x;
+        });
+
+        float batched = measure([&]
+        {
+            transform.transformPoints(&vertices[0], &batchedVertices[0], pointCount);
+            checksum += batchedVertices[pointCount / 2].position.x;
+        });
+
+        float error = 0.f;
+        for (std::size_t i = 0; i < pointCount; ++i)
+            error = std::max(error, std::max(std::fabs(scalarVertices[i].position.x - batchedVertices[i].position.x),
+                                             std::fabs(scalarVertices[i].position.y - batchedVertices[i].position.y)));
+
+        report("Vertex", scalar, batched, error);
+    }
+
+    // Vertex3D
+    {
+        float scalar = measure([&]
+        {
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                scalarVertices3D[i].position  = transform.transformPoint(vertices3D[i].position);
+                scalarVertices3D[i].color     = vertices3D[i].color;
+                scalarVertices3D[i].texCoords = vertices3D[i].texCoords;
+            }
+            checksum += scalarVertices3D[pointCount / 2].position.x;
+        });
+
+        float batched = measure([&]
+        {
+            transform.transformPoints(&vertices3D[0], &batchedVertices3D[0], pointCount);
+            checksum += batchedVertices3D[pointCount / 2].position.x;
+        });
+
+        float error = 0.f;
+        for (std::size_t i = 0; i < pointCount; ++i)
+            error = std::max(error, std::max(std::fabs(scalarVertices3D[i].position.x - batchedVertices3D[i].position.x),
+                                             std::max(std::fabs(scalarVertices3D[i].position.y - batchedVertices3D[i].position.y),
+                                                      std::fabs(scalarVertices3D[i].position.z - batchedVertices3D[i].position.z))));
+
+        report("Vertex3D", scalar, batched, error);
+    }
+
+    std::cout << std::endl << "(checksum " << checksum << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
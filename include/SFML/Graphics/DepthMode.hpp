@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DEPTHMODE_HPP
+#define SFML_DEPTHMODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Depth testing and writing modes
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API DepthMode
+{
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the depth comparison functions
+    ///
+    /// A fragment passes the depth test when the comparison
+    /// between its depth and the depth stored in the depth
+    /// buffer succeeds.
+    ///
+    ////////////////////////////////////////////////////////
+    enum Function
+    {
+        Never,        //!< The test never passes
+        Less,         //!< Passes if the fragment is closer than the stored depth
+        LessEqual,    //!< Passes if the fragment is closer than or as close as the stored depth
+        Equal,        //!< Passes if the fragment has the stored depth
+        GreaterEqual, //!< Passes if the fragment is farther than or as far as the stored depth
+        Greater,      //!< Passes if the fragment is farther than the stored depth
+        NotEqual,     //!< Passes if the fragment doesn't have the stored depth
+        Always        //!< The test always passes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs a depth mode that disables depth testing and
+    /// writing (sf::DepthDisabled).
+    ///
+    ////////////////////////////////////////////////////////////
+    DepthMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the depth mode given the test function and write mask
+    ///
+    /// \param testFunction Function used to compare the fragment depth with the stored depth
+    /// \param writeEnabled Should the depth of the fragments passing the test be stored?
+    ///
+    ////////////////////////////////////////////////////////////
+    DepthMode(Function testFunction, bool writeEnabled = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the depth buffer is accessed at all
+    ///
+    /// \return False if the test always passes and nothing is written, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member Data
+    ////////////////////////////////////////////////////////////
+    Function function; //!< Depth comparison function
+    bool     write;    //!< Is writing to the depth buffer enabled?
+};
+
+////////////////////////////////////////////////////////////
+/// \relates DepthMode
+/// \brief Overload of the == operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if depth modes are equal, false if they are different
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const DepthMode& left, const DepthMode& right);
+
+////////////////////////////////////////////////////////////
+/// \relates DepthMode
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if depth modes are different, false if they are equal
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const DepthMode& left, const DepthMode& right);
+
+////////////////////////////////////////////////////////////
+// Commonly used depth modes
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API extern const DepthMode DepthDisabled;     //!< Don't test nor write depth
+SFML_GRAPHICS_API extern const DepthMode DepthTest;         //!< Keep the closest fragments and store their depth
+SFML_GRAPHICS_API extern const DepthMode DepthTestReadOnly; //!< Keep the closest fragments without storing their depth
+
+} // namespace sf
+
+
+#endif // SFML_DEPTHMODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DepthMode
+/// \ingroup graphics
+///
+/// sf::DepthMode is a class that controls how the depth buffer
+/// of a render target is used when drawing: which fragments
+/// pass the depth test, and whether they update the stored
+/// depth. It is part of sf::RenderStates.
+///
+/// Depth testing lets opaque 3D geometry (see sf::Vertex3D) be
+/// drawn in any order: with sf::DepthTest, fragments hidden
+/// behind already drawn ones are rejected, often before their
+/// color is even computed. Transparent geometry is usually
+/// drawn afterwards, sorted back to front, with
+/// sf::DepthTestReadOnly so that it doesn't hide what lies
+/// behind it.
+///
+/// The render target must have a depth buffer (see
+/// sf::ContextSettings::depthBits), which should be cleared
+/// with sf::RenderTarget::clearDepth at the start of each frame.
+///
+/// The default depth mode, sf::DepthDisabled, leaves the depth
+/// buffer untouched, which is what 2D rendering expects.
+///
+/// \code
+/// sf::RenderStates states;
+/// states.depthMode = sf::DepthTest;
+///
+/// window.clear();
+/// window.clearDepth();
+/// window.draw(&mesh[0], mesh.size(), sf::Triangles, states);
+/// \endcode
+///
+/// \see sf::RenderStates, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
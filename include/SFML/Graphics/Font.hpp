@@ -43,6 +43,13 @@ namespace sf
 {
 class InputStream;
 
+namespace priv
+{
+    class DistanceFieldShader;
+    class GlyphTable;
+    class SkylinePacker;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
 ///
@@ -60,6 +67,12 @@ public:
         std::string family; //!< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const unsigned int DistanceFieldSize;   //!< Character size of the distance field glyphs
+    static const unsigned int DistanceFieldSpread; //!< Distance covered by the field on each side of the glyph edges, in pixels of DistanceFieldSize
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -275,6 +288,57 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a range of glyphs in the background
+    ///
+    /// Rasterizing glyphs is the slow part of displaying a text
+    /// with new characters or a new size. This function starts
+    /// rasterizing the glyphs of the characters in range
+    /// [\a first, \a last] on a worker thread, and returns
+    /// immediately. Loading screens can use it to warm up the
+    /// font before the text is displayed.
+    ///
+    /// The worker thread opens its own instance of the font,
+    /// and only produces pixels: they are written to the font
+    /// texture by the thread using the font, the next time it
+    /// calls getGlyph, getTexture or isPreloading. Glyphs that
+    /// are requested before being preloaded are loaded
+    /// immediately as usual.
+    ///
+    /// Several ranges can be preloaded by calling this function
+    /// several times, they are rasterized in order.
+    ///
+    /// Only fonts loaded from a file or from memory can be
+    /// preloaded; fonts loaded from a stream can't be read by
+    /// two threads.
+    ///
+    /// \param first            Unicode code point of the first character to preload
+    /// \param last             Unicode code point of the last character to preload
+    /// \param characterSize    Reference character size
+    /// \param bold             Preload the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    ///
+    /// \return True if the glyphs are being preloaded, false if the font can't be preloaded
+    ///
+    /// \see isPreloading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool preload(Uint32 first, Uint32 last, unsigned int characterSize, bool bold = false, float outlineThickness = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are still being preloaded
+    ///
+    /// This function writes the glyphs rasterized so far by the
+    /// worker thread to the font textures, so it must be called
+    /// from the thread using the font.
+    ///
+    /// \return True if some glyphs are still being preloaded, false otherwise
+    ///
+    /// \see preload
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPreloading() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -302,34 +366,143 @@ public:
     bool isSmooth() const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Overload of assignment operator
+    /// \brief Enable or disable the distance field mode
     ///
-    /// \param right Instance to assign
+    /// In distance field mode, sf::Text draws the glyphs from
+    /// a single texture shared by all the character sizes,
+    /// where each glyph is stored once as a signed distance
+    /// field (the distance of each pixel to the glyph edge).
+    /// A built-in shader turns it back into a sharp shape at
+    /// any scale, and draws outlines of any thickness up to
+    /// DistanceFieldSpread pixels at DistanceFieldSize (thicker
+    /// outlines are clamped).
     ///
-    /// \return Reference to self
+    /// This avoids rasterizing the glyphs again for each
+    /// character size, and keeps them crisp when the text is
+    /// scaled or zoomed. The glyphs lose their hinting though,
+    /// so small texts look slightly blurrier than in the
+    /// default mode. Kerning is computed without hinting
+    /// compensation as well.
+    ///
+    /// Shaders must be available to render distance fields
+    /// properly, see Shader::isAvailable. This mode is
+    /// disabled by default.
+    ///
+    /// \param distanceField True to enable the distance field mode, false to disable it
+    ///
+    /// \see isDistanceField, getDistanceFieldGlyph
     ///
     ////////////////////////////////////////////////////////////
-    Font& operator =(const Font& right);
+    void setDistanceField(bool distanceField);
 
-private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the distance field mode is enabled or not
+    ///
+    /// \return True if the distance field mode is enabled, false if it is disabled
+    ///
+    /// \see setDistanceField
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceField() const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Retrieve a distance field glyph of the font
+    ///
+    /// The metrics of the glyph are given for a character size
+    /// of DistanceFieldSize, they must be scaled to draw the
+    /// glyph at another size. The texture rectangle and bounds
+    /// include DistanceFieldSpread pixels of distance field
+    /// around the glyph.
+    ///
+    /// The returned reference is only valid until the next
+    /// call to getDistanceFieldGlyph; copy the glyph to keep it
+    /// longer.
+    ///
+    /// This function works whether the distance field mode
+    /// is enabled or not.
+    ///
+    /// \param codePoint Unicode code point of the character to get
+    /// \param bold      Retrieve the bold version or the regular one?
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    /// \see getDistanceFieldTexture
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
-    {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+    const Glyph& getDistanceFieldGlyph(Uint32 codePoint, bool bold) const;
 
-        unsigned int width;  //!< Current width of the row
-        unsigned int top;    //!< Y position of the row into the texture
-        unsigned int height; //!< Height of the row
-    };
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the texture containing the distance field glyphs
+    ///
+    /// The distance to the glyph edges is stored in the alpha
+    /// channel: 0.5 is on the edge, 1 is DistanceFieldSpread
+    /// pixels inside the glyph and 0 is DistanceFieldSpread
+    /// pixels outside.
+    ///
+    /// \return Texture containing the distance field glyphs
+    ///
+    /// \see getDistanceFieldGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getDistanceFieldTexture() const;
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Set the maximum amount of memory used by each page of glyphs
+    ///
+    /// Glyphs are stored in one texture (page) per character
+    /// size, which grows as new glyphs are loaded. When a page
+    /// reaches this budget, or the maximum texture size, the
+    /// least recently used glyphs are evicted to make room for
+    /// new ones instead of growing the texture further.
+    ///
+    /// The budget is expressed in bytes of texture memory, a
+    /// page of NxN pixels using N*N*4 bytes. Pages that are
+    /// already larger than a new budget keep their size.
+    /// A budget of 0, the default, only limits the pages to
+    /// the maximum texture size.
+    ///
+    /// The glyphs of a sf::Text are not evicted to load another
+    /// glyph of the same text: when the page is full of them,
+    /// it grows beyond the budget instead, up to the maximum
+    /// texture size.
+    ///
+    /// Be aware that evicting glyphs modifies the page texture,
+    /// so a budget too small for the glyphs displayed at once
+    /// makes them be reloaded over and over. The references
+    /// returned by getGlyph for an evicted glyph become invalid.
+    ///
+    /// \param bytes Maximum size of a page, in bytes
+    ///
+    /// \see getPageMemoryBudget
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; //!< Table mapping a codepoint to its glyph
+    void setPageMemoryBudget(std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by each page of glyphs
+    ///
+    /// \return Maximum size of a page, in bytes (0 if unlimited)
+    ///
+    /// \see setPageMemoryBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageMemoryBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Font& operator =(const Font& right);
+
+private:
+
+    friend class Text;
+
+    struct Preloader;
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -338,11 +511,16 @@ private:
     struct Page
     {
         Page();
-
-        GlyphTable       glyphs;  //!< Table mapping code points to their corresponding glyph
-        Texture          texture; //!< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; //!< Y position of the next new row in the texture
-        std::vector<Row> rows;    //!< List containing the position of all the existing rows
+        Page(const Page& copy);
+        ~Page();
+        Page& operator =(const Page& right);
+
+        priv::GlyphTable*    glyphs;     //!< Table mapping glyph keys to their corresponding glyph
+        Texture              texture;    //!< Texture containing the pixels of the glyphs
+        priv::SkylinePacker* packer;     //!< Free space left above the glyphs of the texture
+        std::vector<IntRect> freeRects;  //!< Areas of the texture released by evicted glyphs
+        Uint64               useCounter; //!< Incremented each time a glyph of the page is requested
+        Uint64               pinnedFrom; //!< Glyphs requested after this value of the use counter are pinned
     };
 
     ////////////////////////////////////////////////////////////
@@ -351,6 +529,28 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size
+    ///
+    /// The page is created if it doesn't exist yet.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of glyphs of \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the glyph of a character in the font face
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Glyph index, 0 if the font has no glyph for \a codePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getCharIndex(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
@@ -364,9 +564,68 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the pixels of a glyph to a page
+    ///
+    /// \param page   Page of glyphs to write to
+    /// \param glyph  Glyph whose texture rectangle has the size of the pixels, receives its position in the page
+    /// \param pixels Pixels of the glyph, with padding
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeGlyph(Page& page, Glyph& glyph, const std::vector<Uint8>& pixels) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the glyphs rasterized by the preloading thread to their pages
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadPreloadedGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a new distance field glyph
+    ///
+    /// \param codePoint Unicode code point of the character to load
+    /// \param bold      Retrieve the bold version or the regular one?
+    ///
+    /// \return The distance field glyph corresponding to \a codePoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadDistanceFieldGlyph(Uint32 codePoint, bool bold) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader drawing the distance field glyphs
+    ///
+    /// The shader is created on first call.
+    ///
+    /// \return Distance field shader of the font
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::DistanceFieldShader& getDistanceFieldShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pin the glyphs of a page which are requested from now on
+    ///
+    /// sf::Text calls this function while it computes its
+    /// geometry, so that loading its glyphs doesn't evict the
+    /// ones it has already requested: the texture would change
+    /// again, and the text would be rebuilt on every draw.
+    ///
+    /// \param characterSize Character size of the page (ignored
+    ///                      for distance field fonts)
+    /// \param pin           True to pin the glyphs requested from
+    ///                      now on, false to unpin all the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void pinRequestedGlyphs(unsigned int characterSize, bool pin) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
+    /// The texture is grown if needed and allowed by the page
+    /// memory budget, otherwise the least recently used glyphs
+    /// are evicted until the rectangle fits. If all the glyphs
+    /// of the page are pinned, the texture grows beyond the
+    /// budget, up to the maximum texture size.
+    ///
     /// \param page   Page of glyphs to search in
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
@@ -376,6 +635,14 @@ private:
     ////////////////////////////////////////////////////////////
     IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum width and height of the page textures
+    ///
+    /// \return Maximum size of a page, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getMaximumPageSize() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
     ///
@@ -394,17 +661,27 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    void*                      m_stroker;     //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    //!< Reference counter used by implicit sharing
-    bool                       m_isSmooth;    //!< Status of the smooth filter
-    Info                       m_info;        //!< Information about the font
-    mutable PageTable          m_pages;       //!< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    void*                              m_library;             //!< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                              m_face;                //!< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                              m_streamRec;           //!< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    void*                              m_stroker;             //!< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    int*                               m_refCount;            //!< Reference counter used by implicit sharing
+    bool                               m_isSmooth;            //!< Status of the smooth filter
+    bool                               m_isDistanceField;     //!< Status of the distance field mode
+    std::size_t                        m_pageBudget;          //!< Maximum size of a page, in bytes
+    Info                               m_info;                //!< Information about the font
+    std::string                        m_sourceFile;          //!< Path of the font file, if loaded from a file
+    const void*                        m_sourceData;          //!< Font file in memory, if loaded from memory
+    std::size_t                        m_sourceSize;          //!< Size of m_sourceData, in bytes
+    mutable PageTable                  m_pages;               //!< Table containing the glyphs pages by character size
+    mutable Page*                      m_lastPage;            //!< Page returned by the last call to getPage
+    mutable unsigned int               m_lastPageSize;        //!< Character size of m_lastPage
+    mutable std::vector<Uint32>        m_charIndices;         //!< Glyph indices of the Latin-1 characters, filled on demand
+    mutable std::vector<Uint8>         m_pixelBuffer;         //!< Pixel buffer holding a glyph's pixels before being written to the texture
+    mutable priv::DistanceFieldShader* m_distanceFieldShader; //!< Shader drawing the distance field glyphs, created on demand
+    mutable Preloader*                 m_preloader;           //!< Worker thread rasterizing glyphs in the background, if any
     #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; //!< Asset file streamer (if loaded from file)
+    void*                              m_stream;              //!< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -448,6 +725,12 @@ private:
 /// used by a sf::Text (i.e. never write a function that
 /// uses a local sf::Font instance for creating a text).
 ///
+/// By default, glyphs are rasterized separately for each
+/// character size. Texts that are displayed at many sizes,
+/// or zoomed, can use the distance field mode instead (see
+/// setDistanceField), where each glyph is rasterized once
+/// and drawn sharply at any size by a shader.
+///
 /// Usage example:
 /// \code
 /// // Declare a new font
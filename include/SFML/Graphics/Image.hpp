@@ -47,6 +47,19 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Blending equations available to blit
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Blending
+    {
+        Replace,           //!< The source pixels replace the destination pixels
+        Alpha,             //!< The source is blended according to its alpha (same as copy with applyAlpha)
+        Add,               //!< The source color, multiplied by its alpha, is added to the destination
+        Multiply,          //!< The source and destination components are multiplied together
+        PremultipliedAlpha //!< Alpha blending for sources whose color is already multiplied by their alpha
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -138,6 +151,30 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from files on disk, in parallel
+    ///
+    /// The files are decoded by several threads at once, which
+    /// makes loading a large number of images (at startup, for
+    /// example) much faster on multi-core processors. Only the
+    /// decoding is done here: the images can then be uploaded
+    /// to textures, from the thread that owns the OpenGL context.
+    ///
+    /// \a images is resized to the number of files, each image
+    /// receiving the file at the same index in \a filenames.
+    /// The images that can't be loaded are left empty.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param images      Images to fill
+    /// \param threadCount Number of threads decoding the files, 0 to use one per processor core
+    ///
+    /// \return True if all the images were loaded successfully
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool loadFromFiles(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount = 0);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
     ///
@@ -216,6 +253,67 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels from another image onto this one, with a blending equation
+    ///
+    /// This function works like copy, but offers more ways of
+    /// combining the source pixels with the destination ones.
+    /// Components are saturated to 255 when the result would
+    /// exceed it (with the Add and PremultipliedAlpha modes).
+    ///
+    /// If \a sourceRect is empty, the whole image is copied.
+    ///
+    /// \param source     Source image to copy
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param sourceRect Sub-rectangle of the source image to copy
+    /// \param blending   Blending equation to apply
+    ///
+    /// \see copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void blit(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), Blending blending = Alpha);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill a rectangle of the image with a color
+    ///
+    /// The parts of the rectangle that are outside the image
+    /// are ignored.
+    ///
+    /// \param rectangle Area to fill, in pixels
+    /// \param color     Color to write to the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void fillRect(const IntRect& rectangle, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color of each pixel by its alpha
+    ///
+    /// Premultiplied images blend correctly with filtering and
+    /// can be drawn with sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha),
+    /// or blitted with the PremultipliedAlpha equation.
+    /// Calling this function twice darkens the image again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reorder the components of each pixel
+    ///
+    /// Each parameter is the index of the source component
+    /// (0 for red, 1 for green, 2 for blue, 3 for alpha) that
+    /// is written to the corresponding component. For example,
+    /// swizzleChannels(2, 1, 0, 3) converts between RGBA and BGRA.
+    /// Indices outside this range leave the image unchanged.
+    ///
+    /// \param red   Index of the component written to red
+    /// \param green Index of the component written to green
+    /// \param blue  Index of the component written to blue
+    /// \param alpha Index of the component written to alpha
+    ///
+    ////////////////////////////////////////////////////////////
+    void swizzleChannels(unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
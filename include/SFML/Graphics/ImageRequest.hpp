@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGEREQUEST_HPP
+#define SFML_IMAGEREQUEST_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Pending copy of pixels from the graphics card to an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageRequest : GlResource
+{
+    SFML_DISALLOW_COPY_MOVE(ImageRequest);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a request with no copy in progress.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageRequest();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageRequest();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a copy is in progress
+    ///
+    /// A copy is started by Texture::requestCopy or
+    /// RenderWindow::requestCapture, and ends when its pixels
+    /// are retrieved with getImage().
+    ///
+    /// \return True if a copy was requested and not retrieved yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels of the copy are available
+    ///
+    /// This function never blocks. When it returns true,
+    /// getImage() retrieves the pixels without waiting.
+    ///
+    /// \return True if the copy is finished, false if it is still in progress or if no copy was requested
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the pixels of the copy
+    ///
+    /// If the copy is not finished yet, this function waits
+    /// for it. Once the pixels are retrieved, the request can
+    /// be reused for another copy; its buffer is kept, so that
+    /// requests reused for copies of the same size don't
+    /// allocate graphics memory again.
+    ///
+    /// \param image Image to fill with the copied pixels
+    ///
+    /// \return True if the pixels were retrieved, false if no copy was requested
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImage(Image& image);
+
+private:
+
+    friend class Texture;
+    friend class RenderWindow;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the pixel buffer and bind it as the destination of pixel reads
+    ///
+    /// Any copy in progress is abandoned.
+    ///
+    /// \param size      Size of the requested image
+    /// \param rowLength Number of pixels in a row of the source
+    /// \param rowCount  Number of rows of the source
+    /// \param flipped   Are the rows of the source stored bottom to top?
+    ///
+    /// \return True if the pixel buffer is bound, false if asynchronous copies are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool beginCopy(const Vector2u& size, unsigned int rowLength, unsigned int rowCount, bool flipped);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the pixel buffer and mark the end of the copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void endCopy();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Complete the request right away with an image
+    ///
+    /// This is used when asynchronous copies are not supported.
+    ///
+    /// \param image Copied image
+    ///
+    ////////////////////////////////////////////////////////////
+    void setImage(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the fence of the copy in progress, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseFence();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int       m_buffer;    //!< Pixel buffer receiving the pixels
+    std::size_t        m_capacity;  //!< Size of the pixel buffer, in bytes
+    void*              m_fence;     //!< Fence signaled when the copy to the pixel buffer is finished
+    Vector2u           m_size;      //!< Size of the requested image
+    unsigned int       m_rowLength; //!< Number of pixels in a row of the source (larger than the width for padded textures)
+    bool               m_flipped;   //!< Are the rows of the source stored bottom to top?
+    bool               m_pending;   //!< Is a copy in progress?
+    std::vector<Uint8> m_pixels;    //!< Pixels copied synchronously, when pixel buffers are not supported
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEREQUEST_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageRequest
+/// \ingroup graphics
+///
+/// sf::ImageRequest holds a copy of pixels from the graphics
+/// card to the system memory, started by Texture::requestCopy
+/// or RenderWindow::requestCapture. Unlike Texture::copyToImage,
+/// the request returns immediately: the pixels are transferred
+/// to a pixel buffer by the graphics driver while the application
+/// keeps running, and retrieved later with getImage().
+///
+/// Rotating between two or three requests allows to capture
+/// every frame with a latency of one or two frames, without
+/// ever waiting for the graphics card:
+/// \code
+/// sf::ImageRequest requests[3];
+/// std::size_t frame = 0;
+///
+/// while (window.isOpen())
+/// {
+///     // draw...
+///
+///     sf::ImageRequest& request = requests[frame++ % 3];
+///     if (request.isPending())
+///     {
+///         sf::Image image;
+///         request.getImage(image); // captured two frames ago, normally ready
+///         recorder.write(image);
+///     }
+///     window.requestCapture(request);
+///
+///     window.display();
+/// }
+/// \endcode
+///
+/// When pixel buffers or sync objects are not supported by
+/// the system, the copy is performed synchronously when the
+/// request is started, and the request is ready right away.
+///
+/// \see sf::Texture, sf::RenderWindow
+///
+////////////////////////////////////////////////////////////
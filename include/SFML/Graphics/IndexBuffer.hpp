@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INDEXBUFFER_HPP
+#define SFML_INDEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Index buffer storage for indexed drawing of a vertex buffer
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API IndexBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of the indices stored in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum IndexType
+    {
+        Index16, //!< 16-bit indices (sf::Uint16), up to 65536 vertices
+        Index32  //!< 32-bit indices (sf::Uint32)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty index buffer of 16-bit indices.
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type
+    ///
+    /// Creates an empty index buffer and sets its index type to \p type.
+    ///
+    /// \param type Size of the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(IndexType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific usage specifier
+    ///
+    /// Creates an empty index buffer of 16-bit indices and sets
+    /// its usage to \p usage.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type and usage specifier
+    ///
+    /// \param type  Size of the indices
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(IndexType type, VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(const IndexBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the index buffer
+    ///
+    /// Creates the index buffer and allocates enough graphics
+    /// memory to hold \p indexCount indices of the current
+    /// index type. Any previously allocated memory is freed
+    /// in the process.
+    ///
+    /// In order to deallocate previously allocated memory pass 0
+    /// as \p indexCount. Don't forget to recreate with a non-zero
+    /// value when graphics memory should be allocated again.
+    ///
+    /// \param indexCount Number of indices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of 16-bit indices
+    ///
+    /// \p offset is specified as the number of indices to skip
+    /// from the beginning of the buffer.
+    ///
+    /// The resizing rules are the same as VertexBuffer::update:
+    /// if \p offset is 0 and \p indexCount is greater than the
+    /// size of the currently created buffer, a new buffer is
+    /// created containing the index data; if \p offset is not 0
+    /// and \p offset + \p indexCount is greater than the size of
+    /// the buffer, the update fails.
+    ///
+    /// The update also fails if the index type of the buffer
+    /// is not Index16.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint16* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of 32-bit indices
+    ///
+    /// Same as the 16-bit overload, except that the update
+    /// fails if the index type of the buffer is not Index32.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint32* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the contents of another buffer into this buffer
+    ///
+    /// Both buffers must have the same index type.
+    ///
+    /// \param indexBuffer Index buffer whose contents to copy into this index buffer
+    ///
+    /// \return True if the copy was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const IndexBuffer& indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer& operator =(const IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this index buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the index buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the index buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the indices stored in the buffer
+    ///
+    /// Changing the index type of a buffer that was already
+    /// created discards its contents: its index count drops
+    /// to 0, so that nothing is drawn from it and partial
+    /// updates fail until it is filled again with create()
+    /// or a full update().
+    ///
+    /// 32-bit indices are not supported on OpenGL ES, requesting
+    /// them there leaves the index type unchanged.
+    ///
+    /// The default index type is sf::IndexBuffer::Index16.
+    ///
+    /// \param type Size of the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setIndexType(IndexType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the indices stored in the buffer
+    ///
+    /// \return Index type
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexType getIndexType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this index buffer
+    ///
+    /// After changing the usage specifier, the index buffer has
+    /// to be updated with new data for the usage specifier to
+    /// take effect.
+    ///
+    /// The default usage is sf::VertexBuffer::Stream.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this index buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an index buffer for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::IndexBuffer with OpenGL code.
+    ///
+    /// \param indexBuffer Pointer to the index buffer to bind, can be null to use no index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const IndexBuffer* indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports index buffers
+    ///
+    /// Index buffers are available whenever vertex buffers are.
+    /// 32-bit indices are not supported on OpenGL ES.
+    ///
+    /// \return True if index buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a single index, in bytes
+    ///
+    /// \return Size of an index
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from raw index data
+    ///
+    /// \param indices    Raw index data, of the current index type
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateData(const void* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer; //!< Internal buffer identifier
+    std::size_t         m_size;   //!< Size in indices of the currently allocated buffer
+    IndexType           m_type;   //!< Size of the indices
+    VertexBuffer::Usage m_usage;  //!< How this index buffer is to be used
+};
+
+} // namespace sf
+
+
+#endif // SFML_INDEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::IndexBuffer
+/// \ingroup graphics
+///
+/// sf::IndexBuffer stores, in graphics memory, the indices of
+/// the vertices of a sf::VertexBuffer that make up each
+/// primitive. It allows vertices shared by several primitives
+/// to be stored only once: a grid of quads drawn as triangles
+/// needs 4 vertices per quad instead of 6.
+///
+/// A single vertex buffer can be drawn with several index
+/// buffers, or several ranges of the same index buffer, which
+/// makes it possible to share large static meshes.
+///
+/// 16-bit indices are enough to address 65536 vertices and use
+/// half the memory of 32-bit indices, which should only be
+/// used for larger vertex buffers.
+///
+/// Example:
+/// \code
+/// sf::Vertex vertices[4];
+/// sf::Uint16 indices[] = {0, 1, 2, 2, 1, 3};
+/// ...
+/// sf::VertexBuffer quad(sf::Triangles, sf::VertexBuffer::Static);
+/// quad.create(4);
+/// quad.update(vertices);
+///
+/// sf::IndexBuffer quadIndices(sf::IndexBuffer::Index16, sf::VertexBuffer::Static);
+/// quadIndices.create(6);
+/// quadIndices.update(indices, 6);
+/// ...
+/// window.draw(quad, quadIndices);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCEBUFFER_HPP
+#define SFML_INSTANCEBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Per-instance data used to draw many copies of a vertex buffer
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API InstanceBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attributes of a single instance
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Instance
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// The instance has an identity transform, is white and
+        /// has no texture offset.
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the instance from its attributes
+        ///
+        /// \param theTransform     Transform applied to the vertices of the instance
+        /// \param theColor         Color modulating the vertices of the instance
+        /// \param theTextureOffset Offset added to the texture coordinates of the instance
+        ///
+        ////////////////////////////////////////////////////////////
+        Instance(const Transform& theTransform, const Color& theColor = Colors::White,
+                 const Vector2f& theTextureOffset = Vector2f());
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Transform transform;     //!< Transform applied to the vertices of the instance
+        Color     color;         //!< Color modulating the vertices of the instance
+        Vector2f  textureOffset; //!< Offset added to the texture coordinates, in pixels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty instance buffer.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit InstanceBuffer(VertexBuffer::Usage usage = VertexBuffer::Stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceBuffer(const InstanceBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~InstanceBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    InstanceBuffer& operator =(const InstanceBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this instance buffer with those of another
+    ///
+    /// \param right Instance buffer to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(InstanceBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of instances
+    ///
+    /// \return Number of instances in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getInstanceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the buffer
+    ///
+    /// New instances are default-constructed.
+    ///
+    /// \param instanceCount New number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the instances of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an instance at the end of the buffer
+    ///
+    /// \param instance Instance to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Instance& instance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change an instance of the buffer
+    ///
+    /// \a index must be in range [0, getInstanceCount() - 1].
+    /// The result is undefined if \a index is out of range.
+    ///
+    /// \param index    Index of the instance to change
+    /// \param instance New attributes of the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstance(std::size_t index, const Instance& instance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an instance of the buffer
+    ///
+    /// \a index must be in range [0, getInstanceCount() - 1].
+    /// The result is undefined if \a index is out of range.
+    ///
+    /// \param index Index of the instance to get
+    ///
+    /// \return Attributes of the instance
+    ///
+    ////////////////////////////////////////////////////////////
+    const Instance& getInstance(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this instance buffer
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this instance buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports instanced rendering
+    ///
+    /// Instanced rendering requires OpenGL 3.3 and shaders. When
+    /// it is not available, RenderTarget::drawInstanced falls back
+    /// to expanding the instances on the CPU.
+    ///
+    /// \return True if instanced rendering is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the instances are uploaded to graphics memory
+    ///
+    /// \return True if the graphics memory is up to date, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool ensureUpload() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Instance>      m_instances;  //!< Instances, in system memory
+    VertexBuffer::Usage        m_usage;      //!< How this instance buffer is to be used
+    mutable unsigned int       m_buffer;     //!< Internal buffer identifier
+    mutable std::size_t        m_bufferSize; //!< Size in instances of the currently allocated buffer
+    mutable bool               m_needUpload; //!< Do the instances need to be uploaded again?
+    mutable std::vector<Uint8> m_packed;     //!< Instances in the layout of the graphics memory, kept between uploads to avoid reallocating
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCEBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InstanceBuffer
+/// \ingroup graphics
+///
+/// sf::InstanceBuffer holds the attributes that differ between
+/// the copies ("instances") of a mesh stored in a sf::VertexBuffer:
+/// a transform, a color modulating the vertex colors and an offset
+/// added to the texture coordinates (to pick a different frame
+/// of a sprite sheet, for example).
+///
+/// Drawing it with RenderTarget::drawInstanced renders all the
+/// instances with a single draw call when the system supports
+/// instanced rendering. The instances are kept in system memory
+/// and uploaded to graphics memory on the first draw after they
+/// are modified.
+///
+/// Example:
+/// \code
+/// sf::VertexBuffer bullet(sf::TriangleStrip, sf::VertexBuffer::Static);
+/// ...
+/// sf::InstanceBuffer bullets;
+/// for (std::size_t i = 0; i < positions.size(); ++i)
+///     bullets.append(sf::InstanceBuffer::Instance(sf::Transform().translate(positions[i])));
+/// ...
+/// window.drawInstanced(bullet, bullets, &texture);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/DepthMode.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
@@ -37,6 +38,7 @@ namespace sf
 {
 class Shader;
 class Texture;
+class TextureArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Define the states used for drawing to a RenderTarget
@@ -56,6 +58,8 @@ public:
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
+    /// \li the DepthDisabled depth mode
+    /// \li a null texture array
     ///
     ////////////////////////////////////////////////////////////
     RenderStates();
@@ -68,6 +72,14 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const BlendMode& theBlendMode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom depth mode
+    ///
+    /// \param theDepthMode Depth mode to use
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const DepthMode& theDepthMode);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a default set of render states with a custom transform
     ///
@@ -112,11 +124,13 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; //!< Blending mode
-    Transform      transform; //!< Transform
-    const Texture* texture;   //!< Texture
-    const Shader*  shader;    //!< Shader
-    float          pointSize;
+    BlendMode           blendMode;    //!< Blending mode
+    Transform           transform;    //!< Transform
+    const Texture*      texture;      //!< Texture
+    const Shader*       shader;       //!< Shader
+    float               pointSize;
+    DepthMode           depthMode;    //!< Depth testing and writing mode
+    const TextureArray* textureArray; //!< Texture array, drawn instead of the texture when not null
 };
 
 } // namespace sf
@@ -129,12 +143,14 @@ public:
 /// \class sf::RenderStates
 /// \ingroup graphics
 ///
-/// There are four global states that can be applied to
+/// There are six global states that can be applied to
 /// the drawn objects:
 /// \li the blend mode: how pixels of the object are blended with the background
 /// \li the transform: how the object is positioned/rotated/scaled
 /// \li the texture: what image is mapped to the object
 /// \li the shader: what custom effect is applied to the object
+/// \li the depth mode: how pixels of the object are tested against and written to the depth buffer
+/// \li the texture array: layers of images mapped to the object, replacing the texture
 ///
 /// High-level objects such as sprites or text force some of
 /// these states when they are drawn. For example, a sprite
@@ -39,13 +39,23 @@
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/Vertex3D.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class IndexBuffer;
+class InstanceBuffer;
 class VertexBuffer;
 
+namespace priv
+{
+    class InstancingShader;
+    class StreamBuffer;
+    class TextureArrayShader;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -72,6 +82,20 @@ public:
     ////////////////////////////////////////////////////////////
     void clear(const Color& color = Color(0, 0, 0, 255));
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the depth buffer of the target
+    ///
+    /// This function is usually called once every frame before
+    /// drawing depth-tested geometry (see sf::DepthMode). It has
+    /// no effect if the target has no depth buffer.
+    ///
+    /// Note that clear() also resets the depth buffer, to 1.
+    ///
+    /// \param depth Depth to fill the depth buffer with, in range [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearDepth(float depth = 1.f);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
     ///
@@ -282,6 +306,118 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and an index buffer
+    ///
+    /// The primitives are assembled from the vertices of
+    /// \a vertexBuffer designated by the indices of \a indexBuffer,
+    /// using the primitive type of the vertex buffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and a range of an index buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param firstIndex   Index of the first index to render
+    /// \param indexCount   Number of indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw many instances of a vertex buffer
+    ///
+    /// The vertices of \a vertexBuffer are rendered once per
+    /// instance of \a instanceBuffer, transformed by the instance
+    /// transform (then by \a states.transform), their color
+    /// modulated by the instance color and the instance texture
+    /// offset added to their texture coordinates.
+    ///
+    /// When instanced rendering is available (see
+    /// InstanceBuffer::isAvailable) and no shader is given in
+    /// \a states, all the instances are rendered with a single
+    /// draw call. Otherwise the instances are expanded into a
+    /// single vertex array on the CPU, which is not supported
+    /// on OpenGL ES nor for vertex buffers with the 3D layout.
+    /// The vertex buffer is then read back once and the copy
+    /// is reused until the buffer is updated through its own
+    /// functions (changes made with direct OpenGL calls on its
+    /// native handle are not detected).
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the mesh to draw
+    /// \param instanceBuffer Instances of the mesh
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws of vertex
+    /// arrays that share the same texture, blend mode, point
+    /// size and (compatible) primitive type are not sent to the
+    /// graphics card immediately. Their vertices are instead
+    /// pre-transformed and accumulated into a single vertex
+    /// stream, which is rendered with one draw call when the
+    /// states change, when flush() is called or when the
+    /// target is displayed.
+    ///
+    /// This is transparent for sprites, shapes, texts and
+    /// vertex arrays, but keep in mind that the textures used
+    /// by batched draws must stay alive and unmodified until
+    /// the batch is flushed.
+    ///
+    /// Draws that use a shader, a texture that belongs to a
+    /// render-texture, or strip/fan primitives that cannot be
+    /// merged are never batched: they flush any pending batch
+    /// and are rendered immediately.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the pending batch, if any
+    ///
+    /// This function is called automatically when the render
+    /// states change, when the view changes, when the target is
+    /// cleared or displayed, and before any draw that cannot be
+    /// batched. You only need to call it yourself before issuing
+    /// direct OpenGL commands, or before modifying a texture that
+    /// was used in a batched draw.
+    ///
+    /// This function does nothing if batching is disabled or if
+    /// there is nothing to render.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -399,6 +535,47 @@ protected:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Render primitives defined by an array of vertices, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the pending batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return True if the vertices were batched, false if they must be drawn immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    bool batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                       PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices to the stream buffer
+    ///
+    /// On success, the stream buffer is left bound and must be
+    /// unbound once the vertices have been drawn.
+    ///
+    /// \param vertices Pointer to the vertex data
+    /// \param size     Size of the vertex data, in bytes
+    /// \param data     Receives the pointer to pass to the gl*Pointer functions
+    ///
+    /// \return True if the vertices were uploaded, false if they must be sourced from client memory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool streamVertices(const void* vertices, std::size_t size, const char*& data);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -421,6 +598,22 @@ private:
     ////////////////////////////////////////////////////////////
     void applyBlendMode(const BlendMode& mode);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new depth mode
+    ///
+    /// \param mode Depth mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyDepthMode(const DepthMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the current depth mode disabled depth writes
+    ///
+    /// \return True if the depth mask must be enabled to clear the depth buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDepthMaskCleared() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new transform
     ///
@@ -454,6 +647,17 @@ private:
     ////////////////////////////////////////////////////////////
     void setupDraw(bool useVertexCache, const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a vertex buffer and source the vertices from it
+    ///
+    /// The vertex pointers are set up according to the vertex
+    /// layout of the buffer.
+    ///
+    /// \param vertexBuffer Vertex buffer to bind
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindVertexBuffer(const VertexBuffer& vertexBuffer);
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the primitives
     ///
@@ -464,6 +668,29 @@ private:
     ////////////////////////////////////////////////////////////
     void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives designated by the bound index buffer
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indexBuffer Bound index buffer
+    /// \param firstIndex  Index of the first index to use when drawing
+    /// \param indexCount  Number of indices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw instances of a vertex buffer with a single draw call
+    ///
+    /// \param vertexBuffer   Vertex buffer holding the mesh to draw
+    /// \param instanceBuffer Instances of the mesh
+    /// \param states         Render states to use for drawing
+    ///
+    /// \return True if the instances were drawn, false if they must be expanded on the CPU
+    ///
+    ////////////////////////////////////////////////////////////
+    bool drawInstancedPrimitives(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up environment after drawing
     ///
@@ -484,7 +711,9 @@ private:
         bool      glStatesSet;    //!< Are our internal GL states set yet?
         bool      viewChanged;    //!< Has the current view changed since last draw?
         BlendMode lastBlendMode;  //!< Cached blending mode
+        DepthMode lastDepthMode;  //!< Cached depth mode
         Uint64    lastTextureId;  //!< Cached texture
+        Uint64    lastTextureArrayId; //!< Cached texture array
         float     lastPointSize;  //!< Cached point size
         bool      texCoordsArrayEnabled; //!< Is GL_TEXTURE_COORD_ARRAY client state enabled?
         bool      useVertexCache; //!< Did we previously use the vertex cache?
@@ -492,13 +721,38 @@ private:
         Vertex3D  vertex3DCache[VertexCacheSize]; //!< Pre-transformed vertices cache
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pending batch of pre-transformed vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enabled;        //!< Is batching enabled?
+        PrimitiveType       type;           //!< Primitive type of the batched vertices
+        BlendMode           blendMode;      //!< Blend mode shared by the batched vertices
+        const Texture*      texture;        //!< Texture shared by the batched vertices
+        Uint64              textureId;      //!< Unique identifier of the texture, to detect recycled pointers
+        const TextureArray* textureArray;   //!< Texture array shared by the batched vertices
+        Uint64              textureArrayId; //!< Unique identifier of the texture array, to detect recycled pointers
+        float               pointSize;      //!< Point size shared by the batched vertices
+        DepthMode           depthMode;      //!< Depth mode shared by the batched vertices
+        std::vector<Vertex> vertices;       //!< Pre-transformed vertices waiting to be rendered
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; //!< Default view
-    View        m_view;        //!< Current view
-    StatesCache m_cache;       //!< Render states cache
-    Uint64      m_id;          //!< Unique number that identifies the RenderTarget
+    View                      m_defaultView;        //!< Default view
+    View                      m_view;               //!< Current view
+    StatesCache               m_cache;              //!< Render states cache
+    Batch                     m_batch;              //!< Pending batch of draws
+    Uint64                    m_id;                 //!< Unique number that identifies the RenderTarget
+    priv::StreamBuffer*       m_streamBuffer;       //!< Graphics memory the vertices of immediate draws are streamed to
+    priv::InstancingShader*   m_instancingShader;   //!< Built-in shader used by instanced draws
+    priv::TextureArrayShader* m_textureArrayShader; //!< Built-in shader used by draws from texture arrays
+    std::vector<Vertex>       m_instanceMesh;       //!< Copy of the last vertex buffer expanded by instanced draws without instancing support
+    Uint64                    m_instanceMeshId;     //!< Contents identifier of the vertex buffer that m_instanceMesh was read from
+    std::vector<Vertex>       m_instanceVertices;   //!< Scratch storage for expanded instances
 };
 
 } // namespace sf
@@ -529,6 +783,19 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// When many small entities are drawn with the same texture
+/// (sprites from a tileset, glyphs, particles, ...), batching can
+/// be enabled with setBatchingEnabled to merge their draws into
+/// as few draw calls as possible:
+/// \code
+/// window.setBatchingEnabled(true);
+/// ...
+/// window.clear();
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     window.draw(sprites[i]); // accumulated, not rendered yet
+/// window.display();            // rendered with a single draw call
+/// \endcode
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
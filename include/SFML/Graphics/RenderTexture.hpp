@@ -309,6 +309,10 @@ private:
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
-/// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
+/// Creating a render texture is expensive. Render textures that are
+/// only needed for a few draws, like the intermediate steps of
+/// post-processing effects, should be recycled with sf::RenderTexturePool.
+///
+/// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture, sf::RenderTexturePool
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycler of render textures of the same size and settings
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool
+{
+    SFML_DISALLOW_COPY_MOVE(RenderTexturePool);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render textures created by the pool,
+    /// including the ones that were not released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render texture of the given size and settings
+    ///
+    /// A released render texture with the same size and settings
+    /// is reused if there is one, with its frame buffer objects,
+    /// attachments and texture. Otherwise a new render texture
+    /// is created. The contents of a reused render texture are
+    /// undefined, they should be cleared before drawing. Its view
+    /// is reset to the default view, and its texture is neither
+    /// smooth nor repeated.
+    ///
+    /// The render texture belongs to the pool, it must not be
+    /// deleted but given back with release.
+    ///
+    /// \param width    Width of the render texture
+    /// \param height   Height of the render texture
+    /// \param settings Additional settings for the underlying OpenGL texture and context
+    ///
+    /// \return Pointer to the render texture, or NULL if its creation failed
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give back a render texture, so that it can be reused
+    ///
+    /// The render texture must have been returned by acquire,
+    /// and must not be used after being released.
+    ///
+    /// \param renderTexture Render texture to give back
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the released render textures
+    ///
+    /// This frees their graphics memory, for example after
+    /// the window was resized and the render textures of the
+    /// previous size won't be requested anymore. Render
+    /// textures that are in use are kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures created by the pool
+    ///
+    /// \return Number of render textures, in use or released
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render texture created by the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        RenderTexture*  renderTexture; //!< The render texture
+        Vector2u        size;          //!< Size it was created with
+        ContextSettings settings;      //!< Settings it was created with
+        bool            inUse;         //!< Was it acquired and not released yet?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; //!< Render textures created by the pool
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a render texture allocates a texture, frame buffer
+/// objects and depth or multisample buffers, which is far too
+/// slow to do every frame. Post-processing chains that need
+/// intermediate render textures for a few draws can instead
+/// acquire them from a sf::RenderTexturePool and release them
+/// once they are done, the pool then recycles them for the next
+/// requests of the same size and settings.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Every frame
+/// sf::RenderTexture* blurred = pool.acquire(width, height);
+/// blurred->clear();
+/// blurred->draw(sf::Sprite(scene.getTexture()), &blurShader);
+/// blurred->display();
+///
+/// window.draw(sf::Sprite(blurred->getTexture()), &bloomShader);
+///
+/// pool.release(blurred);
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -37,6 +37,8 @@
 
 namespace sf
 {
+class ImageRequest;
+
 ////////////////////////////////////////////////////////////
 /// \brief Window that can serve as a target for 2D drawing
 ///
@@ -157,6 +159,39 @@ public:
     ////////////////////////////////////////////////////////////
     SFML_DEPRECATED Image capture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the current contents of the window to an image, without waiting
+    ///
+    /// The contents of the back buffer are transferred by the
+    /// graphics driver while the application keeps running, and
+    /// retrieved later with ImageRequest::getImage(). This allows
+    /// to capture every frame, for recording videos for example,
+    /// without stalling the rendering. Any pending batch of draws
+    /// is rendered first, and any copy already in progress in
+    /// \a request is abandoned.
+    ///
+    /// This function must be called before display(), like
+    /// capture().
+    ///
+    /// \param request Request that receives the copy
+    ///
+    /// \return True if the copy was started, false if the window couldn't be activated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool requestCapture(ImageRequest& request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// Any pending batch of draws (see RenderTarget::setBatchingEnabled)
+    /// is rendered first, so that it is part of the displayed frame.
+    /// This function hides Window::display(): when the window
+    /// is displayed through a sf::Window reference, call flush()
+    /// before.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +45,12 @@ class Color;
 class InputStream;
 class Texture;
 class Transform;
+class UniformBuffer;
+
+namespace priv
+{
+    class DeferredUniformTable;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex, geometry and fragment)
@@ -83,6 +90,55 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a uniform variable of a shader
+    ///
+    /// Handles are returned by getUniform(), and can be passed
+    /// to setUniform() and setUniformArray() instead of the name
+    /// of the variable, to skip looking the name up.
+    ///
+    /// \see getUniform
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Uniform
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// This constructor creates an invalid handle, for which
+        /// setting a value does nothing.
+        ///
+        ////////////////////////////////////////////////////////////
+        Uniform();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a variable of the shader
+        ///
+        /// \return True if the variable was found in the shader, false otherwise
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const;
+
+    private:
+
+        friend class Shader;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the handle from a location
+        ///
+        /// \param location Location of the uniform in the program, or -1
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Uniform(int location);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        int m_location; //!< Location of the uniform in the program, -1 if not found
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -547,6 +603,284 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform variable
+    ///
+    /// The name is looked up once, and the returned handle can
+    /// then be used to set the value of the variable without
+    /// any string manipulation, which is faster for uniforms
+    /// that are set every frame:
+    /// \code
+    /// sf::Shader::Uniform time = shader.getUniform("time");
+    /// ...
+    /// shader.setUniform(time, clock.getElapsedTime().asSeconds());
+    /// \endcode
+    ///
+    /// Handles are only valid for the shader that returned them,
+    /// and until a new program is loaded into it.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the variable, invalid if it doesn't exist in the shader
+    ///
+    ////////////////////////////////////////////////////////////
+    Uniform getUniform(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param x       Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param x       Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param x       Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param vector  Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param matrix  Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param matrix  Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    /// \param texture Texture to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify current texture as \p sampler2D uniform
+    ///
+    /// \param uniform Handle of the uniform variable, returned by getUniform()
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const Uniform& uniform, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p float[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec2[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec3[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec4[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat3[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat4[] array uniform
+    ///
+    /// \param uniform     Handle of the uniform variable, returned by getUniform()
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const Uniform& uniform, const Glsl::Mat4* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify the buffer holding the values of a uniform block
+    ///
+    /// \a name is the name of the block in the shader, not the
+    /// name of an instance of the block. The buffer is bound
+    /// every time the shader is used, so it must exist as long
+    /// as the shader uses it, and its contents can be updated
+    /// at any time without setting it again.
+    ///
+    /// Uniform blocks require OpenGL 3.1, see
+    /// UniformBuffer::isAvailable().
+    ///
+    /// \param name   Name of the uniform block in GLSL
+    /// \param buffer Buffer holding the values of the block
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformBlock(const std::string& name, const UniformBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable deferred uniforms
+    ///
+    /// By default, setUniform() and setUniformArray() upload
+    /// the value immediately, which requires making the shader
+    /// the current program and restoring the previous one
+    /// afterwards. When uniforms are deferred, the values are
+    /// only stored in system memory, and uploaded the next time
+    /// the shader is bound (when something is drawn with it, or
+    /// with Shader::bind). This is much faster when many
+    /// uniforms are set between draws.
+    ///
+    /// When deferral is disabled, the values stored so far are
+    /// uploaded right away.
+    ///
+    /// Deferred uniforms are disabled by default.
+    ///
+    /// \param deferred True to defer uniform updates, false to apply them immediately
+    ///
+    /// \see areUniformsDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformsDeferred(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether uniform updates are deferred
+    ///
+    /// \return True if uniform updates are deferred, false otherwise
+    ///
+    /// \see setUniformsDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    bool areUniformsDeferred() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -662,6 +996,27 @@ public:
     ////////////////////////////////////////////////////////////
     static void bind(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the directory of the program cache
+    ///
+    /// When a cache directory is set, the programs linked by the
+    /// load functions are saved to it, and loaded back instead
+    /// of being compiled again the next time the same sources
+    /// are loaded. Cached programs are specific to the graphics
+    /// driver: when it rejects a binary (after a driver update
+    /// for example), the program is compiled from the sources
+    /// and the cache file is replaced.
+    ///
+    /// The cache requires OpenGL 4.1 or the ARB_get_program_binary
+    /// extension, the sources are always compiled otherwise.
+    /// The directory must exist and be writable. By default,
+    /// no cache directory is set and the cache is disabled.
+    ///
+    /// \param directory Path of the cache directory, or an empty string to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheDirectory(const std::string& directory);
+
     ////////////////////////////////////////////////////////////
     /// \brief Tell whether or not the system supports shaders
     ///
@@ -719,6 +1074,42 @@ private:
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the values of a float uniform (scalar, vector, matrix or array)
+    ///
+    /// \param location   Location of the uniform in the program
+    /// \param components Number of values per element: 1 to 4 for scalars and vectors, 9 or 16 for matrices
+    /// \param count      Number of elements, for arrays
+    /// \param values     Values of the elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformValues(int location, std::size_t components, std::size_t count, const float* values);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the values of an integer uniform (scalar, vector or array)
+    ///
+    /// \param location   Location of the uniform in the program
+    /// \param components Number of values per element, 1 to 4
+    /// \param count      Number of elements, for arrays
+    /// \param values     Values of the elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformValues(int location, std::size_t components, std::size_t count, const int* values);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the deferred uniforms to the program
+    ///
+    /// The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadDeferredUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the buffers of all the uniform blocks used by the shader
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindUniformBlocks() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader uniform
     ///
@@ -743,14 +1134,18 @@ private:
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> UniformTable;
+    typedef std::map<unsigned int, const UniformBuffer*> UniformBlockTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  //!< OpenGL identifier for the program
-    int          m_currentTexture; //!< Location of the current texture in the shader
-    TextureTable m_textures;       //!< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       //!< Parameters location cache
+    unsigned int                 m_shaderProgram;    //!< OpenGL identifier for the program
+    int                          m_currentTexture;   //!< Location of the current texture in the shader
+    TextureTable                 m_textures;         //!< Texture variables in the shader, mapped to their location
+    UniformTable                 m_uniforms;         //!< Parameters location cache
+    bool                         m_uniformsDeferred; //!< Are uniform values stored until the shader is bound?
+    priv::DeferredUniformTable*  m_deferredUniforms; //!< Uniform values waiting for the shader to be bound
+    UniformBlockTable            m_uniformBlocks;    //!< Buffers of the uniform blocks, mapped to the index of the block
 };
 
 } // namespace sf
@@ -816,6 +1211,18 @@ private:
 /// shader.setUniform("current", sf::Shader::CurrentTexture);
 /// \endcode
 ///
+/// Uniforms that are shared by many shaders and updated every
+/// frame can be grouped in a uniform block, whose values are
+/// stored in a sf::UniformBuffer and uploaded once for all the
+/// shaders (see setUniformBlock()). When many uniforms are set
+/// between draws, setUniformsDeferred() avoids switching the
+/// current program for each of them.
+///
+/// The name of a uniform can also be resolved once with
+/// getUniform(), and the returned handle passed to setUniform()
+/// instead of the name, which skips the lookup of the name
+/// every time the value is changed.
+///
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
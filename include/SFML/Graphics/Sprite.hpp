@@ -38,6 +38,7 @@
 namespace sf
 {
 class Texture;
+class TextureArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Drawable representation of a texture, with its
@@ -77,6 +78,29 @@ public:
     ////////////////////////////////////////////////////////////
     Sprite(const Texture& texture, const IntRect& rectangle);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sprite from a layer of a texture array
+    ///
+    /// \param textureArray Source texture array
+    /// \param layer        Index of the layer to display
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    Sprite(const TextureArray& textureArray, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sprite from a sub-rectangle of a layer of a texture array
+    ///
+    /// \param textureArray Source texture array
+    /// \param layer        Index of the layer to display
+    /// \param rectangle    Sub-rectangle of the layer to assign to the sprite
+    ///
+    /// \see setTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    Sprite(const TextureArray& textureArray, unsigned int layer, const IntRect& rectangle);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the source texture of the sprite
     ///
@@ -98,6 +122,28 @@ public:
     ////////////////////////////////////////////////////////////
     void setTexture(const Texture& texture, bool resetRect = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source of the sprite to a layer of a texture array
+    ///
+    /// The sprite then displays the texture rect within the given
+    /// layer. Sprites using the same texture array can be batched
+    /// together by the render target, whatever their layer.
+    /// Like a texture, the array must exist as long as the sprite
+    /// uses it, and it must be created before being assigned, as
+    /// the position of the layer depends on its size.
+    /// If \a resetRect is true, the TextureRect property of
+    /// the sprite is automatically adjusted to the size of the
+    /// layers. If it is false, the texture rect is left unchanged.
+    ///
+    /// \param textureArray New texture array
+    /// \param layer        Index of the layer to display
+    /// \param resetRect    Should the texture rect be reset to the size of the layers?
+    ///
+    /// \see getTextureArray, getLayer, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const TextureArray& textureArray, unsigned int layer, bool resetRect = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the sub-rectangle of the texture that the sprite will display
     ///
@@ -141,6 +187,29 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture* getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture array of the sprite
+    ///
+    /// If the sprite doesn't display a texture array, a NULL
+    /// pointer is returned.
+    ///
+    /// \return Pointer to the sprite's texture array
+    ///
+    /// \see setTexture, getLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    const TextureArray* getTextureArray() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the texture array displayed by the sprite
+    ///
+    /// \return Index of the layer, 0 if the sprite doesn't display a texture array
+    ///
+    /// \see setTexture, getTextureArray
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayer() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the sub-rectangle of the texture displayed by the sprite
     ///
@@ -215,9 +284,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vertex         m_vertices[4]; //!< Vertices defining the sprite's geometry
-    const Texture* m_texture;     //!< Texture of the sprite
-    IntRect        m_textureRect; //!< Rectangle defining the area of the source texture to display
+    Vertex              m_vertices[4];  //!< Vertices defining the sprite's geometry
+    const Texture*      m_texture;      //!< Texture of the sprite
+    const TextureArray* m_textureArray; //!< Texture array of the sprite, replaces the texture when not null
+    unsigned int        m_layer;        //!< Layer of the texture array to display
+    IntRect             m_textureRect;  //!< Rectangle defining the area of the source texture to display
 };
 
 } // namespace sf
@@ -255,6 +326,12 @@ private:
 /// used by a sf::Sprite (i.e. never write a function that
 /// uses a local sf::Texture instance for creating a sprite).
 ///
+/// A sprite can also display a layer of a sf::TextureArray.
+/// Sprites drawn from different layers of the same array
+/// share their render states, so that they can be merged
+/// into a single draw call by a render target with batching
+/// enabled, where sprites from different textures can't.
+///
 /// See also the note on coordinates and undistorted rendering in sf::Transformable.
 ///
 /// Usage example:
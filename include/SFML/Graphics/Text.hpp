@@ -33,7 +33,7 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Rect.hpp>
-#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/String.hpp>
 #include <string>
 #include <vector>
@@ -108,6 +108,51 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a string to the end of the text's string
+    ///
+    /// Unlike setString, this function only lays out again the
+    /// last line of the text, followed by the new lines. Its cost
+    /// depends on the size of the appended string, not on the
+    /// size of the whole text.
+    ///
+    /// \param string String to append
+    ///
+    /// \see insertString, eraseString
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendString(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a string into the text's string
+    ///
+    /// Only the lines touched by the insertion are laid out
+    /// again; the following lines are moved down if new lines
+    /// are inserted.
+    ///
+    /// \param position Index of the character before which the string is inserted
+    /// \param string   String to insert
+    ///
+    /// \see appendString, eraseString
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertString(std::size_t position, const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Erase characters from the text's string
+    ///
+    /// Only the lines touched by the erased range are laid out
+    /// again; the following lines are moved up if line breaks
+    /// are erased.
+    ///
+    /// \param position Index of the first character to erase
+    /// \param count    Number of characters to erase
+    ///
+    /// \see appendString, insertString
+    ///
+    ////////////////////////////////////////////////////////////
+    void eraseString(std::size_t position, std::size_t count = 1);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -377,6 +422,10 @@ public:
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
     ///
+    /// Only the line containing the character is walked, so the
+    /// cost of this function doesn't depend on the number of
+    /// lines of the text.
+    ///
     /// \param index Index of the character
     ///
     /// \return Position of the character
@@ -414,6 +463,23 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a line of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t first;               //!< Index of the first character of the line in the string
+        std::size_t vertexOffset;        //!< Index of the first fill vertex of the line
+        std::size_t outlineVertexOffset; //!< Index of the first outline vertex of the line
+        float       minX;                //!< Left of the line bounds
+        float       minY;                //!< Top of the line bounds
+        float       maxX;                //!< Right of the line bounds
+        float       maxY;                //!< Bottom of the line bounds
+        float       drawMinY;            //!< Top of the drawn geometry, underline and strike through included
+        float       drawMaxY;            //!< Bottom of the drawn geometry, underline and strike through included
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -432,23 +498,113 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the geometry of the lines touched by an edit of the string
+    ///
+    /// The string must already contain the edit. If the current
+    /// geometry can't be updated in place, the whole geometry
+    /// is scheduled for an update instead.
+    ///
+    /// \param position Index of the first edited character
+    /// \param erased   Number of characters erased at \a position
+    /// \param inserted Number of characters inserted at \a position
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateLines(std::size_t position, std::size_t erased, std::size_t inserted);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the geometry of a range of whole lines
+    ///
+    /// \param begin           Index of the first character of the first line
+    /// \param end             Index past the line break ending the last line, or size of the string
+    /// \param lineIndex       Index of the first line in the text
+    /// \param vertices        Vertex array receiving the fill geometry
+    /// \param outlineVertices Vertex array receiving the outline geometry
+    /// \param lines           Array receiving the lines, with vertex offsets relative to the arrays
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutLines(std::size_t begin, std::size_t end, std::size_t lineIndex, std::vector<Vertex>& vertices, std::vector<Vertex>& outlineVertices, std::vector<Line>& lines) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the line containing a character
+    ///
+    /// \param index Index of the character in the string
+    ///
+    /// \return Index of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findLine(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the bounding rectangle from the bounds of all the lines
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Grow the cached bounds by the bounds of a line
+    ///
+    /// The bounding rectangle itself is only updated by updateBoundsRect.
+    ///
+    /// \param index        Index of the line
+    /// \param lineDistance Distance between the baselines of two lines
+    ///
+    ////////////////////////////////////////////////////////////
+    void extendBounds(std::size_t index, float lineDistance) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a line reaches an edge of the cached bounds
+    ///
+    /// The bounds must be computed again when such a line is
+    /// removed or moved, the other lines may not reach as far.
+    ///
+    /// \param index        Index of the line
+    /// \param lineDistance Distance between the baselines of two lines
+    ///
+    /// \return True if the line is on an edge of the bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOnBoundsEdge(std::size_t index, float lineDistance) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the bounding rectangle from the cached bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBoundsRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the lines that may be visible in a render target
+    ///
+    /// \param target    Render target the text is drawn to
+    /// \param transform Transform of the text in the target
+    /// \param begin     Receives the index of the first visible line
+    /// \param end       Receives the index past the last visible line
+    ///
+    ////////////////////////////////////////////////////////////
+    void findVisibleLines(const RenderTarget& target, const Transform& transform, std::size_t& begin, std::size_t& end) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;              //!< String to display
-    const Font*         m_font;                //!< Font used to display the string
-    unsigned int        m_characterSize;       //!< Base size of characters, in pixels
-    float               m_letterSpacingFactor; //!< Spacing factor between letters
-    float               m_lineSpacingFactor;   //!< Spacing factor between lines
-    Uint32              m_style;               //!< Text style (see Style enum)
-    Color               m_fillColor;           //!< Text fill color
-    Color               m_outlineColor;        //!< Text outline color
-    float               m_outlineThickness;    //!< Thickness of the text's outline
-    mutable VertexArray m_vertices;            //!< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;     //!< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       //!< The font texture id
+    String                      m_string;              //!< String to display
+    const Font*                 m_font;                //!< Font used to display the string
+    unsigned int                m_characterSize;       //!< Base size of characters, in pixels
+    float                       m_letterSpacingFactor; //!< Spacing factor between letters
+    float                       m_lineSpacingFactor;   //!< Spacing factor between lines
+    Uint32                      m_style;               //!< Text style (see Style enum)
+    Color                       m_fillColor;           //!< Text fill color
+    Color                       m_outlineColor;        //!< Text outline color
+    float                       m_outlineThickness;    //!< Thickness of the text's outline
+    mutable std::vector<Vertex> m_vertices;            //!< Vertex array containing the fill geometry
+    mutable std::vector<Vertex> m_outlineVertices;     //!< Vertex array containing the outline geometry
+    mutable std::vector<Line>   m_lines;               //!< Geometry of each line, to update the lines separately
+    mutable FloatRect           m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
+    mutable Vector2f            m_boundsMin;           //!< Top-left corner of the bounds, as merged from the lines
+    mutable Vector2f            m_boundsMax;           //!< Bottom-right corner of the bounds, as merged from the lines
+    mutable float               m_lineTop;             //!< Highest top of the drawn lines, relative to their baseline
+    mutable float               m_lineBottom;          //!< Lowest bottom of the drawn lines, relative to their baseline
+    mutable bool                m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
+    mutable Uint64              m_fontTextureId;       //!< The font texture id
 };
 
 } // namespace sf
@@ -490,6 +646,12 @@ private:
 /// used by a sf::Text (i.e. never write a function that
 /// uses a local sf::Font instance for creating a text).
 ///
+/// Texts are laid out and drawn line by line: editing the string
+/// with appendString, insertString or eraseString only updates
+/// the lines that changed, and only the lines inside the view of
+/// the render target are drawn. This keeps large texts, such as
+/// logs, cheap to edit and to scroll.
+///
 /// See also the note on coordinates and undistorted rendering in sf::Transformable.
 ///
 /// Usage example:
@@ -35,6 +35,7 @@
 
 namespace sf
 {
+class ImageRequest;
 class InputStream;
 class RenderTarget;
 class RenderTexture;
@@ -115,6 +116,16 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX (version 1) files containing block compressed
+    /// pixels (BC1 to BC5, BC7 or ETC2) are not decoded: their
+    /// blocks, including the mipmap levels, are uploaded as they
+    /// are, which saves memory and upload bandwidth. Such files
+    /// can only be loaded entirely (\a area must be empty), and
+    /// the loading fails if the graphics driver doesn't support
+    /// their format, so that an uncompressed version can be
+    /// loaded instead. Compressed textures can't be updated from
+    /// pixels.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -146,6 +157,16 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX (version 1) files containing block compressed
+    /// pixels (BC1 to BC5, BC7 or ETC2) are not decoded: their
+    /// blocks, including the mipmap levels, are uploaded as they
+    /// are, which saves memory and upload bandwidth. Such files
+    /// can only be loaded entirely (\a area must be empty), and
+    /// the loading fails if the graphics driver doesn't support
+    /// their format, so that an uncompressed version can be
+    /// loaded instead. Compressed textures can't be updated from
+    /// pixels.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -178,6 +199,16 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// DDS and KTX (version 1) files containing block compressed
+    /// pixels (BC1 to BC5, BC7 or ETC2) are not decoded: their
+    /// blocks, including the mipmap levels, are uploaded as they
+    /// are, which saves memory and upload bandwidth. Such files
+    /// can only be loaded entirely (\a area must be empty), and
+    /// the loading fails if the graphics driver doesn't support
+    /// their format, so that an uncompressed version can be
+    /// loaded instead. Compressed textures can't be updated from
+    /// pixels.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -232,11 +263,29 @@ public:
     ///
     /// \return Image containing the texture's pixels
     ///
-    /// \see loadFromImage
+    /// \see loadFromImage, requestCopy
     ///
     ////////////////////////////////////////////////////////////
     Image copyToImage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the texture pixels to an image, without waiting
+    ///
+    /// This function is the asynchronous version of copyToImage():
+    /// it returns immediately, and the pixels are retrieved later
+    /// with ImageRequest::getImage(), once ImageRequest::isReady()
+    /// returns true. Any copy already in progress in \a request
+    /// is abandoned.
+    ///
+    /// \param request Request that receives the copy
+    ///
+    /// \return True if the copy was started, false if the texture was not created
+    ///
+    /// \see copyToImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool requestCopy(ImageRequest& request) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the whole texture from an array of pixels
     ///
@@ -314,6 +363,29 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Texture& texture, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a region of another texture to this texture
+    ///
+    /// The pixels are copied by the graphics card, with
+    /// glCopyImageSubData when available (OpenGL 4.3) or with
+    /// a framebuffer blit otherwise. They only go through system
+    /// memory if neither is supported.
+    ///
+    /// The source may be this texture, as long as the source
+    /// region and the destination region don't overlap.
+    /// Compressed textures can be copied to uncompressed ones,
+    /// through system memory since their blocks must be decoded,
+    /// but can't be the destination of a copy.
+    ///
+    /// \param source      Texture to copy from
+    /// \param sourceRect  Region of the source texture to copy
+    /// \param destination Position in this texture where to copy the region
+    ///
+    /// \return True if the copy was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyRegion(const Texture& source, const IntRect& sourceRect, const Vector2u& destination);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from an image
     ///
@@ -388,6 +460,88 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Window& window, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start an asynchronous update of a part of the texture
+    ///
+    /// This function returns a staging area of \a width x \a height
+    /// 32-bits RGBA pixels, which must be filled before calling
+    /// endAsyncUpdate(). Writing directly into the staging area
+    /// avoids an extra copy of the pixels, see updateAsync() for
+    /// the version that copies them from an existing array.
+    ///
+    /// The staging area is a pixel buffer mapped in memory, so
+    /// it can only be written to, and not read from, and it is
+    /// not valid anymore after endAsyncUpdate() is called.
+    ///
+    /// No additional check is performed on the bounds of the area
+    /// to update, passing invalid arguments will lead to an
+    /// undefined behavior.
+    ///
+    /// \param width  Width of the area to update
+    /// \param height Height of the area to update
+    /// \param x      X offset in the texture of the area to update
+    /// \param y      Y offset in the texture of the area to update
+    ///
+    /// \return Pointer to the staging area, or a null pointer if the texture was not created or another update is already in progress
+    ///
+    /// \see endAsyncUpdate, updateAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* beginAsyncUpdate(unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish an asynchronous update of the texture
+    ///
+    /// This function starts the transfer of the staging area
+    /// returned by beginAsyncUpdate() to the texture, and returns
+    /// immediately. The transfer is performed by the graphics
+    /// driver, and the texture can be drawn right away: the draw
+    /// calls wait for the transfer to be finished on the GPU
+    /// side, without stalling the application.
+    ///
+    /// \return Identifier of the update, to pass to isAsyncUpdateComplete(), or 0 if no update was started
+    ///
+    /// \see beginAsyncUpdate, isAsyncUpdateComplete
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 endAsyncUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Asynchronously update a part of the texture from an array of pixels
+    ///
+    /// This function is a shortcut that copies \a pixels to the
+    /// staging area of beginAsyncUpdate() and calls endAsyncUpdate().
+    /// Unlike update(), it returns as soon as the pixels are
+    /// copied, and \a pixels can be reused immediately.
+    ///
+    /// \param pixels Array of pixels to copy to the texture
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the texture where to copy the source pixels
+    /// \param y      Y offset in the texture where to copy the source pixels
+    ///
+    /// \return Identifier of the update, to pass to isAsyncUpdateComplete(), or 0 if the update failed
+    ///
+    /// \see isAsyncUpdateComplete
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an asynchronous update is finished
+    ///
+    /// Once an update is complete, the pixel buffer that it used
+    /// can be reused without waiting. A few updates can be in
+    /// flight at the same time, starting a new update when they
+    /// are all still in progress waits for the oldest one.
+    ///
+    /// \param update Identifier of the update, returned by endAsyncUpdate() or updateAsync()
+    ///
+    /// \return True if the transfer of the pixels is finished, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncUpdateComplete(Uint64 update) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the smooth filter
     ///
@@ -613,6 +767,26 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a DDS or KTX container in memory
+    ///
+    /// \param data Pointer to the contents of the container
+    /// \param size Size of the contents of the container, in bytes
+    /// \param area Area of the image to load, must be empty or cover the whole image
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedMemory(const void* data, std::size_t size, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ring of pixel buffers used by asynchronous updates
+    ///
+    /// Implementation is private in the .cpp file.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UploadRing;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -625,7 +799,9 @@ private:
     mutable bool m_pixelsFlipped; //!< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; //!< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     //!< Has the mipmap been generated?
+    bool         m_isCompressed;  //!< Does the texture store pre-compressed blocks?
     Uint64       m_cacheId;       //!< Unique number that identifies the texture to the render target's cache
+    UploadRing*  m_uploadRing;    //!< Pixel buffers of the asynchronous updates, created on first use
 };
 
 } // namespace sf
@@ -668,6 +844,11 @@ private:
 /// store the collision information separately, for example in an array
 /// of booleans.
 ///
+/// Textures that are updated every frame, like video frames, can be
+/// updated asynchronously with updateAsync(), or by writing directly
+/// into the staging area returned by beginAsyncUpdate(). The pixels
+/// are then transferred by the driver without stalling the application.
+///
 /// Like sf::Image, sf::Texture can handle a unique internal
 /// representation of pixels, which is RGBA 32 bits. This means
 /// that a pixel must be composed of 8 bits red, green, blue and
@@ -0,0 +1,306 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Stack of images of the same size living on the
+///        graphics card, sampled as a single texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource
+{
+    SFML_DISALLOW_COPY_MOVE(TextureArray);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const unsigned int MaximumStackHeight; //!< Maximum height of the layers times their number (see getLayerOffset)
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// The contents of the layers are undefined. If the array
+    /// was already created, its previous contents are lost.
+    ///
+    /// The height of the layers times their number must not
+    /// exceed MaximumStackHeight.
+    ///
+    /// \param width  Width of each layer
+    /// \param height Height of each layer
+    /// \param layers Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see getMaximumLayerCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layers);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array from a list of images
+    ///
+    /// Each image fills a layer, in order. The layers take the
+    /// size of the largest image, smaller images are copied to
+    /// the top-left corner of their layer.
+    ///
+    /// \param images Images to copy to the layers
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImages(const std::vector<Image>& images);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an image
+    ///
+    /// No additional check is performed on the size of the image
+    /// or the layer index, passing invalid arguments will lead to
+    /// an undefined behavior.
+    ///
+    /// This function does nothing if the array was not
+    /// previously created.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param layer Index of the layer to update
+    /// \param x     X offset in the layer where to copy the source image
+    /// \param y     Y offset in the layer where to copy the source image
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, unsigned int layer, unsigned int x = 0, unsigned int y = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers, 0 if the array was not created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the offset of the texture coordinates of a layer
+    ///
+    /// Texture coordinates address the layers as if they were
+    /// stacked vertically in a single texture: the pixels of
+    /// layer \a n start at a Y coordinate of \a n times the
+    /// height of the layers. Adding this offset to coordinates
+    /// expressed within a layer selects that layer.
+    ///
+    /// The coordinates are single precision floats, and the
+    /// layer is recovered from them for each pixel: the stack
+    /// is limited to MaximumStackHeight pixels, which keeps the
+    /// coordinates of the last layer precise to 1/128 of a pixel.
+    ///
+    /// \param layer Index of the layer (must be lower than getLayerCount())
+    ///
+    /// \return Offset to add to the texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getLayerOffset(unsigned int layer) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// Unlike an atlas, the filtering never reads pixels from
+    /// the neighbouring layers.
+    /// The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the texture array or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture array for rendering
+    ///
+    /// The array is bound to the GL_TEXTURE_2D_ARRAY target of
+    /// the active texture unit, for use with a \p sampler2DArray
+    /// in custom shaders.
+    /// \code
+    /// sf::TextureArray a1, a2;
+    /// ...
+    /// sf::TextureArray::bind(&a1);
+    /// // draw OpenGL stuff that use a1...
+    /// sf::TextureArray::bind(&a2);
+    /// // draw OpenGL stuff that use a2...
+    /// sf::TextureArray::bind(NULL);
+    /// // draw OpenGL stuff that use no texture array...
+    /// \endcode
+    ///
+    /// \param textureArray Pointer to the texture array to bind, can be null to use no texture array
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const TextureArray* textureArray);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports texture arrays
+    ///
+    /// Texture arrays require the EXT_texture_array extension
+    /// (core since OpenGL 3.0), and shaders to be drawn.
+    ///
+    /// \return True if texture arrays are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers allowed
+    ///
+    /// \return Maximum number of layers allowed
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u     m_size;     //!< Size of each layer
+    unsigned int m_layers;   //!< Number of layers
+    unsigned int m_texture;  //!< Internal texture identifier
+    bool         m_isSmooth; //!< Status of the smooth filter
+    Uint64       m_cacheId;  //!< Unique number that identifies the texture array to the render target's cache
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray holds several images of the same size,
+/// called layers, in a single OpenGL texture. Sprites that
+/// use different layers of the same array share their render
+/// states, so that sf::RenderTarget can batch them into a
+/// single draw call, where sprites using different textures
+/// (or different pages of an atlas) would each require their
+/// own. Unlike a large texture, the layers don't count
+/// towards sf::Texture::getMaximumSize.
+///
+/// Sprites select their layer with sf::Sprite::setTexture.
+/// Other drawables assign the array to sf::RenderStates::textureArray,
+/// and select the layer of each vertex through its texture
+/// coordinates: layer \a n is addressed as if the layers were
+/// stacked vertically in one texture, starting at a Y coordinate
+/// of \a n times the height of the layers (see getLayerOffset).
+///
+/// Arrays are drawn with a built-in shader. A custom shader
+/// can replace it, in which case the array is bound to
+/// texture unit 0 and should be sampled with a \p sampler2DArray
+/// set to sf::Shader::CurrentTexture.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Image> pages(3);
+/// pages[0].loadFromFile("tiles.png");
+/// pages[1].loadFromFile("characters.png");
+/// pages[2].loadFromFile("items.png");
+///
+/// sf::TextureArray array;
+/// if (!array.loadFromImages(pages))
+///     return -1;
+///
+/// sf::Sprite hero(array, 1, sf::IntRect(0, 0, 32, 48));
+/// sf::Sprite sword(array, 2, sf::IntRect(64, 0, 16, 16));
+///
+/// window.setBatchingEnabled(true);
+/// window.draw(hero);
+/// window.draw(sword); // merged with the hero
+/// window.display();
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite, sf::RenderStates
+///
+////////////////////////////////////////////////////////////
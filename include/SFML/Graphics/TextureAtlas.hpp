@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+namespace priv
+{
+    class SkylinePacker;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Collection of images packed into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas
+{
+    SFML_DISALLOW_COPY_MOVE(TextureAtlas);
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an image added to the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Handle;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Handle InvalidHandle; //!< Handle returned when an image could not be added
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty atlas
+    ///
+    /// Pages are square textures of \a pageSize pixels, clamped
+    /// to the maximum texture size. \a padding transparent pixels
+    /// are kept between the images so that smoothing or rounding
+    /// errors don't make neighbours bleed into each other.
+    ///
+    /// \param pageSize Width and height of the atlas pages, in pixels
+    /// \param padding  Space between the images, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(unsigned int pageSize = 2048, unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is packed into the first page with enough free
+    /// room, or into a new page, and only its region of the page
+    /// texture is uploaded.
+    ///
+    /// \param image Image to add
+    ///
+    /// \return Handle of the image, or InvalidHandle if it is larger than a page
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle add(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file and add it to the atlas
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return Handle of the image, or InvalidHandle if it could not be loaded or added
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle addFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add several images to the atlas
+    ///
+    /// Adding many images at once packs them tighter than adding
+    /// them one by one, because they are inserted from the
+    /// tallest to the shortest.
+    ///
+    /// \param images  Images to add
+    /// \param handles Receives the handle of each image, in the same order
+    ///
+    /// \return True if all the images were added, false if some are invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const std::vector<Image>& images, std::vector<Handle>& handles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from files and add them to the atlas
+    ///
+    /// \param filenames Paths of the image files to load
+    /// \param handles   Receives the handle of each image, in the same order
+    ///
+    /// \return True if all the images were loaded and added, false if some are invalid
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromFiles(const std::vector<std::string>& filenames, std::vector<Handle>& handles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the page containing an image
+    ///
+    /// The texture stays valid, at the same address, as long
+    /// as the atlas is not cleared or destroyed.
+    ///
+    /// \a handle must be a valid handle returned by this atlas.
+    ///
+    /// \param handle Handle of the image
+    ///
+    /// \return Texture containing the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of its page texture covered by an image
+    ///
+    /// \a handle must be a valid handle returned by this atlas.
+    ///
+    /// \param handle Handle of the image
+    ///
+    /// \return Rectangle of the image in its page texture, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getTextureRect(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images in the atlas
+    ///
+    /// \return Number of images added since the last clear
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getImageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages of the atlas
+    ///
+    /// \return Number of page textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// \a index must be in range [0, getPageCount() - 1].
+    ///
+    /// \param index Index of the page
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getPageTexture(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the pages
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see Texture::setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the images and release the pages
+    ///
+    /// All the handles and page textures become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture of the atlas, with its packing state
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Page();
+
+        Texture               texture; //!< Texture holding the images of the page
+        priv::SkylinePacker*  packer;  //!< Free space of the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image in the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        std::size_t page; //!< Index of the page containing the image
+        IntRect     rect; //!< Area of the page covered by the image
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack an image into a page and upload it
+    ///
+    /// \param image  Image to add
+    /// \param region Receives the location of the image
+    ///
+    /// \return True on success, false if the image can't fit in a page
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(const Image& image, Region& region);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_pageSize; //!< Size of the pages
+    unsigned int        m_padding;  //!< Space between the images
+    bool                m_smooth;   //!< Smooth filter of the pages
+    std::deque<Page>    m_pages;    //!< Pages of the atlas; a deque keeps the textures at stable addresses
+    std::vector<Region> m_regions;  //!< Location of the images, indexed by handle
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Drawing many sprites that use different small textures
+/// forces a texture change between each of them, which
+/// prevents batching and costs driver time. sf::TextureAtlas
+/// packs many images into a few large textures ("pages"), so
+/// that sprites referring to images of the same page can be
+/// drawn together.
+///
+/// Images are packed with a skyline bottom-left packer. Each
+/// image is identified by a handle, giving the page texture
+/// and the rectangle of the image inside it, ready to be
+/// passed to sf::Sprite::setTexture and
+/// sf::Sprite::setTextureRect. Handles stay valid until the
+/// atlas is cleared.
+///
+/// Images can be added at any time: only the region of the
+/// page covered by a new image is uploaded to the graphics
+/// card. When many images are available at once, adding them
+/// together packs them tighter.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+/// std::vector<sf::TextureAtlas::Handle> handles;
+/// if (!atlas.addFromFiles(filenames, handles))
+///     // some images could not be added...
+///
+/// sf::Sprite sprite;
+/// sprite.setTexture(atlas.getTexture(handles[0]));
+/// sprite.setTextureRect(atlas.getTextureRect(handles[0]));
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite, sf::Image
+///
+////////////////////////////////////////////////////////////
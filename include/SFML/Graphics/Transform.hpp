@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <array>
+#include <cstddef>
 
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
@@ -38,6 +39,9 @@
 
 namespace sf
 {
+class Vertex;
+class Vertex3D;
+
 ////////////////////////////////////////////////////////////
 /// \brief Define a 3x3 transform matrix
 ///
@@ -142,6 +146,54 @@ public:
 
     Vector3f transformPoint(const Vector3f& point) const noexcept;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// The result is the same as calling transformPoint on each
+    /// point, but the points are processed several at a time
+    /// with the SIMD instructions available to the build (SSE,
+    /// AVX or NEON), falling back to a scalar loop otherwise.
+    ///
+    /// \a points and \a result may be the same array, but must
+    /// not partially overlap.
+    ///
+    /// \param points Array of points to transform
+    /// \param result Array receiving the transformed points
+    /// \param count  Number of points to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of vertices
+    ///
+    /// The colors and texture coordinates are copied unchanged.
+    ///
+    /// \a vertices and \a result may be the same array, but must
+    /// not partially overlap.
+    ///
+    /// \param vertices Array of vertices to transform
+    /// \param result   Array receiving the transformed vertices
+    /// \param count    Number of vertices to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vertex* vertices, Vertex* result, std::size_t count) const noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform the positions of an array of 3D vertices
+    ///
+    /// The colors and texture coordinates are copied unchanged.
+    ///
+    /// \a vertices and \a result may be the same array, but must
+    /// not partially overlap.
+    ///
+    /// \param vertices Array of vertices to transform
+    /// \param result   Array receiving the transformed vertices
+    /// \param count    Number of vertices to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vertex3D* vertices, Vertex3D* result, std::size_t count) const noexcept;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
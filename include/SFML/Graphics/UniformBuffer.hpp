@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Block of shader uniforms stored in graphics memory
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : GlResource
+{
+    SFML_DISALLOW_COPY_MOVE(UniformBuffer);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit UniformBuffer(VertexBuffer::Usage usage = VertexBuffer::Dynamic);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the uniform buffer
+    ///
+    /// Allocates \a size bytes of graphics memory, with undefined
+    /// contents. If the buffer was already created, its previous
+    /// contents are lost.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of bytes
+    ///
+    /// The data must follow the layout of the uniform block in
+    /// the shaders (the \p std140 layout is the simplest to
+    /// reproduce in C++). If \a offset is 0 and \a size is the
+    /// size of the buffer, its whole storage is replaced, so that
+    /// updating it every frame doesn't wait for the previous
+    /// draws to complete.
+    ///
+    /// \param data   Pointer to the bytes to copy
+    /// \param size   Number of bytes to copy
+    /// \param offset Offset in the buffer to copy to, in bytes
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const void* data, std::size_t size, std::size_t offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this uniform buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the uniform buffer
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the uniform buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// Uniform buffers require OpenGL 3.1 and shaders.
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer; //!< Internal buffer identifier
+    std::size_t         m_size;   //!< Size of the buffer, in bytes
+    VertexBuffer::Usage m_usage;  //!< How this uniform buffer is to be used
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// sf::UniformBuffer stores the values of a uniform block in
+/// graphics memory. A uniform block is a group of uniforms
+/// declared together in GLSL:
+/// \code
+/// layout(std140) uniform Frame
+/// {
+///     mat4  viewProjection;
+///     vec4  lightColor;
+///     float time;
+/// };
+/// \endcode
+///
+/// Unlike regular uniforms, which belong to a single shader
+/// and are set one by one, the contents of a uniform buffer
+/// are uploaded with a single call and can be shared by any
+/// number of shaders. This is the most efficient way to pass
+/// per-frame data, such as the time or the camera, to all the
+/// shaders of a scene.
+///
+/// The data is uploaded as raw bytes, which must match the
+/// layout of the block in the shaders. With the \p std140
+/// layout, scalars take 4 bytes, and vectors of 3 or 4
+/// components and matrix columns are aligned to 16 bytes.
+///
+/// Usage example:
+/// \code
+/// struct Frame
+/// {
+///     float viewProjection[16];
+///     float lightColor[4];
+///     float time;
+///     float padding[3];
+/// };
+///
+/// sf::UniformBuffer buffer;
+/// buffer.create(sizeof(Frame));
+///
+/// sceneShader.setUniformBlock("Frame", buffer);
+/// particleShader.setUniformBlock("Frame", buffer);
+///
+/// // Every frame
+/// Frame frame;
+/// ...
+/// buffer.update(&frame, sizeof(frame));
+/// \endcode
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
@@ -38,9 +38,10 @@ namespace sf
 {
 class RenderTarget;
 class Vertex;
+class Vertex3D;
 
 ////////////////////////////////////////////////////////////
-/// \brief Vertex buffer storage for one or more 2D primitives
+/// \brief Vertex buffer storage for one or more 2D or 3D primitives
 ///
 ////////////////////////////////////////////////////////////
 class SFML_GRAPHICS_API VertexBuffer : public Drawable, private GlResource
@@ -64,6 +65,16 @@ public:
         Static   //!< Rarely changing data
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout of the vertices stored in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum VertexLayout
+    {
+        Layout2D, //!< Vertices are sf::Vertex
+        Layout3D  //!< Vertices are sf::Vertex3D
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -104,6 +115,19 @@ public:
     ////////////////////////////////////////////////////////////
     VertexBuffer(PrimitiveType type, Usage usage);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a VertexBuffer with a specific PrimitiveType, usage specifier and vertex layout
+    ///
+    /// Creates an empty vertex buffer and sets its primitive type
+    /// to \p type, usage to \p usage and vertex layout to \p layout.
+    ///
+    /// \param type   Type of primitive
+    /// \param usage  Usage specifier
+    /// \param layout Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer(PrimitiveType type, Usage usage, VertexLayout layout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy constructor
     ///
@@ -122,8 +146,9 @@ public:
     /// \brief Create the vertex buffer
     ///
     /// Creates the vertex buffer and allocates enough graphics
-    /// memory to hold \p vertexCount vertices. Any previously
-    /// allocated memory is freed in the process.
+    /// memory to hold \p vertexCount vertices of the current
+    /// layout. Any previously allocated memory is freed in the
+    /// process.
     ///
     /// In order to deallocate previously allocated memory pass 0
     /// as \p vertexCount. Don't forget to recreate with a non-zero
@@ -154,8 +179,9 @@ public:
     /// array, passing invalid arguments will lead to undefined
     /// behavior.
     ///
-    /// This function does nothing if \a vertices is null or if the
-    /// buffer was not previously created.
+    /// This function does nothing if \a vertices is null, if the
+    /// buffer was not previously created or if its layout is not
+    /// sf::VertexBuffer::Layout2D.
     ///
     /// \param vertices Array of vertices to copy to the buffer
     ///
@@ -197,9 +223,41 @@ public:
     ////////////////////////////////////////////////////////////
     bool update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of 3D vertices
+    ///
+    /// This function behaves like update(const Vertex*), but
+    /// requires the layout of the buffer to be
+    /// sf::VertexBuffer::Layout3D.
+    ///
+    /// \param vertices Array of vertices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex3D* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of 3D vertices
+    ///
+    /// This function behaves like update(const Vertex*, std::size_t, unsigned int),
+    /// but requires the layout of the buffer to be
+    /// sf::VertexBuffer::Layout3D.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex3D* vertices, std::size_t vertexCount, unsigned int offset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the contents of another buffer into this buffer
     ///
+    /// Both buffers must have the same vertex layout.
+    ///
     /// \param vertexBuffer Vertex buffer whose contents to copy into this vertex buffer
     ///
     /// \return True if the copy was successful
@@ -283,6 +341,44 @@ public:
     ////////////////////////////////////////////////////////////
     Usage getUsage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layout of the vertices stored in the buffer
+    ///
+    /// The layout defines whether the buffer holds sf::Vertex
+    /// or sf::Vertex3D elements, and therefore which update
+    /// functions are accepted and how the vertices are sourced
+    /// when drawing.
+    ///
+    /// Changing the layout of a buffer that was already created
+    /// discards its contents: its vertex count drops to 0, so
+    /// that nothing is drawn from it. create() must then be
+    /// called with the new vertex count before updating the
+    /// buffer, since update() without a count would copy 0
+    /// vertices and updates at a non-zero offset fail.
+    ///
+    /// The default layout is sf::VertexBuffer::Layout2D.
+    ///
+    /// \param layout Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexLayout(VertexLayout layout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices stored in the buffer
+    ///
+    /// \return Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexLayout getVertexLayout() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a vertex stored in the buffer
+    ///
+    /// \return Size of a vertex of the current layout, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexSize() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a vertex buffer for rendering
     ///
@@ -329,8 +425,22 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices of the current layout to the buffer
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateData(const void* vertices, std::size_t vertexCount, unsigned int offset);
+
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -338,6 +448,8 @@ private:
     std::size_t   m_size;          //!< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; //!< Type of primitives to draw
     Usage         m_usage;         //!< How this vertex buffer is to be used
+    VertexLayout  m_layout;        //!< Layout of the vertices stored in the buffer
+    Uint64        m_cacheId;       //!< Unique number that identifies the contents of the buffer to the render targets
 };
 
 } // namespace sf
@@ -403,6 +515,19 @@ private:
 /// window.draw(triangles);
 /// \endcode
 ///
-/// \see sf::Vertex, sf::VertexArray
+/// 3D geometry is stored by setting the sf::VertexBuffer::Layout3D
+/// layout, so that static meshes are uploaded once and rendered
+/// without being copied from system memory every frame:
+/// \code
+/// std::vector<sf::Vertex3D> mesh;
+/// ...
+/// sf::VertexBuffer model(sf::Triangles, sf::VertexBuffer::Static, sf::VertexBuffer::Layout3D);
+/// model.create(mesh.size());
+/// model.update(&mesh[0]);
+/// ...
+/// window.draw(model);
+/// \endcode
+///
+/// \see sf::Vertex, sf::Vertex3D, sf::VertexArray, sf::IndexBuffer
 ///
 ////////////////////////////////////////////////////////////
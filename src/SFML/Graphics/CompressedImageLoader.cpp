@@ -0,0 +1,472 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    // Signatures of the containers
+    const sf::Uint8 ddsSignature[4] = {'D', 'D', 'S', ' '};
+    const sf::Uint8 ktxSignature[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    // Size of the signature that identifies a container
+    const std::size_t signatureSize = 12;
+
+    // DDS header flags
+    const sf::Uint32 ddsdMipMapCount  = 0x20000;
+    const sf::Uint32 ddpfFourCC       = 0x4;
+    const sf::Uint32 ddsCaps2Cubemap  = 0x200;
+    const sf::Uint32 ddsCaps2Volume   = 0x200000;
+
+    // Read a little-endian 32-bits value
+    sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint32>(data[0])       |
+               static_cast<sf::Uint32>(data[1]) << 8  |
+               static_cast<sf::Uint32>(data[2]) << 16 |
+               static_cast<sf::Uint32>(data[3]) << 24;
+    }
+
+    // Build a DDS four-character code
+    sf::Uint32 fourCC(char a, char b, char c, char d)
+    {
+        return static_cast<sf::Uint32>(static_cast<sf::Uint8>(a))       |
+               static_cast<sf::Uint32>(static_cast<sf::Uint8>(b)) << 8  |
+               static_cast<sf::Uint32>(static_cast<sf::Uint8>(c)) << 16 |
+               static_cast<sf::Uint32>(static_cast<sf::Uint8>(d)) << 24;
+    }
+
+    // Get the size of a 4x4 block of a format, in bytes
+    std::size_t getBlockSize(sf::priv::CompressedImage::Format format)
+    {
+        switch (format)
+        {
+            case sf::priv::CompressedImage::Bc1:
+            case sf::priv::CompressedImage::Bc4:
+            case sf::priv::CompressedImage::Etc2Rgb:
+                return 8;
+
+            default:
+                return 16;
+        }
+    }
+
+    // Get the size of the blocks of a level, in bytes
+    std::size_t getLevelSize(sf::priv::CompressedImage::Format format, const sf::Vector2u& size)
+    {
+        std::size_t blocksX = (size.x + 3) / 4;
+        std::size_t blocksY = (size.y + 3) / 4;
+
+        return blocksX * blocksY * getBlockSize(format);
+    }
+
+    // Get the size of the next mipmap level
+    sf::Vector2u getNextLevelSize(const sf::Vector2u& size)
+    {
+        return sf::Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+    }
+
+    // Get the number of levels of a complete mipmap chain, down to 1x1
+    sf::Uint32 getMaximumLevelCount(const sf::Vector2u& size)
+    {
+        sf::Uint32 count = 1;
+        for (unsigned int side = std::max(size.x, size.y); side > 1; side /= 2)
+            ++count;
+
+        return count;
+    }
+
+    // Convert a DDS pixel format to a compression format
+    bool getDdsFormat(sf::Uint32 fourCode, sf::Uint32 dxgiFormat, sf::priv::CompressedImage::Format& format)
+    {
+        if (fourCode == fourCC('D', 'X', '1', '0'))
+        {
+            switch (dxgiFormat)
+            {
+                case 70: case 71: case 72: format = sf::priv::CompressedImage::Bc1; return true; // BC1 typeless, unorm, srgb
+                case 73: case 74: case 75: format = sf::priv::CompressedImage::Bc2; return true; // BC2 typeless, unorm, srgb
+                case 76: case 77: case 78: format = sf::priv::CompressedImage::Bc3; return true; // BC3 typeless, unorm, srgb
+                case 79: case 80:          format = sf::priv::CompressedImage::Bc4; return true; // BC4 typeless, unorm
+                case 82: case 83:          format = sf::priv::CompressedImage::Bc5; return true; // BC5 typeless, unorm
+                case 97: case 98: case 99: format = sf::priv::CompressedImage::Bc7; return true; // BC7 typeless, unorm, srgb
+                default:                   return false;
+            }
+        }
+
+        if (fourCode == fourCC('D', 'X', 'T', '1'))
+            format = sf::priv::CompressedImage::Bc1;
+        else if ((fourCode == fourCC('D', 'X', 'T', '2')) || (fourCode == fourCC('D', 'X', 'T', '3')))
+            format = sf::priv::CompressedImage::Bc2;
+        else if ((fourCode == fourCC('D', 'X', 'T', '4')) || (fourCode == fourCC('D', 'X', 'T', '5')))
+            format = sf::priv::CompressedImage::Bc3;
+        else if ((fourCode == fourCC('A', 'T', 'I', '1')) || (fourCode == fourCC('B', 'C', '4', 'U')))
+            format = sf::priv::CompressedImage::Bc4;
+        else if ((fourCode == fourCC('A', 'T', 'I', '2')) || (fourCode == fourCC('B', 'C', '5', 'U')))
+            format = sf::priv::CompressedImage::Bc5;
+        else
+            return false;
+
+        return true;
+    }
+
+    // Convert a KTX internal format (an OpenGL enum) to a compression format
+    bool getKtxFormat(sf::Uint32 internalFormat, sf::priv::CompressedImage::Format& format)
+    {
+        switch (internalFormat)
+        {
+            case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            case 0x83F1: // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            case 0x8C4C: // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+            case 0x8C4D: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+                format = sf::priv::CompressedImage::Bc1;
+                return true;
+
+            case 0x83F2: // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+            case 0x8C4E: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+                format = sf::priv::CompressedImage::Bc2;
+                return true;
+
+            case 0x83F3: // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            case 0x8C4F: // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+                format = sf::priv::CompressedImage::Bc3;
+                return true;
+
+            case 0x8DBB: // GL_COMPRESSED_RED_RGTC1
+                format = sf::priv::CompressedImage::Bc4;
+                return true;
+
+            case 0x8DBD: // GL_COMPRESSED_RG_RGTC2
+                format = sf::priv::CompressedImage::Bc5;
+                return true;
+
+            case 0x8E8C: // GL_COMPRESSED_RGBA_BPTC_UNORM
+            case 0x8E8D: // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+                format = sf::priv::CompressedImage::Bc7;
+                return true;
+
+            case 0x8D64: // GL_ETC1_RGB8_OES, ETC2 decoders are backward compatible
+            case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+            case 0x9275: // GL_COMPRESSED_SRGB8_ETC2
+                format = sf::priv::CompressedImage::Etc2Rgb;
+                return true;
+
+            case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+            case 0x9279: // GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+                format = sf::priv::CompressedImage::Etc2Rgba;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    // Parse a DDS container
+    bool parseDds(const sf::Uint8* data, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        const std::size_t headerSize = 128;
+        const std::size_t dx10HeaderSize = 20;
+
+        if ((size < headerSize) || (readUint32(data + 4) != 124))
+        {
+            sf::err() << "Failed to load DDS image, the header is invalid" << std::endl;
+            return false;
+        }
+
+        sf::Uint32 flags       = readUint32(data + 8);
+        sf::Uint32 height      = readUint32(data + 12);
+        sf::Uint32 width       = readUint32(data + 16);
+        sf::Uint32 mipMapCount = readUint32(data + 28);
+        sf::Uint32 pixelFlags  = readUint32(data + 80);
+        sf::Uint32 fourCode    = readUint32(data + 84);
+        sf::Uint32 caps2       = readUint32(data + 112);
+
+        if ((width == 0) || (height == 0))
+        {
+            sf::err() << "Failed to load DDS image, the size is invalid (" << width << "x" << height << ")" << std::endl;
+            return false;
+        }
+
+        if (!(pixelFlags & ddpfFourCC))
+        {
+            sf::err() << "Failed to load DDS image, only block compressed formats are supported" << std::endl;
+            return false;
+        }
+
+        std::size_t offset = headerSize;
+        sf::Uint32 dxgiFormat = 0;
+        sf::Uint32 arraySize = 1;
+        if (fourCode == fourCC('D', 'X', '1', '0'))
+        {
+            if (size < headerSize + dx10HeaderSize)
+            {
+                sf::err() << "Failed to load DDS image, the header is invalid" << std::endl;
+                return false;
+            }
+
+            dxgiFormat = readUint32(data + headerSize);
+            arraySize  = readUint32(data + headerSize + 12);
+            offset    += dx10HeaderSize;
+        }
+
+        if ((caps2 & (ddsCaps2Cubemap | ddsCaps2Volume)) || (arraySize > 1))
+        {
+            sf::err() << "Failed to load DDS image, only 2D textures are supported (not cube maps, arrays or volumes)" << std::endl;
+            return false;
+        }
+
+        if (!getDdsFormat(fourCode, dxgiFormat, image.format))
+        {
+            sf::err() << "Failed to load DDS image, unsupported pixel format" << std::endl;
+            return false;
+        }
+
+        image.size = sf::Vector2u(width, height);
+        image.levels.clear();
+
+        // Levels past the 1x1 one are ignored, padded files may declare more
+        sf::Uint32 levelCount = (flags & ddsdMipMapCount) ? std::max(mipMapCount, 1u) : 1u;
+        levelCount = std::min(levelCount, getMaximumLevelCount(image.size));
+        sf::Vector2u levelSize = image.size;
+        for (sf::Uint32 i = 0; i < levelCount; ++i)
+        {
+            std::size_t byteCount = getLevelSize(image.format, levelSize);
+            if (byteCount > size - offset)
+            {
+                sf::err() << "Failed to load DDS image, the file is truncated" << std::endl;
+                return false;
+            }
+
+            sf::priv::CompressedImage::Level level = {levelSize, data + offset, byteCount};
+            image.levels.push_back(level);
+
+            offset += byteCount;
+            levelSize = getNextLevelSize(levelSize);
+        }
+
+        return true;
+    }
+
+    // Parse a KTX (version 1) container
+    bool parseKtx(const sf::Uint8* data, std::size_t size, sf::priv::CompressedImage& image)
+    {
+        const std::size_t headerSize = 64;
+
+        if ((size < headerSize) || (readUint32(data + 12) != 0x04030201))
+        {
+            sf::err() << "Failed to load KTX image, the header is invalid or uses big-endian values" << std::endl;
+            return false;
+        }
+
+        sf::Uint32 glType         = readUint32(data + 16);
+        sf::Uint32 internalFormat = readUint32(data + 28);
+        sf::Uint32 width          = readUint32(data + 36);
+        sf::Uint32 height         = readUint32(data + 40);
+        sf::Uint32 depth          = readUint32(data + 44);
+        sf::Uint32 arrayElements  = readUint32(data + 48);
+        sf::Uint32 faces          = readUint32(data + 52);
+        sf::Uint32 mipMapCount    = readUint32(data + 56);
+        sf::Uint32 keyValueBytes  = readUint32(data + 60);
+
+        if ((width == 0) || (height == 0))
+        {
+            sf::err() << "Failed to load KTX image, the size is invalid (" << width << "x" << height << ")" << std::endl;
+            return false;
+        }
+
+        if ((depth > 0) || (arrayElements > 0) || (faces != 1))
+        {
+            sf::err() << "Failed to load KTX image, only 2D textures are supported (not cube maps, arrays or volumes)" << std::endl;
+            return false;
+        }
+
+        // Compressed formats have no pixel type
+        if ((glType != 0) || !getKtxFormat(internalFormat, image.format))
+        {
+            sf::err() << "Failed to load KTX image, unsupported pixel format (0x" << std::hex << internalFormat << std::dec << ")" << std::endl;
+            return false;
+        }
+
+        image.size = sf::Vector2u(width, height);
+        image.levels.clear();
+
+        if (keyValueBytes > size - headerSize)
+        {
+            sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+            return false;
+        }
+
+        std::size_t offset = headerSize + keyValueBytes;
+        sf::Uint32 levelCount = std::min(std::max(mipMapCount, 1u), getMaximumLevelCount(image.size));
+        sf::Vector2u levelSize = image.size;
+        for (sf::Uint32 i = 0; i < levelCount; ++i)
+        {
+            if ((offset > size) || (size - offset < 4))
+            {
+                sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+                return false;
+            }
+
+            std::size_t byteCount = readUint32(data + offset);
+            offset += 4;
+
+            if ((byteCount < getLevelSize(image.format, levelSize)) || (byteCount > size - offset))
+            {
+                sf::err() << "Failed to load KTX image, the file is truncated" << std::endl;
+                return false;
+            }
+
+            sf::priv::CompressedImage::Level level = {levelSize, data + offset, byteCount};
+            image.levels.push_back(level);
+
+            // Levels are aligned on 4 bytes
+            offset += (byteCount + 3) & ~static_cast<std::size_t>(3);
+            levelSize = getNextLevelSize(levelSize);
+        }
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    if ((size >= sizeof(ddsSignature)) && (std::memcmp(bytes, ddsSignature, sizeof(ddsSignature)) == 0))
+        return true;
+
+    if ((size >= sizeof(ktxSignature)) && (std::memcmp(bytes, ktxSignature, sizeof(ktxSignature)) == 0))
+        return true;
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool readCompressedImage(const std::string& filename, std::vector<Uint8>& contents)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+        return false;
+
+    // Check the signature before reading the whole file
+    char signature[signatureSize];
+    file.read(signature, signatureSize);
+    if (!isCompressedImage(signature, static_cast<std::size_t>(file.gcount())))
+        return false;
+
+    file.seekg(0, std::ios_base::end);
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+
+    contents.resize(static_cast<std::size_t>(size));
+    if ((size <= 0) || !file.read(reinterpret_cast<char*>(&contents[0]), size))
+    {
+        err() << "Failed to read compressed image \"" << filename << "\"" << std::endl;
+        contents.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool readCompressedImage(InputStream& stream, std::vector<Uint8>& contents)
+{
+    // Check the signature before reading the whole stream
+    Uint8 signature[signatureSize];
+    stream.seek(0);
+    Int64 read = stream.read(signature, signatureSize);
+    stream.seek(0);
+
+    if ((read <= 0) || !isCompressedImage(signature, static_cast<std::size_t>(read)))
+        return false;
+
+    Int64 size = stream.getSize();
+    if (size <= 0)
+        return false;
+
+    contents.resize(static_cast<std::size_t>(size));
+    if (stream.read(&contents[0], size) != size)
+    {
+        err() << "Failed to read compressed image from stream" << std::endl;
+        contents.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool parseCompressedImage(const void* data, std::size_t size, CompressedImage& image)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    if ((size >= sizeof(ddsSignature)) && (std::memcmp(bytes, ddsSignature, sizeof(ddsSignature)) == 0))
+        return parseDds(bytes, size, image);
+
+    if ((size >= sizeof(ktxSignature)) && (std::memcmp(bytes, ktxSignature, sizeof(ktxSignature)) == 0))
+        return parseKtx(bytes, size, image);
+
+    err() << "Failed to load compressed image, the data is neither a DDS nor a KTX file" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* getFormatName(CompressedImage::Format format)
+{
+    switch (format)
+    {
+        case CompressedImage::Bc1:      return "BC1 (DXT1)";
+        case CompressedImage::Bc2:      return "BC2 (DXT3)";
+        case CompressedImage::Bc3:      return "BC3 (DXT5)";
+        case CompressedImage::Bc4:      return "BC4 (RGTC1)";
+        case CompressedImage::Bc5:      return "BC5 (RGTC2)";
+        case CompressedImage::Bc7:      return "BC7 (BPTC)";
+        case CompressedImage::Etc2Rgb:  return "ETC2 RGB";
+        case CompressedImage::Etc2Rgba: return "ETC2 RGBA";
+        default:                        return "unknown";
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
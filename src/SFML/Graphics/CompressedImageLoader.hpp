@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDIMAGELOADER_HPP
+#define SFML_COMPRESSEDIMAGELOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Description of a pre-compressed image stored in a DDS or KTX container
+///
+/// The pixels are not copied: the levels refer to the
+/// memory that the image was parsed from.
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Block compression formats
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Bc1,     //!< BC1 / DXT1, RGB with optional 1-bit alpha, 8 bytes per block
+        Bc2,     //!< BC2 / DXT3, RGBA with explicit alpha, 16 bytes per block
+        Bc3,     //!< BC3 / DXT5, RGBA with interpolated alpha, 16 bytes per block
+        Bc4,     //!< BC4 / RGTC1, single channel, 8 bytes per block
+        Bc5,     //!< BC5 / RGTC2, two channels, 16 bytes per block
+        Bc7,     //!< BC7 / BPTC, RGBA, 16 bytes per block
+        Etc2Rgb, //!< ETC2 (and ETC1) RGB, 8 bytes per block
+        Etc2Rgba //!< ETC2 RGBA with EAC alpha, 16 bytes per block
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mipmap level of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Level
+    {
+        Vector2u    size;      //!< Size of the level, in pixels
+        const void* data;      //!< Compressed blocks of the level
+        std::size_t byteCount; //!< Size of the compressed blocks, in bytes
+    };
+
+    Format             format; //!< Compression format of the blocks
+    Vector2u           size;   //!< Size of the base level, in pixels
+    std::vector<Level> levels; //!< Mipmap levels, starting with the base level
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether some data starts with the signature of a DDS or KTX container
+///
+/// \param data Pointer to the beginning of the file
+/// \param size Number of bytes available at \a data
+///
+/// \return True if the data is a DDS or KTX container
+///
+////////////////////////////////////////////////////////////
+bool isCompressedImage(const void* data, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a whole file if it is a DDS or KTX container
+///
+/// \param filename Path of the file
+/// \param contents Array to fill with the contents of the file
+///
+/// \return True if the file is a DDS or KTX container and was read, false otherwise
+///
+////////////////////////////////////////////////////////////
+bool readCompressedImage(const std::string& filename, std::vector<Uint8>& contents);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a whole stream if it is a DDS or KTX container
+///
+/// The stream is left at its beginning if it is not a container.
+///
+/// \param stream   Source stream to read from
+/// \param contents Array to fill with the contents of the stream
+///
+/// \return True if the stream is a DDS or KTX container and was read, false otherwise
+///
+////////////////////////////////////////////////////////////
+bool readCompressedImage(InputStream& stream, std::vector<Uint8>& contents);
+
+////////////////////////////////////////////////////////////
+/// \brief Parse a DDS or KTX container
+///
+/// Only 2D textures are supported: cube maps, arrays and
+/// volume textures, as well as uncompressed pixel formats
+/// and empty images, are rejected with an error message.
+///
+/// \param data  Pointer to the contents of the file, must stay alive while \a image is used
+/// \param size  Size of the contents of the file, in bytes
+/// \param image Description of the image to fill
+///
+/// \return True if the container was parsed, false if it is invalid or uses an unsupported format
+///
+////////////////////////////////////////////////////////////
+bool parseCompressedImage(const void* data, std::size_t size, CompressedImage& image);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the readable name of a compression format
+///
+/// \param format Compression format
+///
+/// \return Name of the format, for error messages
+///
+////////////////////////////////////////////////////////////
+const char* getFormatName(CompressedImage::Format format);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGELOADER_HPP
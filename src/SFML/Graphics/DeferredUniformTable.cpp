@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DeferredUniformTable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void DeferredUniformTable::store(int location, std::size_t components, std::size_t count, const float* values)
+{
+    Uniform& uniform   = m_uniforms[location];
+    uniform.pending    = true;
+    uniform.components = components;
+    uniform.count      = count;
+    uniform.floats.assign(values, values + components * count);
+    uniform.ints.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void DeferredUniformTable::store(int location, std::size_t components, std::size_t count, const int* values)
+{
+    Uniform& uniform   = m_uniforms[location];
+    uniform.pending    = true;
+    uniform.components = components;
+    uniform.count      = count;
+    uniform.ints.assign(values, values + components * count);
+    uniform.floats.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void DeferredUniformTable::discard(int location)
+{
+    UniformMap::iterator it = m_uniforms.find(location);
+    if (it != m_uniforms.end())
+        it->second.pending = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool DeferredUniformTable::hasPending() const
+{
+    for (UniformMap::const_iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+    {
+        if (it->second.pending)
+            return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DeferredUniformTable::clear()
+{
+    m_uniforms.clear();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DEFERREDUNIFORMTABLE_HPP
+#define SFML_DEFERREDUNIFORMTABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <map>
+#include <vector>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Uniform values of a shader waiting to be uploaded
+///
+/// The values are stored per location, and marked pending
+/// until they are uploaded. The entries are kept once
+/// uploaded, so that setting them again doesn't allocate.
+///
+////////////////////////////////////////////////////////////
+class DeferredUniformTable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Value of a uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Uniform
+    {
+        bool               pending;    //!< Does the value need to be uploaded?
+        std::size_t        components; //!< Number of values per element (9 or 16 for matrices)
+        std::size_t        count;      //!< Number of elements, for arrays
+        std::vector<float> floats;     //!< Values of a float uniform
+        std::vector<int>   ints;       //!< Values of an integer uniform
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the values of a float uniform
+    ///
+    /// \param location   Location of the uniform
+    /// \param components Number of values per element
+    /// \param count      Number of elements
+    /// \param values     Pointer to the values
+    ///
+    ////////////////////////////////////////////////////////////
+    void store(int location, std::size_t components, std::size_t count, const float* values);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the values of an integer uniform
+    ///
+    /// \param location   Location of the uniform
+    /// \param components Number of values per element
+    /// \param count      Number of elements
+    /// \param values     Pointer to the values
+    ///
+    ////////////////////////////////////////////////////////////
+    void store(int location, std::size_t components, std::size_t count, const int* values);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the pending value of a uniform
+    ///
+    /// This must be called when the uniform is written directly
+    /// to the program, so that the stored value doesn't
+    /// overwrite it on the next upload.
+    ///
+    /// \param location Location of the uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    void discard(int location);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether some values wait to be uploaded
+    ///
+    /// \return True if at least one uniform is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the pending values
+    ///
+    /// \a uploader is called as uploader(location, components, count, values)
+    /// for each pending uniform, with a pointer to floats or to ints.
+    /// The uniforms are no longer pending afterwards.
+    ///
+    /// \param uploader Function object writing the values to the program
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename Uploader>
+    void upload(Uploader& uploader)
+    {
+        for (UniformMap::iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+        {
+            Uniform& uniform = it->second;
+            if (!uniform.pending)
+                continue;
+
+            if (!uniform.floats.empty())
+                uploader(it->first, uniform.components, uniform.count, &uniform.floats[0]);
+            else if (!uniform.ints.empty())
+                uploader(it->first, uniform.components, uniform.count, &uniform.ints[0]);
+
+            uniform.pending = false;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the uniforms
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<int, Uniform> UniformMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UniformMap m_uniforms; //!< Values of the uniforms, mapped to their location
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DEFERREDUNIFORMTABLE_HPP
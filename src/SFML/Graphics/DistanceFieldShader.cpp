@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DistanceFieldShader.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    const char vertexSource[] =
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    // fwidth gives the variation of the distance across a screen pixel,
+    // which is the width of the antialiased transition
+    const char fragmentSource[] =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_threshold;\n"
+        "void main()\n"
+        "{\n"
+        "    float value = texture2D(sf_texture, gl_TexCoord[0].xy).a;\n"
+        "    float width = max(fwidth(value) * 0.5, 0.001);\n"
+        "    float alpha = smoothstep(sf_threshold - width, sf_threshold + width, value);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+DistanceFieldShader::DistanceFieldShader() :
+m_shader(),
+m_loaded(false),
+m_failed(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* DistanceFieldShader::getShader(float threshold)
+{
+    if (!m_loaded)
+    {
+        // Don't retry on every draw if the compilation failed once
+        if (m_failed || !Shader::isAvailable())
+            return NULL;
+
+        if (!m_shader.loadFromMemory(vertexSource, fragmentSource))
+        {
+            err() << "Failed to compile the distance field shader, distance field texts will look blurry" << std::endl;
+            m_failed = true;
+            return NULL;
+        }
+
+        m_shader.setUniform("sf_texture", Shader::CurrentTexture);
+        m_loaded = true;
+    }
+
+    m_shader.setUniform("sf_threshold", threshold);
+
+    return &m_shader;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DISTANCEFIELDSHADER_HPP
+#define SFML_DISTANCEFIELDSHADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Built-in shader drawing signed distance field glyphs
+///
+/// The alpha channel of the texture holds the distance to the
+/// glyph edge, 0.5 being on the edge. The shader keeps the
+/// pixels above a threshold, with an antialiased transition
+/// as wide as a screen pixel, so that glyphs stay crisp at
+/// any scale. Lowering the threshold thickens the glyphs,
+/// which draws outlines.
+///
+////////////////////////////////////////////////////////////
+class DistanceFieldShader
+{
+    SFML_DISALLOW_COPY_MOVE(DistanceFieldShader);
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The shader is compiled on first use.
+    ///
+    ////////////////////////////////////////////////////////////
+    DistanceFieldShader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader, ready to draw with the given threshold
+    ///
+    /// \param threshold Distance value of the edge of the drawn shape, in [0, 1]
+    ///
+    /// \return Pointer to the shader, or NULL if shaders are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getShader(float threshold);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader m_shader; //!< Built-in shader program
+    bool   m_loaded; //!< Was the shader compiled successfully?
+    bool   m_failed; //!< Did the compilation fail?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DISTANCEFIELDSHADER_HPP
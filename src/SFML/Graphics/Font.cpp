@@ -26,21 +26,31 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/DistanceFieldShader.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GlyphTable.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <atomic>
+#include <deque>
+#include <limits>
 
 
 namespace
@@ -77,20 +87,443 @@ namespace
     {
         return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
     }
+
+    // Small padding left around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int glyphPadding = 2;
+
+    // Size of the page textures when they are created
+    const unsigned int initialPageSize = 128;
+
+    // Make sure that the given size is the current one of a face
+    bool setFaceSize(FT_Face face, unsigned int characterSize)
+    {
+        // FT_Set_Pixel_Sizes is an expensive function, so we must call it
+        // only when necessary to avoid killing performances
+
+        FT_UShort currentSize = face->size->metrics.x_ppem;
+
+        if (currentSize != characterSize)
+        {
+            FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+            if (result == FT_Err_Invalid_Pixel_Size)
+            {
+                // In the case of bitmap fonts, resizing can
+                // fail if the requested size is not available
+                if (!FT_IS_SCALABLE(face))
+                {
+                    sf::err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+                    sf::err() << "Available sizes are: ";
+                    for (int i = 0; i < face->num_fixed_sizes; ++i)
+                    {
+                        const unsigned int size = (face->available_sizes[i].y_ppem + 32) >> 6;
+                        sf::err() << size << " ";
+                    }
+                    sf::err() << std::endl;
+                }
+                else
+                {
+                    sf::err() << "Failed to set font size to " << characterSize << std::endl;
+                }
+            }
+
+            return result == FT_Err_Ok;
+        }
+
+        return true;
+    }
+
+    // Rasterize a glyph of a face, whose size must already be set. On success, the glyph metrics
+    // are filled, its texture rectangle has the size of the glyph bitmap (at position 0, 0), and
+    // pixels receives the bitmap as white pixels with glyphPadding transparent pixels around
+    bool rasterizeGlyph(FT_Library library, FT_Face face, FT_Stroker stroker, sf::Uint32 codePoint, bool bold, float outlineThickness,
+                        sf::Glyph& glyph, std::vector<sf::Uint8>& pixelBuffer)
+    {
+        // Load the glyph corresponding to the code point
+        FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
+        if (outlineThickness != 0)
+            flags |= FT_LOAD_NO_BITMAP;
+        if (FT_Load_Char(face, codePoint, flags) != 0)
+            return false;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return false;
+
+        // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (outline)
+        {
+            if (bold)
+            {
+                FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+                FT_Outline_Embolden(&outlineGlyph->outline, weight);
+            }
+
+            if (outlineThickness != 0)
+            {
+                FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+                FT_Glyph_Stroke(&glyphDesc, stroker, true);
+            }
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (!outline)
+        {
+            if (bold)
+                FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+
+            if (outlineThickness != 0)
+                sf::err() << "Failed to outline glyph (no fallback available)" << std::endl;
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        glyph.lsbDelta = face->glyph->lsb_delta;
+        glyph.rsbDelta = face->glyph->rsb_delta;
+
+        unsigned int width  = bitmap.width;
+        unsigned int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            const unsigned int padding = glyphPadding;
+
+            glyph.textureRect = sf::IntRect(0, 0, width, height);
+
+            // Compute the glyph's bounding box
+            glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+            glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+
+            width += 2 * padding;
+            height += 2 * padding;
+
+            // Resize the pixel buffer to the new size and fill it with transparent white pixels
+            pixelBuffer.resize(width * height * 4);
+
+            sf::Uint8* current = &pixelBuffer[0];
+            sf::Uint8* end = current + width * height * 4;
+
+            while (current != end)
+            {
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 255;
+                (*current++) = 0;
+            }
+
+            // Extract the glyph's pixels from the bitmap
+            const sf::Uint8* pixels = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (unsigned int y = padding; y < height - padding; ++y)
+                {
+                    for (unsigned int x = padding; x < width - padding; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = x + y * width;
+                        pixelBuffer[index * 4 + 3] = pixels[x - padding];
+                    }
+                    pixels += bitmap.pitch;
+                }
+            }
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+
+        return true;
+    }
+
+    // Key of the page holding the distance field glyphs (no character size is 0)
+    const unsigned int distanceFieldPageKey = 0;
+
+    // Distance field glyphs are rasterized at this multiple of their size,
+    // so that the distances can be measured with subpixel precision
+    const unsigned int distanceFieldOversampling = 4;
+
+    // Squared distance standing for "no feature in sight"
+    const float distanceInfinity = 1e20f;
+
+    // Felzenszwalb and Huttenlocher's 1D squared euclidean distance transform.
+    // Replaces each of the count values of line, spaced by stride, by the minimum
+    // over q of (line[q] + (p - q)^2), in linear time
+    void transformLine(float* line, std::size_t count, std::size_t stride, std::vector<float>& f, std::vector<float>& z, std::vector<int>& v)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            f[i] = line[i * stride];
+
+        // Compute the lower envelope of the parabolas rooted at each sample
+        int k = 0;
+        v[0] = 0;
+        z[0] = -distanceInfinity;
+        z[1] = distanceInfinity;
+
+        for (int q = 1; q < static_cast<int>(count); ++q)
+        {
+            float s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+            while (s <= z[k])
+            {
+                --k;
+                s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+            }
+
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = distanceInfinity;
+        }
+
+        // Evaluate the envelope
+        k = 0;
+        for (int q = 0; q < static_cast<int>(count); ++q)
+        {
+            while (z[k + 1] < static_cast<float>(q))
+                ++k;
+
+            line[q * stride] = static_cast<float>((q - v[k]) * (q - v[k])) + f[v[k]];
+        }
+    }
+
+    // Compute the squared distance of each cell of a grid to the nearest cell set to 0,
+    // the other cells being set to distanceInfinity
+    void transformGrid(std::vector<float>& grid, std::size_t width, std::size_t height)
+    {
+        std::size_t size = std::max(width, height);
+        std::vector<float> f(size);
+        std::vector<float> z(size + 1);
+        std::vector<int>   v(size);
+
+        // The 2D transform is separable: transform the columns, then the rows
+        for (std::size_t x = 0; x < width; ++x)
+            transformLine(&grid[x], height, width, f, z, v);
+
+        for (std::size_t y = 0; y < height; ++y)
+            transformLine(&grid[y * width], width, 1, f, z, v);
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+const unsigned int Font::DistanceFieldSize   = 48;
+const unsigned int Font::DistanceFieldSpread = 6;
+
+
+////////////////////////////////////////////////////////////
+struct Font::Preloader
+{
+    ////////////////////////////////////////////////////////////
+    // Range of glyphs to rasterize
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        Uint32       first;
+        Uint32       last;
+        unsigned int characterSize;
+        bool         bold;
+        float        outlineThickness;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Glyph rasterized by the thread, waiting to be written to its page
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        unsigned int       characterSize;
+        Uint64             key;
+        Glyph              glyph;
+        std::vector<Uint8> pixels;
+    };
+
+    ////////////////////////////////////////////////////////////
+    Preloader() :
+    library(NULL),
+    face   (NULL),
+    stroker(NULL),
+    thread (&Preloader::run, this),
+    pending(false),
+    running(false),
+    stopped(false)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~Preloader()
+    {
+        {
+            Lock lock(mutex);
+            stopped = true;
+        }
+
+        thread.wait();
+
+        if (stroker)
+            FT_Stroker_Done(stroker);
+        if (face)
+            FT_Done_Face(face);
+        if (library)
+            FT_Done_FreeType(library);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename, const void* data, std::size_t size)
+    {
+        // FreeType objects can't be shared between threads, the thread needs its own library and face
+        if (FT_Init_FreeType(&library) != 0)
+        {
+            library = NULL;
+            err() << "Failed to preload glyphs (failed to initialize FreeType)" << std::endl;
+            return false;
+        }
+
+        FT_Error error;
+        if (!filename.empty())
+            error = FT_New_Face(library, filename.c_str(), 0, &face);
+        else
+            error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(size), 0, &face);
+
+        if (error != 0)
+        {
+            face = NULL;
+            err() << "Failed to preload glyphs (failed to create the font face)" << std::endl;
+            return false;
+        }
+
+        if (FT_Stroker_New(library, &stroker) != 0)
+        {
+            stroker = NULL;
+            err() << "Failed to preload glyphs (failed to create the stroker)" << std::endl;
+            return false;
+        }
+
+        if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+        {
+            err() << "Failed to preload glyphs (failed to set the Unicode character set)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                Lock lock(mutex);
+
+                if (stopped || jobs.empty())
+                {
+                    running = false;
+                    pending = true;
+                    return;
+                }
+
+                job = jobs.front();
+                jobs.pop_front();
+            }
+
+            if (!setFaceSize(face, job.characterSize))
+                continue;
+
+            for (Uint32 codePoint = job.first; ; ++codePoint)
+            {
+                // Characters missing from the font all share glyph 0, which is loaded on demand
+                FT_UInt index = FT_Get_Char_Index(face, codePoint);
+
+                Result result;
+                bool rasterized = (index != 0) && rasterizeGlyph(library, face, stroker, codePoint, job.bold, job.outlineThickness, result.glyph, result.pixels);
+
+                {
+                    Lock lock(mutex);
+
+                    if (stopped)
+                    {
+                        running = false;
+                        pending = true;
+                        return;
+                    }
+
+                    if (rasterized)
+                    {
+                        result.characterSize = job.characterSize;
+                        result.key = combine(job.outlineThickness, job.bold, index);
+                        results.push_back(result);
+                        pending = true;
+                    }
+                }
+
+                if (codePoint == job.last)
+                    break;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FT_Library          library; //!< FreeType library of the thread
+    FT_Face             face;    //!< Font face of the thread
+    FT_Stroker          stroker; //!< Stroker of the thread
+    Thread              thread;  //!< Thread rasterizing the glyphs
+    std::atomic<bool>   pending; //!< Are there results to take, or did the thread stop? (read without locking)
+    Mutex               mutex;   //!< Mutex protecting the members below
+    std::deque<Job>     jobs;    //!< Ranges of glyphs waiting to be rasterized
+    std::vector<Result> results; //!< Rasterized glyphs waiting to be written to their page
+    bool                running; //!< Is the thread running, or about to?
+    bool                stopped; //!< Was the thread asked to stop?
+};
+
+
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_stroker  (NULL),
-m_refCount (NULL),
-m_isSmooth (true),
-m_info     ()
+m_library            (NULL),
+m_face               (NULL),
+m_streamRec          (NULL),
+m_stroker            (NULL),
+m_refCount           (NULL),
+m_isSmooth           (true),
+m_isDistanceField    (false),
+m_pageBudget         (0),
+m_info               (),
+m_sourceFile         (),
+m_sourceData         (NULL),
+m_sourceSize         (0),
+m_lastPage           (NULL),
+m_lastPageSize       (0),
+m_distanceFieldShader(NULL),
+m_preloader          (NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -100,15 +533,25 @@ m_info     ()
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_stroker    (copy.m_stroker),
-m_refCount   (copy.m_refCount),
-m_isSmooth   (copy.m_isSmooth),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_library            (copy.m_library),
+m_face               (copy.m_face),
+m_streamRec          (copy.m_streamRec),
+m_stroker            (copy.m_stroker),
+m_refCount           (copy.m_refCount),
+m_isSmooth           (copy.m_isSmooth),
+m_isDistanceField    (copy.m_isDistanceField),
+m_pageBudget         (copy.m_pageBudget),
+m_info               (copy.m_info),
+m_sourceFile         (copy.m_sourceFile),
+m_sourceData         (copy.m_sourceData),
+m_sourceSize         (copy.m_sourceSize),
+m_pages              (copy.m_pages),
+m_lastPage           (NULL),
+m_lastPageSize       (0),
+m_charIndices        (copy.m_charIndices),
+m_pixelBuffer        (copy.m_pixelBuffer),
+m_distanceFieldShader(NULL),
+m_preloader          (NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -127,6 +570,8 @@ Font::~Font()
 {
     cleanup();
 
+    delete m_distanceFieldShader;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -189,6 +634,9 @@ bool Font::loadFromFile(const std::string& filename)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember where the font comes from, so that it can be opened again for preloading
+    m_sourceFile = filename;
+
     return true;
 
     #else
@@ -254,6 +702,10 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
+    // Remember where the font comes from, so that it can be opened again for preloading
+    m_sourceData = data;
+    m_sourceSize = sizeInBytes;
+
     return true;
 }
 
@@ -346,32 +798,35 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
+    // Collect the glyphs rasterized in the background first, they may include this one
+    if (m_preloader)
+        uploadPreloadedGlyphs();
+
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    Page& page = getPage(characterSize);
 
     // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
+    Uint64 key = combine(outlineThickness, bold, getCharIndex(codePoint));
 
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    priv::GlyphTable::Entry* entry = page.glyphs->find(key);
+    if (!entry)
     {
-        // Found: just return it
-        return it->second;
-    }
-    else
-    {
-        // Not found: we have to load it
+        // Not found: we have to load it (this may evict other glyphs of the page)
         Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        entry = &page.glyphs->insert(key, glyph);
     }
+
+    // Mark it as recently used and return it
+    entry->lastUse = ++page.useCounter;
+    return entry->glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::hasGlyph(Uint32 codePoint) const
 {
-    return FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint) != 0;
+    return getCharIndex(codePoint) != 0;
 }
 
 
@@ -387,12 +842,18 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
     if (face && setCurrentSize(characterSize))
     {
         // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        FT_UInt index1 = getCharIndex(first);
+        FT_UInt index2 = getCharIndex(second);
 
         // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag
-        float firstRsbDelta = getGlyph(first, characterSize, bold).rsbDelta;
-        float secondLsbDelta = getGlyph(second, characterSize, bold).lsbDelta;
+        // (distance field glyphs are not hinted, they don't need any)
+        float firstRsbDelta = 0.f;
+        float secondLsbDelta = 0.f;
+        if (!m_isDistanceField)
+        {
+            firstRsbDelta = getGlyph(first, characterSize, bold).rsbDelta;
+            secondLsbDelta = getGlyph(second, characterSize, bold).lsbDelta;
+        }
 
         // Get the kerning vector if present
         FT_Vector kerning;
@@ -475,9 +936,76 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    if (m_preloader)
+        uploadPreloadedGlyphs();
+
+    return getPage(characterSize).texture;
 }
 
+////////////////////////////////////////////////////////////
+bool Font::preload(Uint32 first, Uint32 last, unsigned int characterSize, bool bold, float outlineThickness)
+{
+    if (!m_face)
+    {
+        err() << "Failed to preload glyphs, no font is loaded" << std::endl;
+        return false;
+    }
+
+    if (m_sourceFile.empty() && !m_sourceData)
+    {
+        err() << "Failed to preload glyphs, fonts loaded from a stream can't be preloaded" << std::endl;
+        return false;
+    }
+
+    if (first > last)
+    {
+        err() << "Failed to preload glyphs, the range is empty" << std::endl;
+        return false;
+    }
+
+    // Start the worker with its own instance of the font
+    if (!m_preloader)
+    {
+        Preloader* preloader = new Preloader;
+        if (!preloader->open(m_sourceFile, m_sourceData, m_sourceSize))
+        {
+            delete preloader;
+            return false;
+        }
+
+        m_preloader = preloader;
+    }
+
+    Preloader::Job job = {first, last, characterSize, bold, outlineThickness};
+
+    bool launch;
+    {
+        Lock lock(m_preloader->mutex);
+
+        m_preloader->jobs.push_back(job);
+
+        // Restart the thread if it was done with the previous jobs
+        launch = !m_preloader->running;
+        m_preloader->running = true;
+    }
+
+    if (launch)
+        m_preloader->thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isPreloading() const
+{
+    if (m_preloader)
+        uploadPreloadedGlyphs();
+
+    return m_preloader != NULL;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Font::setSmooth(bool smooth)
 {
@@ -485,9 +1013,11 @@ void Font::setSmooth(bool smooth)
     {
         m_isSmooth = smooth;
 
+        // The distance field page is always smooth, its texels are interpolated distances
         for (sf::Font::PageTable::iterator page = m_pages.begin(); page != m_pages.end(); ++page)
         {
-            page->second.texture.setSmooth(m_isSmooth);
+            if (page->first != distanceFieldPageKey)
+                page->second.texture.setSmooth(m_isSmooth);
         }
     }
 }
@@ -499,25 +1029,92 @@ bool Font::isSmooth() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::setDistanceField(bool distanceField)
+{
+    m_isDistanceField = distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceField() const
+{
+    return m_isDistanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::getDistanceFieldGlyph(Uint32 codePoint, bool bold) const
+{
+    Page& page = getPage(distanceFieldPageKey);
+
+    // Distance field glyphs are never outlined, the shader takes care of it
+    Uint64 key = combine(0.f, bold, getCharIndex(codePoint));
+
+    priv::GlyphTable::Entry* entry = page.glyphs->find(key);
+    if (!entry)
+    {
+        Glyph glyph = loadDistanceFieldGlyph(codePoint, bold);
+        entry = &page.glyphs->insert(key, glyph);
+    }
+
+    entry->lastUse = ++page.useCounter;
+    return entry->glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& Font::getDistanceFieldTexture() const
+{
+    return getPage(distanceFieldPageKey).texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setPageMemoryBudget(std::size_t bytes)
+{
+    m_pageBudget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getPageMemoryBudget() const
+{
+    return m_pageBudget;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_isSmooth,    temp.m_isSmooth);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_library,             temp.m_library);
+    std::swap(m_face,                temp.m_face);
+    std::swap(m_streamRec,           temp.m_streamRec);
+    std::swap(m_stroker,             temp.m_stroker);
+    std::swap(m_refCount,            temp.m_refCount);
+    std::swap(m_isSmooth,            temp.m_isSmooth);
+    std::swap(m_isDistanceField,     temp.m_isDistanceField);
+    std::swap(m_pageBudget,          temp.m_pageBudget);
+    std::swap(m_info,                temp.m_info);
+    std::swap(m_sourceFile,          temp.m_sourceFile);
+    std::swap(m_sourceData,          temp.m_sourceData);
+    std::swap(m_sourceSize,          temp.m_sourceSize);
+    std::swap(m_pages,               temp.m_pages);
+    std::swap(m_charIndices,         temp.m_charIndices);
+    std::swap(m_distanceFieldShader, temp.m_distanceFieldShader);
+    std::swap(m_pixelBuffer,         temp.m_pixelBuffer);
+    std::swap(m_preloader,           temp.m_preloader);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
     #endif
 
+    // The cached page pointers follow the pages, drop them
+    m_lastPage = NULL;
+    temp.m_lastPage = NULL;
+
     return *this;
 }
 
@@ -525,6 +1122,10 @@ Font& Font::operator =(const Font& right)
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop preloading glyphs of the previous font
+    delete m_preloader;
+    m_preloader = NULL;
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -562,10 +1163,52 @@ void Font::cleanup()
     m_streamRec = NULL;
     m_refCount  = NULL;
     m_pages.clear();
+    m_lastPage  = NULL;
+    m_charIndices.clear();
+    m_sourceFile.clear();
+    m_sourceData = NULL;
+    m_sourceSize = 0;
     std::vector<Uint8>().swap(m_pixelBuffer);
 }
 
 
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    // Texts usually request many glyphs of the same size in a row
+    if (!m_lastPage || (m_lastPageSize != characterSize))
+    {
+        m_lastPage     = &m_pages[characterSize];
+        m_lastPageSize = characterSize;
+    }
+
+    return *m_lastPage;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Font::getCharIndex(Uint32 codePoint) const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    // Looking up the character map is the most expensive part of getGlyph,
+    // so the indices of the common Latin-1 characters are cached
+    if ((codePoint < 256) && face)
+    {
+        if (m_charIndices.empty())
+        {
+            m_charIndices.resize(256);
+            for (Uint32 i = 0; i < 256; ++i)
+                m_charIndices[i] = FT_Get_Char_Index(face, i);
+        }
+
+        return m_charIndices[codePoint];
+    }
+
+    return FT_Get_Char_Index(face, codePoint);
+}
+
+
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
@@ -581,96 +1224,164 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
     if (!setCurrentSize(characterSize))
         return glyph;
 
-    // Load the glyph corresponding to the code point
-    FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
-    if (outlineThickness != 0)
-        flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
+    // Rasterize the glyph and write it to the page of the character size
+    if (rasterizeGlyph(static_cast<FT_Library>(m_library), face, static_cast<FT_Stroker>(m_stroker), codePoint, bold, outlineThickness, glyph, m_pixelBuffer))
+        writeGlyph(getPage(characterSize), glyph, m_pixelBuffer);
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::writeGlyph(Page& page, Glyph& glyph, const std::vector<Uint8>& pixels) const
+{
+    // Glyphs without pixels (such as spaces) don't take any room in the texture
+    if ((glyph.textureRect.width <= 0) || (glyph.textureRect.height <= 0))
+        return;
+
+    const unsigned int padding = glyphPadding;
+
+    // Find a good position for the new glyph into the texture
+    IntRect rect = findGlyphRect(page, glyph.textureRect.width + 2 * padding, glyph.textureRect.height + 2 * padding);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    glyph.textureRect.left   = rect.left + padding;
+    glyph.textureRect.top    = rect.top + padding;
+    glyph.textureRect.width  = rect.width - 2 * padding;
+    glyph.textureRect.height = rect.height - 2 * padding;
+
+    // Write the pixels to the texture
+    page.texture.update(&pixels[0], rect.width, rect.height, rect.left, rect.top);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::uploadPreloadedGlyphs() const
+{
+    // This is called for every requested glyph, don't wait for the thread if it has nothing new
+    if (!m_preloader->pending)
+        return;
+
+    std::vector<Preloader::Result> results;
+    bool finished;
+    {
+        Lock lock(m_preloader->mutex);
+
+        m_preloader->pending = false;
+        results.swap(m_preloader->results);
+        finished = !m_preloader->running;
+    }
+
+    for (std::vector<Preloader::Result>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        // The glyph may have been loaded in the meantime
+        Page& page = getPage(it->characterSize);
+        if (page.glyphs->find(it->key))
+            continue;
+
+        writeGlyph(page, it->glyph, it->pixels);
+        page.glyphs->insert(it->key, it->glyph).lastUse = ++page.useCounter;
+    }
+
+    // No more glyphs will come once the thread has stopped
+    if (finished)
+    {
+        delete m_preloader;
+        m_preloader = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadDistanceFieldGlyph(Uint32 codePoint, bool bold) const
+{
+    // The glyph to return
+    Glyph glyph;
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+    if (!face)
+        return glyph;
+
+    // Rasterize the glyph at a higher resolution, without hinting since it will be scaled
+    const unsigned int oversampling = distanceFieldOversampling;
+    if (!setCurrentSize(DistanceFieldSize * oversampling))
+        return glyph;
+
+    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING) != 0)
         return glyph;
 
-    // Retrieve the glyph
     FT_Glyph glyphDesc;
     if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
         return glyph;
 
-    // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
+    // Apply bold, with the same weight as regular glyphs at DistanceFieldSize
+    FT_Pos weight = static_cast<FT_Pos>(oversampling) << 6;
     bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (outline)
+    if (outline && bold)
     {
-        if (bold)
-        {
-            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-            FT_Outline_Embolden(&outlineGlyph->outline, weight);
-        }
-
-        if (outlineThickness != 0)
-        {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
-
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, true);
-        }
+        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+        FT_Outline_Embolden(&outlineGlyph->outline, weight);
     }
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
     FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
-
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (!outline)
-    {
-        if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+    FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+    FT_Bitmap& bitmap = bitmapGlyph->bitmap;
 
-        if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
-    }
+    if (!outline && bold)
+        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
 
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6) / static_cast<float>(oversampling);
     if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
-
-    glyph.lsbDelta = face->glyph->lsb_delta;
-    glyph.rsbDelta = face->glyph->rsb_delta;
+        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6) / static_cast<float>(oversampling);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
-
-    if ((width > 0) && (height > 0))
+    if ((bitmap.width > 0) && (bitmap.rows > 0))
     {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 2;
+        const unsigned int spread  = DistanceFieldSpread;
+        const unsigned int padding = glyphPadding;
 
-        width += 2 * padding;
-        height += 2 * padding;
+        // Size of the glyph in the distance field, with the spread on each side
+        unsigned int width  = (bitmap.width + oversampling - 1) / oversampling + 2 * spread;
+        unsigned int height = (bitmap.rows  + oversampling - 1) / oversampling + 2 * spread;
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        // Build the high resolution grids: "outside" measures the distance to the
+        // nearest pixel inside the glyph, "inside" the distance to the nearest one outside
+        std::size_t gridWidth  = width * oversampling;
+        std::size_t gridHeight = height * oversampling;
+        std::vector<float> outside(gridWidth * gridHeight, distanceInfinity);
+        std::vector<float> inside(gridWidth * gridHeight, 0.f);
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
+        const Uint8* pixels = bitmap.buffer;
+        for (unsigned int y = 0; y < bitmap.rows; ++y)
+        {
+            for (unsigned int x = 0; x < bitmap.width; ++x)
+            {
+                bool covered;
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                    covered = (pixels[x / 8] & (1 << (7 - (x % 8)))) != 0;
+                else
+                    covered = pixels[x] >= 128;
 
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+                if (covered)
+                {
+                    std::size_t index = (x + spread * oversampling) + (y + spread * oversampling) * gridWidth;
+                    outside[index] = 0.f;
+                    inside[index] = distanceInfinity;
+                }
+            }
+            pixels += bitmap.pitch;
+        }
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+        transformGrid(outside, gridWidth, gridHeight);
+        transformGrid(inside, gridWidth, gridHeight);
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+        // Fill the pixel buffer with transparent white pixels, the alpha channel will hold the distance
+        std::size_t bufferWidth  = width + 2 * padding;
+        std::size_t bufferHeight = height + 2 * padding;
+        m_pixelBuffer.resize(bufferWidth * bufferHeight * 4);
 
         Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
+        Uint8* end = current + bufferWidth * bufferHeight * 4;
 
         while (current != end)
         {
@@ -680,179 +1391,240 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
             (*current++) = 0;
         }
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        // Sample the signed distance at the center of each pixel of the field,
+        // and map [-spread, spread] (inside to outside) to [1, 0]
+        for (unsigned int y = 0; y < height; ++y)
         {
-            // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
+            for (unsigned int x = 0; x < width; ++x)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
-        {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
-            {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
+                std::size_t sample = (x * oversampling + oversampling / 2) + (y * oversampling + oversampling / 2) * gridWidth;
+
+                // Distances are measured between pixel centers, the edge lies half a pixel away
+                float distance = (outside[sample] > 0.f) ? std::sqrt(outside[sample]) - 0.5f : 0.5f - std::sqrt(inside[sample]);
+                float value = 0.5f - distance / static_cast<float>(oversampling) / static_cast<float>(2 * spread);
+                value = std::max(0.f, std::min(1.f, value));
+
+                std::size_t index = (x + padding) + (y + padding) * bufferWidth;
+                m_pixelBuffer[index * 4 + 3] = static_cast<Uint8>(value * 255.f + 0.5f);
             }
         }
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
+        // Find a place for the glyph in the distance field page
+        Page& page = getPage(distanceFieldPageKey);
+        IntRect rect = findGlyphRect(page, static_cast<unsigned int>(bufferWidth), static_cast<unsigned int>(bufferHeight));
+
+        glyph.textureRect = IntRect(rect.left + padding, rect.top + padding, width, height);
+
+        // The bounds cover the whole field, spread included
+        glyph.bounds.left   =  static_cast<float>(bitmapGlyph->left) / static_cast<float>(oversampling) - static_cast<float>(spread);
+        glyph.bounds.top    = -static_cast<float>(bitmapGlyph->top)  / static_cast<float>(oversampling) - static_cast<float>(spread);
+        glyph.bounds.width  =  static_cast<float>(width);
+        glyph.bounds.height =  static_cast<float>(height);
+
+        page.texture.update(&m_pixelBuffer[0], rect.width, rect.height, rect.left, rect.top);
     }
 
     // Delete the FT glyph
     FT_Done_Glyph(glyphDesc);
 
-    // Done :)
     return glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+priv::DistanceFieldShader& Font::getDistanceFieldShader() const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
-    {
-        float ratio = static_cast<float>(height) / it->height;
+    if (!m_distanceFieldShader)
+        m_distanceFieldShader = new priv::DistanceFieldShader;
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
-
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+    return *m_distanceFieldShader;
+}
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+{
+    const unsigned int maximumSize = getMaximumPageSize();
+    if ((width > maximumSize) || (height > maximumSize))
+    {
+        err() << "Failed to add a new character to the font: the glyph is larger than the maximum page size" << std::endl;
+        return IntRect(0, 0, 2, 2);
     }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    Vector2u position;
+    for (;;)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        // First try the areas released by evicted glyphs, picking the smallest one that fits
+        std::vector<IntRect>::iterator best = page.freeRects.end();
+        for (std::vector<IntRect>::iterator it = page.freeRects.begin(); it != page.freeRects.end(); ++it)
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
+            if ((static_cast<unsigned int>(it->width) >= width) && (static_cast<unsigned int>(it->height) >= height))
             {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.setSmooth(m_isSmooth);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
+                if ((best == page.freeRects.end()) || (it->width * it->height < best->width * best->height))
+                    best = it;
             }
-            else
+        }
+
+        if (best != page.freeRects.end())
+        {
+            IntRect area = *best;
+            page.freeRects.erase(best);
+
+            // Give back what remains on the right and below the glyph
+            if (static_cast<unsigned int>(area.width) > width)
+                page.freeRects.push_back(IntRect(area.left + width, area.top, area.width - width, height));
+            if (static_cast<unsigned int>(area.height) > height)
+                page.freeRects.push_back(IntRect(area.left, area.top + height, area.width, area.height - height));
+
+            return IntRect(area.left, area.top, width, height);
+        }
+
+        // Then the free space above the skyline
+        if (page.packer->insert(Vector2u(width, height), position))
+            return IntRect(position.x, position.y, width, height);
+
+        // Not enough space: resize the texture if the budget allows it,
+        // or beyond the budget if none of the glyphs can be evicted
+        priv::GlyphTable::Entry* coldest = page.glyphs->findLeastRecentlyUsed();
+        bool isPinned = coldest && (coldest->lastUse > page.pinnedFrom);
+        unsigned int growthLimit = isPinned ? Texture::getMaximumSize() : maximumSize;
+
+        unsigned int textureWidth  = page.texture.getSize().x;
+        unsigned int textureHeight = page.texture.getSize().y;
+        if ((textureWidth * 2 <= growthLimit) && (textureHeight * 2 <= growthLimit))
+        {
+            // Make the texture 2 times bigger
+            Texture newTexture;
+            newTexture.create(textureWidth * 2, textureHeight * 2);
+            // The distance field page is always smooth, like in setSmooth
+            PageTable::const_iterator distanceFieldPage = m_pages.find(distanceFieldPageKey);
+            bool isDistanceFieldPage = (distanceFieldPage != m_pages.end()) && (&distanceFieldPage->second == &page);
+            newTexture.setSmooth(isDistanceFieldPage || m_isSmooth);
+            newTexture.update(page.texture);
+            page.texture.swap(newTexture);
+
+            page.packer->grow(page.texture.getSize());
+            continue;
+        }
+
+        // The page is full: evict the least recently used glyph, pinned or not
+        if (!coldest)
+        {
+            // Nothing left to evict, the free areas are too fragmented: start from an empty texture
+            if (page.freeRects.empty())
             {
-                // Oops, we've reached the maximum texture size...
                 err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
                 return IntRect(0, 0, 2, 2);
             }
+
+            page.freeRects.clear();
+            page.packer->reset(page.texture.getSize());
+            page.packer->insert(Vector2u(3, 3), position);
+            continue;
         }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
-    }
+        // Release its area, padding included (empty glyphs don't own any)
+        const IntRect& rect = coldest->glyph.textureRect;
+        if ((rect.width > 0) && (rect.height > 0))
+        {
+            page.freeRects.push_back(IntRect(rect.left - glyphPadding, rect.top - glyphPadding,
+                                             rect.width + 2 * glyphPadding, rect.height + 2 * glyphPadding));
+        }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+        page.glyphs->erase(coldest);
+    }
+}
 
-    // Update the row informations
-    row->width += width;
 
-    return rect;
+////////////////////////////////////////////////////////////
+void Font::pinRequestedGlyphs(unsigned int characterSize, bool pin) const
+{
+    Page& page = getPage(m_isDistanceField ? distanceFieldPageKey : characterSize);
+    page.pinnedFrom = pin ? page.useCounter : std::numeric_limits<Uint64>::max();
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Font::setCurrentSize(unsigned int characterSize) const
+unsigned int Font::getMaximumPageSize() const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
+    unsigned int size = Texture::getMaximumSize();
 
-    FT_Face face = static_cast<FT_Face>(m_face);
-    FT_UShort currentSize = face->size->metrics.x_ppem;
-
-    if (currentSize != characterSize)
+    // Halve the size until a page fits in the budget, but never go below the initial size
+    if (m_pageBudget > 0)
     {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+        while ((size > initialPageSize) && (static_cast<std::size_t>(size) * size * 4 > m_pageBudget))
+            size /= 2;
+    }
 
-        if (result == FT_Err_Invalid_Pixel_Size)
-        {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                {
-                    const unsigned int size = (face->available_sizes[i].y_ppem + 32) >> 6;
-                    err() << size << " ";
-                }
-                err() << std::endl;
-            }
-            else
-            {
-                err() << "Failed to set font size to " << characterSize << std::endl;
-            }
-        }
+    return size;
+}
 
-        return result == FT_Err_Ok;
-    }
 
-     return true;
+////////////////////////////////////////////////////////////
+bool Font::setCurrentSize(unsigned int characterSize) const
+{
+    return setFaceSize(static_cast<FT_Face>(m_face), characterSize);
 }
 
 
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+glyphs    (new priv::GlyphTable),
+packer    (new priv::SkylinePacker(Vector2u(initialPageSize, initialPageSize))),
+useCounter(0),
+pinnedFrom(std::numeric_limits<Uint64>::max())
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    image.create(initialPageSize, initialPageSize, Color(255, 255, 255, 0));
 
     // Reserve a 2x2 white square for texturing underlines
     for (int x = 0; x < 2; ++x)
         for (int y = 0; y < 2; ++y)
             image.setPixel(x, y, Color(255, 255, 255, 255));
 
+    Vector2u position;
+    packer->insert(Vector2u(3, 3), position);
+
     // Create the texture
     texture.loadFromImage(image);
     texture.setSmooth(true);
 }
 
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+glyphs    (new priv::GlyphTable(*copy.glyphs)),
+texture   (copy.texture),
+packer    (new priv::SkylinePacker(*copy.packer)),
+freeRects (copy.freeRects),
+useCounter(copy.useCounter),
+pinnedFrom(copy.pinnedFrom)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::~Page()
+{
+    delete glyphs;
+    delete packer;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::Page::operator =(const Page& right)
+{
+    Page temp(right);
+
+    std::swap(glyphs,     temp.glyphs);
+    std::swap(packer,     temp.packer);
+    std::swap(freeRects,  temp.freeRects);
+    std::swap(useCounter, temp.useCounter);
+    std::swap(pinnedFrom, temp.pinnedFrom);
+    texture.swap(temp.texture);
+
+    return *this;
+}
+
 } // namespace sf
@@ -55,6 +55,7 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -135,6 +136,71 @@
     #define GLEXT_GL_COPY_WRITE_BUFFER                0
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData // Placeholder to satisfy the compiler, entry point is not loaded in GLES
 
+    // Core since 3.3 - ARB_draw_instanced / ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    false
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstanced // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisor // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointer // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArray // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArray // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocation // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+    #define GLEXT_GL_MAP_READ_BIT                     0
+    #define GLEXT_GL_MAP_WRITE_BIT                    0
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         0
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           0
+    #define GLEXT_glMapBufferRange                    glMapBufferRange // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glUnmapBuffer                       glUnmapBuffer // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               false
+    #define GLEXT_GL_UNIFORM_BUFFER                   0
+    #define GLEXT_GL_INVALID_INDEX                    0xFFFFFFFFu
+    #define GLEXT_glBindBufferBase                    glBindBufferBase // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  false
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            0
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  0
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       0
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glProgramBinary                     glProgramBinary // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glProgramParameteri                 glProgramParameteri // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glGetProgramiv                      glGetProgramiv // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                0
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              0
+    #define GLEXT_GL_STREAM_READ                      0
+
+    // Core since 3.0 - EXT_texture_array
+    #define GLEXT_texture_array                       false
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 0
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         0
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         0
+    #define GLEXT_glTexImage3D                        glTexImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3D // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 4.3 - ARB_copy_image
+    #define GLEXT_copy_image                          false
+    #define GLEXT_glCopyImageSubData                  glCopyImageSubData // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                false
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       0
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          0
+    #define GLEXT_GL_ALREADY_SIGNALED                 0
+    #define GLEXT_GL_CONDITION_SATISFIED              0
+    #define GLEXT_GL_TIMEOUT_IGNORED                  0
+    #define GLEXT_glFenceSync                         glFenceSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glClientWaitSync                    glClientWaitSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_glDeleteSync                        glDeleteSync // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+
     // Core since 3.0 - EXT_sRGB
     #define GLEXT_texture_sRGB                        false
     #define GLEXT_GL_SRGB8_ALPHA8                     0
@@ -189,6 +255,7 @@
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                SF_GLAD_GL_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
@@ -201,6 +268,7 @@
     #define GLEXT_glGenBuffers                        glGenBuffersARB
     #define GLEXT_glMapBuffer                         glMapBufferARB
     #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
+    #define GLEXT_glGetBufferSubData                  glGetBufferSubDataARB
 
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                SF_GLAD_GL_ARB_shading_language_100
@@ -226,9 +294,12 @@
     #define GLEXT_glUniform4i                         glUniform4iARB
     #define GLEXT_glUniform1fv                        glUniform1fvARB
     #define GLEXT_glUniform2fv                        glUniform2fvARB
+    #define GLEXT_glUniform1iv                        glUniform1ivARB
     #define GLEXT_glUniform2iv                        glUniform2ivARB
     #define GLEXT_glUniform3fv                        glUniform3fvARB
+    #define GLEXT_glUniform3iv                        glUniform3ivARB
     #define GLEXT_glUniform4fv                        glUniform4fvARB
+    #define GLEXT_glUniform4iv                        glUniform4ivARB
     #define GLEXT_glUniformMatrix3fv                  glUniformMatrix3fvARB
     #define GLEXT_glUniformMatrix4fv                  glUniformMatrix4fvARB
     #define GLEXT_glGetObjectParameteriv              glGetObjectParameterivARB
@@ -241,6 +312,10 @@
 
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       SF_GLAD_GL_ARB_vertex_shader
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
@@ -298,18 +373,105 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - EXT_texture_array
+    #define GLEXT_texture_array                       SF_GLAD_GL_EXT_texture_array
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+    #define GLEXT_glTexImage3D                        glTexImage3D
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3D
+
+    // Core since 4.3 - ARB_copy_image
+    #define GLEXT_copy_image                          SF_GLAD_GL_ARB_copy_image
+    #define GLEXT_glCopyImageSubData                  glCopyImageSubData
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 SF_GLAD_GL_VERSION_2_1
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    SF_GLAD_GL_ARB_map_buffer_range
+    #define GLEXT_GL_MAP_READ_BIT                     GL_MAP_READ_BIT
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         SF_GLAD_GL_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               SF_GLAD_GL_VERSION_3_1
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    SF_GLAD_GL_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                SF_GLAD_GL_ARB_sync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_IGNORED                  GL_TIMEOUT_IGNORED
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
+    // Core since 3.3 - ARB_draw_instanced / ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    SF_GLAD_GL_VERSION_3_3
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstanced
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisor
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  SF_GLAD_GL_ARB_get_program_binary
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_glGetProgramiv                      glGetProgramiv
+
 #endif
 
+    // Core since 1.3 (GLES 1.0) - the supported formats are queried at runtime
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+    #define GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS   GL_NUM_COMPRESSED_TEXTURE_FORMATS
+    #define GLEXT_GL_COMPRESSED_TEXTURE_FORMATS       GL_COMPRESSED_TEXTURE_FORMATS
+
+    // EXT_texture_compression_s3tc / EXT_texture_sRGB
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1        0x83F1
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3        0x83F2
+    #define GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5        0x83F3
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1  0x8C4D
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3  0x8C4E
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5  0x8C4F
+
+    // Core since 3.0 - ARB_texture_compression_rgtc
+    #define GLEXT_GL_COMPRESSED_RED_RGTC1             0x8DBB
+    #define GLEXT_GL_COMPRESSED_RG_RGTC2              0x8DBD
+
+    // Core since 4.2 - ARB_texture_compression_bptc
+    #define GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM       0x8E8C
+    #define GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+
+    // Core since 4.3 (GLES 3.0) - ARB_ES3_compatibility
+    #define GLEXT_GL_COMPRESSED_RGB8_ETC2             0x9274
+    #define GLEXT_GL_COMPRESSED_SRGB8_ETC2            0x9275
+    #define GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC        0x9278
+    #define GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+
     // OpenGL Versions
     #define GLEXT_GL_VERSION_1_0                      SF_GLAD_GL_VERSION_1_0
     #define GLEXT_GL_VERSION_1_1                      SF_GLAD_GL_VERSION_1_1
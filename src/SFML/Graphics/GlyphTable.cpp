@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GlyphTable.hpp>
+#include <cassert>
+
+
+namespace
+{
+    // Number of slots of a new table (must be a power of two)
+    const unsigned int initialSlotBits = 7;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+GlyphTable::GlyphTable() :
+m_entries    (),
+m_freeEntries(),
+m_slots      (std::size_t(1) << initialSlotBits),
+m_used       (std::size_t(1) << initialSlotBits, false),
+m_size       (0),
+m_shift      (64 - initialSlotBits)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Entry* GlyphTable::find(Uint64 key)
+{
+    std::size_t slot = findSlot(key);
+
+    return (slot < m_slots.size()) ? &m_entries[m_slots[slot].entry] : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Entry& GlyphTable::insert(Uint64 key, const Glyph& glyph)
+{
+    assert(!find(key));
+
+    // Keep the table at most half full, so that probe sequences stay short
+    if ((m_size + 1) * 2 > m_slots.size())
+        grow();
+
+    // Reuse the entry of an erased glyph if there is one, so that the storage doesn't grow
+    std::size_t index = m_entries.size();
+    if (!m_freeEntries.empty())
+    {
+        index = m_freeEntries.back();
+        m_freeEntries.pop_back();
+    }
+    else
+    {
+        m_entries.push_back(Entry());
+    }
+
+    Entry& entry = m_entries[index];
+    entry.key     = key;
+    entry.glyph   = glyph;
+    entry.lastUse = 0;
+
+    const std::size_t mask = m_slots.size() - 1;
+
+    std::size_t slot = getHomeSlot(key);
+    while (m_used[slot])
+        slot = (slot + 1) & mask;
+
+    m_slots[slot].key   = key;
+    m_slots[slot].entry = index;
+    m_used[slot] = true;
+    ++m_size;
+
+    return entry;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphTable::erase(Entry* entry)
+{
+    const std::size_t mask = m_slots.size() - 1;
+
+    std::size_t hole = findSlot(entry->key);
+    assert(hole < m_slots.size());
+
+    m_freeEntries.push_back(m_slots[hole].entry);
+    m_used[hole] = false;
+    --m_size;
+
+    // Shift back the following slots of the cluster which would become
+    // unreachable because of the hole, instead of leaving a tombstone
+    for (std::size_t slot = (hole + 1) & mask; m_used[slot]; slot = (slot + 1) & mask)
+    {
+        // Distances from the home slot of the key, modulo the table size
+        std::size_t home = getHomeSlot(m_slots[slot].key);
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            m_slots[hole] = m_slots[slot];
+            m_used[hole] = true;
+            m_used[slot] = false;
+            hole = slot;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+GlyphTable::Entry* GlyphTable::findLeastRecentlyUsed()
+{
+    Entry* coldest = NULL;
+
+    for (std::size_t slot = 0; slot < m_slots.size(); ++slot)
+    {
+        if (m_used[slot])
+        {
+            Entry& entry = m_entries[m_slots[slot].entry];
+            if (!coldest || (entry.lastUse < coldest->lastUse))
+                coldest = &entry;
+        }
+    }
+
+    return coldest;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GlyphTable::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GlyphTable::findSlot(Uint64 key) const
+{
+    const std::size_t mask = m_slots.size() - 1;
+
+    // The table is never full, so the search always ends on an empty slot
+    for (std::size_t slot = getHomeSlot(key); m_used[slot]; slot = (slot + 1) & mask)
+    {
+        if (m_slots[slot].key == key)
+            return slot;
+    }
+
+    return m_slots.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t GlyphTable::getHomeSlot(Uint64 key) const
+{
+    // Fibonacci hashing: the multiplication mixes the glyph index, bold flag
+    // and outline thickness into the high bits, which select the slot
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlyphTable::grow()
+{
+    std::vector<Slot> slots(m_slots.size() * 2);
+    std::vector<bool> used(m_used.size() * 2, false);
+
+    slots.swap(m_slots);
+    used.swap(m_used);
+    --m_shift;
+
+    // Only the slots move, the entries holding the glyphs stay in place
+    const std::size_t mask = m_slots.size() - 1;
+
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if (used[i])
+        {
+            std::size_t slot = getHomeSlot(slots[i].key);
+            while (m_used[slot])
+                slot = (slot + 1) & mask;
+
+            m_slots[slot] = slots[i];
+            m_used[slot] = true;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
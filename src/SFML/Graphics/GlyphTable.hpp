@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLYPHTABLE_HPP
+#define SFML_GLYPHTABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Glyph.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Hash table storing the glyphs of a font page
+///
+/// Glyphs are looked up for every character of every text
+/// geometry update, so the table is an open-addressing hash
+/// table with linear probing: the slots hold the keys next to
+/// each other, a lookup hashes the key once and usually hits
+/// on the first slot, without the pointer chasing of a
+/// node-based container.
+///
+/// The glyphs themselves are stored apart, in entries that
+/// never move: growing the table or erasing a glyph only moves
+/// slots, so references to the other glyphs stay valid (the
+/// references returned by Font::getGlyph rely on it). The
+/// entries of erased glyphs are reused by the next inserts.
+///
+/// The table is kept at most half full, and erasing shifts
+/// the following slots back so that no tombstones are left.
+///
+////////////////////////////////////////////////////////////
+class GlyphTable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph stored in the table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint64 key;     //!< Key of the glyph (glyph index, bold flag and outline thickness)
+        Glyph  glyph;   //!< The glyph
+        Uint64 lastUse; //!< Value of the page use counter when the glyph was last requested
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphTable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a glyph
+    ///
+    /// The returned pointer stays valid until the glyph is erased.
+    ///
+    /// \param key Key of the glyph
+    ///
+    /// \return Pointer to the entry of the glyph, or NULL if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry* find(Uint64 key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a glyph
+    ///
+    /// \a key must not already be in the table.
+    ///
+    /// \param key   Key of the glyph
+    /// \param glyph Glyph to insert
+    ///
+    /// \return Entry of the inserted glyph, valid until it is erased
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry& insert(Uint64 key, const Glyph& glyph);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a glyph
+    ///
+    /// \param entry Entry of the glyph, as returned by find
+    ///
+    ////////////////////////////////////////////////////////////
+    void erase(Entry* entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the glyph which was requested the longest time ago
+    ///
+    /// \return Pointer to the entry of the glyph, or NULL if the table is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    Entry* findLeastRecentlyUsed();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of glyphs in the table
+    ///
+    /// \return Number of glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Slot of the hash table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Uint64      key;   //!< Key of the glyph
+        std::size_t entry; //!< Index of the entry holding the glyph
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the slot of a key
+    ///
+    /// \param key Key of the glyph
+    ///
+    /// \return Index of the slot, or the number of slots if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findSlot(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the slot where the search for a key starts
+    ///
+    /// \param key Key to hash
+    ///
+    /// \return Index of the slot
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getHomeSlot(Uint64 key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the number of slots and reinsert the glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Entry>        m_entries;     //!< Glyphs of the table, never moved once inserted
+    std::vector<std::size_t> m_freeEntries; //!< Indices of the entries released by erase
+    std::vector<Slot>        m_slots;       //!< Slots of the table, their number is a power of two
+    std::vector<bool>        m_used;        //!< Tell whether each slot holds a glyph
+    std::size_t              m_size;        //!< Number of glyphs in the table
+    unsigned int             m_shift;       //!< Shift turning a 64-bit hash into a slot index
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLYPHTABLE_HPP
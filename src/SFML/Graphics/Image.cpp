@@ -34,6 +34,504 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define SFML_IMAGE_AVX2
+    #define SFML_IMAGE_SSSE3
+    #define SFML_IMAGE_SSE
+#elif defined(__SSSE3__)
+    #include <tmmintrin.h>
+    #define SFML_IMAGE_SSSE3
+    #define SFML_IMAGE_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_NEON
+#endif
+
+
+namespace
+{
+    // Divide by 255 rounding down, the way the original per-pixel loops did
+    inline sf::Uint8 divide255(unsigned int x)
+    {
+        return static_cast<sf::Uint8>(x / 255);
+    }
+
+    // Divide a product of two components by 255, rounding to the nearest integer
+    inline sf::Uint8 divide255Rounded(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x + 127) / 255);
+    }
+
+    // Add two components, clamping the result to 255
+    inline sf::Uint8 addSaturated(unsigned int a, unsigned int b)
+    {
+        return static_cast<sf::Uint8>(std::min(a + b, 255u));
+    }
+
+#if defined(SFML_IMAGE_SSE)
+
+    // The vector versions work on two pixels widened to 16-bit lanes.
+    // Both divisions are exact for any sum of products of two components
+    // (x <= 65025), so the results match the scalar versions bit for bit.
+    inline __m128i divide255(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(1));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    inline __m128i divide255Rounded(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Copy the alpha of each pixel to its four lanes
+    inline __m128i broadcastAlpha(__m128i pixels)
+    {
+        pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Take the alpha lanes from a and the color lanes from b
+    inline __m128i selectAlpha(__m128i a, __m128i b)
+    {
+        const __m128i alphaLanes = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+        return _mm_or_si128(_mm_and_si128(alphaLanes, a), _mm_andnot_si128(alphaLanes, b));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    // The vector versions work on one component of eight pixels widened
+    // to 16-bit lanes, and narrow the result back to 8 bits
+    inline uint8x8_t divide255(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(1));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+    inline uint8x8_t divide255Rounded(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+#endif
+
+    // Blending equations, each one provided in a scalar version (one pixel)
+    // and a vector version (two 16-bit pixels for SSE, eight deinterleaved pixels for NEON)
+
+    // dst = src * src.a + dst * (1 - src.a), alpha = src.a + dst.a * (1 - src.a)
+    struct AlphaBlending
+    {
+        static void blend(const sf::Uint8* src, sf::Uint8* dst)
+        {
+            unsigned int alpha = src[3];
+            dst[0] = divide255(src[0] * alpha + dst[0] * (255 - alpha));
+            dst[1] = divide255(src[1] * alpha + dst[1] * (255 - alpha));
+            dst[2] = divide255(src[2] * alpha + dst[2] * (255 - alpha));
+            dst[3] = static_cast<sf::Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+        }
+
+#if defined(SFML_IMAGE_SSE)
+        static __m128i blend(__m128i src, __m128i dst)
+        {
+            __m128i alpha      = broadcastAlpha(src);
+            __m128i background = _mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), alpha));
+            __m128i color      = divide255(_mm_add_epi16(_mm_mullo_epi16(src, alpha), background));
+            return selectAlpha(_mm_add_epi16(alpha, divide255(background)), color);
+        }
+#elif defined(SFML_IMAGE_NEON)
+        static uint8x8x4_t blend(uint8x8x4_t src, uint8x8x4_t dst)
+        {
+            uint8x8_t alpha   = src.val[3];
+            uint8x8_t inverse = vmvn_u8(alpha);
+            for (int i = 0; i < 3; ++i)
+                dst.val[i] = divide255(vmlal_u8(vmull_u8(src.val[i], alpha), dst.val[i], inverse));
+            dst.val[3] = vadd_u8(alpha, divide255(vmull_u8(dst.val[3], inverse)));
+            return dst;
+        }
+#endif
+    };
+
+    // dst = dst + src * src.a, alpha = dst.a + src.a
+    struct AddBlending
+    {
+        static void blend(const sf::Uint8* src, sf::Uint8* dst)
+        {
+            unsigned int alpha = src[3];
+            dst[0] = addSaturated(dst[0], divide255Rounded(src[0] * alpha));
+            dst[1] = addSaturated(dst[1], divide255Rounded(src[1] * alpha));
+            dst[2] = addSaturated(dst[2], divide255Rounded(src[2] * alpha));
+            dst[3] = addSaturated(dst[3], alpha);
+        }
+
+#if defined(SFML_IMAGE_SSE)
+        static __m128i blend(__m128i src, __m128i dst)
+        {
+            // The sum may exceed 255, it is clamped when packed back to 8 bits
+            __m128i color = divide255Rounded(_mm_mullo_epi16(src, broadcastAlpha(src)));
+            return _mm_add_epi16(dst, selectAlpha(src, color));
+        }
+#elif defined(SFML_IMAGE_NEON)
+        static uint8x8x4_t blend(uint8x8x4_t src, uint8x8x4_t dst)
+        {
+            for (int i = 0; i < 3; ++i)
+                dst.val[i] = vqadd_u8(dst.val[i], divide255Rounded(vmull_u8(src.val[i], src.val[3])));
+            dst.val[3] = vqadd_u8(dst.val[3], src.val[3]);
+            return dst;
+        }
+#endif
+    };
+
+    // dst = src * dst, on all components
+    struct MultiplyBlending
+    {
+        static void blend(const sf::Uint8* src, sf::Uint8* dst)
+        {
+            for (int i = 0; i < 4; ++i)
+                dst[i] = divide255Rounded(src[i] * dst[i]);
+        }
+
+#if defined(SFML_IMAGE_SSE)
+        static __m128i blend(__m128i src, __m128i dst)
+        {
+            return divide255Rounded(_mm_mullo_epi16(src, dst));
+        }
+#elif defined(SFML_IMAGE_NEON)
+        static uint8x8x4_t blend(uint8x8x4_t src, uint8x8x4_t dst)
+        {
+            for (int i = 0; i < 4; ++i)
+                dst.val[i] = divide255Rounded(vmull_u8(src.val[i], dst.val[i]));
+            return dst;
+        }
+#endif
+    };
+
+    // dst = src + dst * (1 - src.a), on all components, for premultiplied sources
+    struct PremultipliedAlphaBlending
+    {
+        static void blend(const sf::Uint8* src, sf::Uint8* dst)
+        {
+            unsigned int inverse = 255 - src[3];
+            for (int i = 0; i < 4; ++i)
+                dst[i] = addSaturated(src[i], divide255Rounded(dst[i] * inverse));
+        }
+
+#if defined(SFML_IMAGE_SSE)
+        static __m128i blend(__m128i src, __m128i dst)
+        {
+            __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), broadcastAlpha(src));
+            return _mm_add_epi16(src, divide255Rounded(_mm_mullo_epi16(dst, inverse)));
+        }
+#elif defined(SFML_IMAGE_NEON)
+        static uint8x8x4_t blend(uint8x8x4_t src, uint8x8x4_t dst)
+        {
+            uint8x8_t inverse = vmvn_u8(src.val[3]);
+            for (int i = 0; i < 4; ++i)
+                dst.val[i] = vqadd_u8(src.val[i], divide255Rounded(vmull_u8(dst.val[i], inverse)));
+            return dst;
+        }
+#endif
+    };
+
+    // Multiply the color by the alpha, ignores the destination
+    // (used in place, with the same row as source and destination)
+    struct Premultiplication
+    {
+        static void blend(const sf::Uint8* src, sf::Uint8* dst)
+        {
+            unsigned int alpha = src[3];
+            dst[0] = divide255Rounded(src[0] * alpha);
+            dst[1] = divide255Rounded(src[1] * alpha);
+            dst[2] = divide255Rounded(src[2] * alpha);
+        }
+
+#if defined(SFML_IMAGE_SSE)
+        static __m128i blend(__m128i src, __m128i)
+        {
+            return selectAlpha(src, divide255Rounded(_mm_mullo_epi16(src, broadcastAlpha(src))));
+        }
+#elif defined(SFML_IMAGE_NEON)
+        static uint8x8x4_t blend(uint8x8x4_t src, uint8x8x4_t)
+        {
+            for (int i = 0; i < 3; ++i)
+                src.val[i] = divide255Rounded(vmull_u8(src.val[i], src.val[3]));
+            return src;
+        }
+#endif
+    };
+
+    // Blend a row of pixels onto another one
+    template <typename Blending>
+    void blendRow(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE)
+
+        // 4 pixels per iteration, widened to 16 bits in two halves
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i source      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            __m128i low         = Blending::blend(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero));
+            __m128i high        = Blending::blend(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(low, high));
+        }
+
+#elif defined(SFML_IMAGE_NEON)
+
+        // 8 pixels per iteration, deinterleaved by the load
+        for (; i + 8 <= count; i += 8)
+            vst4_u8(dst + i * 4, Blending::blend(vld4_u8(src + i * 4), vld4_u8(dst + i * 4)));
+
+#endif
+
+        // Remaining pixels
+        for (; i < count; ++i)
+            Blending::blend(src + i * 4, dst + i * 4);
+    }
+
+    // Set the alpha of the pixels of a row that match a color key
+    void maskRow(sf::Uint8* pixels, std::size_t count, const sf::Uint8* key, sf::Uint8 alpha)
+    {
+        std::size_t i = 0;
+
+        // Compare whole pixels as 32-bit integers
+        const sf::Uint8 alphaBytes[4] = {0, 0, 0, alpha};
+        const sf::Uint8 maskBytes[4]  = {0, 0, 0, 255};
+        sf::Uint32 keyValue, alphaValue, alphaMask;
+        std::memcpy(&keyValue, key, 4);
+        std::memcpy(&alphaValue, alphaBytes, 4);
+        std::memcpy(&alphaMask, maskBytes, 4);
+
+#if defined(SFML_IMAGE_AVX2)
+
+        // 8 pixels per iteration
+        const __m256i wideKey   = _mm256_set1_epi32(static_cast<int>(keyValue));
+        const __m256i wideAlpha = _mm256_set1_epi32(static_cast<int>(alphaValue));
+        const __m256i wideMask  = _mm256_set1_epi32(static_cast<int>(alphaMask));
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* block   = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i  values  = _mm256_loadu_si256(block);
+            __m256i  matches = _mm256_and_si256(_mm256_cmpeq_epi32(values, wideKey), wideMask);
+            _mm256_storeu_si256(block, _mm256_or_si256(_mm256_andnot_si256(matches, values), _mm256_and_si256(matches, wideAlpha)));
+        }
+
+#endif
+
+#if defined(SFML_IMAGE_SSE)
+
+        // 4 pixels per iteration
+        const __m128i keys       = _mm_set1_epi32(static_cast<int>(keyValue));
+        const __m128i alphas     = _mm_set1_epi32(static_cast<int>(alphaValue));
+        const __m128i alphaLanes = _mm_set1_epi32(static_cast<int>(alphaMask));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* block   = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i  values  = _mm_loadu_si128(block);
+            __m128i  matches = _mm_and_si128(_mm_cmpeq_epi32(values, keys), alphaLanes);
+            _mm_storeu_si128(block, _mm_or_si128(_mm_andnot_si128(matches, values), _mm_and_si128(matches, alphas)));
+        }
+
+#elif defined(SFML_IMAGE_NEON)
+
+        // 4 pixels per iteration
+        const uint32x4_t keys       = vdupq_n_u32(keyValue);
+        const uint32x4_t alphas     = vdupq_n_u32(alphaValue);
+        const uint32x4_t alphaLanes = vdupq_n_u32(alphaMask);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t values  = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+            uint32x4_t matches = vandq_u32(vceqq_u32(values, keys), alphaLanes);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(matches, alphas, values)));
+        }
+
+#endif
+
+        // Remaining pixels
+        for (; i < count; ++i)
+        {
+            sf::Uint8* pixel = pixels + i * 4;
+            if ((pixel[0] == key[0]) && (pixel[1] == key[1]) && (pixel[2] == key[2]) && (pixel[3] == key[3]))
+                pixel[3] = alpha;
+        }
+    }
+
+    // Reverse the order of the pixels of a row, swapping blocks from both ends
+    void reverseRow(sf::Uint8* row, std::size_t count)
+    {
+        sf::Uint8*  left      = row;
+        sf::Uint8*  right     = row + count * 4;
+        std::size_t remaining = count;
+
+#if defined(SFML_IMAGE_AVX2)
+
+        // 2 blocks of 8 pixels per iteration
+        const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+        for (; remaining >= 16; remaining -= 16)
+        {
+            right -= 32;
+            __m256i leftBlock  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+            __m256i rightBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left), _mm256_permutevar8x32_epi32(rightBlock, reversed));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), _mm256_permutevar8x32_epi32(leftBlock, reversed));
+            left += 32;
+        }
+
+#endif
+
+#if defined(SFML_IMAGE_SSE)
+
+        // 2 blocks of 4 pixels per iteration
+        for (; remaining >= 8; remaining -= 8)
+        {
+            right -= 16;
+            __m128i leftBlock  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+            __m128i rightBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left), _mm_shuffle_epi32(rightBlock, _MM_SHUFFLE(0, 1, 2, 3)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(leftBlock, _MM_SHUFFLE(0, 1, 2, 3)));
+            left += 16;
+        }
+
+#elif defined(SFML_IMAGE_NEON)
+
+        // 2 blocks of 4 pixels per iteration
+        for (; remaining >= 8; remaining -= 8)
+        {
+            right -= 16;
+            uint32x4_t leftBlock  = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+            uint32x4_t rightBlock = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+            vst1q_u8(left, vreinterpretq_u8_u32(vextq_u32(rightBlock, rightBlock, 2)));
+            vst1q_u8(right, vreinterpretq_u8_u32(vextq_u32(leftBlock, leftBlock, 2)));
+            left += 16;
+        }
+
+#endif
+
+        // Remaining pixels, the middle one (if any) stays in place
+        for (; remaining >= 2; remaining -= 2)
+        {
+            right -= 4;
+            std::swap_ranges(left, left + 4, right);
+            left += 4;
+        }
+    }
+
+    // Reorder the components of the pixels of a row, order[i] being the index of
+    // the source component written to component i
+    void swizzleRow(sf::Uint8* pixels, std::size_t count, const sf::Uint8* order)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSSE3) || (defined(SFML_IMAGE_NEON) && defined(__aarch64__))
+
+        // Byte shuffle pattern covering 8 pixels, the 256-bit shuffle works within 128-bit lanes
+        sf::Uint8 pattern[32];
+        for (int j = 0; j < 32; ++j)
+            pattern[j] = static_cast<sf::Uint8>((j & 12) + order[j & 3]);
+
+#endif
+
+#if defined(SFML_IMAGE_AVX2)
+
+        // 8 pixels per iteration
+        const __m256i widePattern = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* block = reinterpret_cast<__m256i*>(pixels + i * 4);
+            _mm256_storeu_si256(block, _mm256_shuffle_epi8(_mm256_loadu_si256(block), widePattern));
+        }
+
+#endif
+
+#if defined(SFML_IMAGE_SSSE3)
+
+        // 4 pixels per iteration
+        const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+            _mm_storeu_si128(block, _mm_shuffle_epi8(_mm_loadu_si128(block), shuffle));
+        }
+
+#elif defined(SFML_IMAGE_SSE)
+
+        // 4 pixels per iteration: without byte shuffles, move each component
+        // to its destination with shifts of the whole pixels
+        const __m128i componentMask = _mm_set1_epi32(0xFF);
+        const __m128i redShift      = _mm_cvtsi32_si128(order[0] * 8);
+        const __m128i greenShift    = _mm_cvtsi32_si128(order[1] * 8);
+        const __m128i blueShift     = _mm_cvtsi32_si128(order[2] * 8);
+        const __m128i alphaShift    = _mm_cvtsi32_si128(order[3] * 8);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i* block  = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i  values = _mm_loadu_si128(block);
+            __m128i  red    = _mm_and_si128(_mm_srl_epi32(values, redShift), componentMask);
+            __m128i  green  = _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(values, greenShift), componentMask), 8);
+            __m128i  blue   = _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(values, blueShift), componentMask), 16);
+            __m128i  alpha  = _mm_slli_epi32(_mm_srl_epi32(values, alphaShift), 24);
+            _mm_storeu_si128(block, _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, alpha)));
+        }
+
+#elif defined(SFML_IMAGE_NEON) && defined(__aarch64__)
+
+        // 4 pixels per iteration
+        const uint8x16_t shuffle = vld1q_u8(pattern);
+
+        for (; i + 4 <= count; i += 4)
+            vst1q_u8(pixels + i * 4, vqtbl1q_u8(vld1q_u8(pixels + i * 4), shuffle));
+
+#endif
+
+        // Remaining pixels
+        for (; i < count; ++i)
+        {
+            sf::Uint8* pixel = pixels + i * 4;
+            const sf::Uint8 source[4] = {pixel[0], pixel[1], pixel[2], pixel[3]};
+            pixel[0] = source[order[0]];
+            pixel[1] = source[order[1]];
+            pixel[2] = source[order[2]];
+            pixel[3] = source[order[3]];
+        }
+    }
+
+    // Fill a row with a color: write the first pixel, then double
+    // the filled part with each copy
+    void fillRow(sf::Uint8* row, std::size_t count, const sf::Color& color)
+    {
+        if (count == 0)
+            return;
+
+        row[0] = color.r;
+        row[1] = color.g;
+        row[2] = color.b;
+        row[3] = color.a;
+
+        for (std::size_t filled = 1; filled < count; )
+        {
+            std::size_t block = std::min(filled, count - filled);
+            std::memcpy(row + filled * 4, row, block * 4);
+            filled += block;
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -61,15 +559,7 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         std::vector<Uint8> newPixels(width * height * 4);
     
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        fillRow(&newPixels[0], width * height, color);
     
         // Commit the new pixel buffer
         m_pixels.swap(newPixels);
@@ -147,6 +637,26 @@ bool Image::loadFromStream(InputStream& stream)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Image::loadFromFiles(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount)
+{
+    std::vector<std::vector<Uint8> > pixels(filenames.size());
+    std::vector<Vector2u>            sizes(filenames.size(), Vector2u(0, 0));
+
+    bool loaded = priv::ImageLoader::getInstance().loadImagesFromFiles(filenames, pixels, sizes, threadCount);
+
+    // Hand the decoded pixels over to the images, without copying them
+    images.resize(filenames.size());
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        images[i].m_pixels.swap(pixels[i]);
+        images[i].m_size = sizes[i];
+    }
+
+    return loaded;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
@@ -174,20 +684,21 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 key[4] = {color.r, color.g, color.b, color.a};
+        maskRow(&m_pixels[0], m_pixels.size() / 4, key, alpha);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
+{
+    blit(source, destX, destY, sourceRect, applyAlpha ? Alpha : Replace);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blit(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, Blending blending)
 {
     // Make sure that both images are valid
     if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
@@ -229,35 +740,31 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
-    if (applyAlpha)
+    if (blending == Replace)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Plain copy ignoring alpha values, row by row
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            std::memcpy(dstPixels, srcPixels, pitch);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
     }
     else
     {
-        // Optimized copy ignoring alpha values, row by row (faster)
+        // Pick the blending equation once for all the rows
+        void (*blendPixels)(const Uint8*, Uint8*, std::size_t) = NULL;
+        switch (blending)
+        {
+            case Add:                blendPixels = &blendRow<AddBlending>;                break;
+            case Multiply:           blendPixels = &blendRow<MultiplyBlending>;           break;
+            case PremultipliedAlpha: blendPixels = &blendRow<PremultipliedAlphaBlending>; break;
+            default:                 blendPixels = &blendRow<AlphaBlending>;              break;
+        }
+
         for (int i = 0; i < rows; ++i)
         {
-            std::memcpy(dstPixels, srcPixels, pitch);
+            blendPixels(srcPixels, dstPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -265,6 +772,55 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::fillRect(const IntRect& rectangle, const Color& color)
+{
+    // Clip the rectangle to the image
+    int left   = std::max(rectangle.left, 0);
+    int top    = std::max(rectangle.top, 0);
+    int right  = std::min(rectangle.left + rectangle.width, static_cast<int>(m_size.x));
+    int bottom = std::min(rectangle.top + rectangle.height, static_cast<int>(m_size.y));
+
+    // Make sure the area is valid
+    if ((left >= right) || (top >= bottom))
+        return;
+
+    // Fill the first row, then replicate it
+    std::size_t stride = m_size.x * 4;
+    std::size_t pitch  = (right - left) * 4;
+    Uint8*      first  = &m_pixels[0] + (left + top * m_size.x) * 4;
+
+    fillRow(first, right - left, color);
+    for (int y = top + 1; y < bottom; ++y)
+        std::memcpy(first + (y - top) * stride, first, pitch);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        blendRow<Premultiplication>(&m_pixels[0], &m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::swizzleChannels(unsigned int red, unsigned int green, unsigned int blue, unsigned int alpha)
+{
+    if ((red > 3) || (green > 3) || (blue > 3) || (alpha > 3))
+    {
+        err() << "Failed to swizzle image channels, channel indices must be in range [0, 3]" << std::endl;
+        return;
+    }
+
+    if (!m_pixels.empty())
+    {
+        const Uint8 order[4] = {static_cast<Uint8>(red), static_cast<Uint8>(green), static_cast<Uint8>(blue), static_cast<Uint8>(alpha)};
+        swizzleRow(&m_pixels[0], m_pixels.size() / 4, order);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
@@ -307,18 +863,7 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            reverseRow(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -330,12 +875,16 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        // Swap the rows through a temporary one, with bulk copies
+        std::vector<Uint8> row(rowSize);
+        Uint8* top    = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + (m_size.y - 1) * rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            std::memcpy(&row[0], top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, &row[0], rowSize);
 
             top += rowSize;
             bottom -= rowSize;
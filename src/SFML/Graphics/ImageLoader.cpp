@@ -28,12 +28,19 @@
 #include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#include <algorithm>
 #include <cctype>
 #include <iterator>
+#include <thread>
 
 
 namespace
@@ -70,6 +77,54 @@ namespace
         std::vector<sf::Uint8>* dest = static_cast<std::vector<sf::Uint8>*>(context);
         std::copy(source, source + size, std::back_inserter(*dest));
     }
+
+    // Files shared by the threads decoding a batch of images
+    struct Batch
+    {
+        const std::vector<std::string>*       filenames;
+        std::vector<std::vector<sf::Uint8> >* pixels;
+        std::vector<sf::Vector2u>*            sizes;
+        sf::Mutex                             mutex;
+        std::size_t                           next;
+        std::size_t                           failures;
+    };
+
+    // Decode the files of a batch until there are none left
+    void decodeBatch(Batch* batch)
+    {
+        sf::priv::ImageLoader& loader = sf::priv::ImageLoader::getInstance();
+
+        for (;;)
+        {
+            // Take the next file
+            std::size_t index;
+            {
+                sf::Lock lock(batch->mutex);
+                if (batch->next == batch->filenames->size())
+                    return;
+                index = batch->next++;
+            }
+
+            const std::string& filename = (*batch->filenames)[index];
+
+            #ifndef SFML_SYSTEM_ANDROID
+
+                bool loaded = loader.loadImageFromFile(filename, (*batch->pixels)[index], (*batch->sizes)[index]);
+
+            #else
+
+                sf::priv::ResourceStream stream(filename);
+                bool loaded = loader.loadImageFromStream(stream, (*batch->pixels)[index], (*batch->sizes)[index]);
+
+            #endif
+
+            if (!loaded)
+            {
+                sf::Lock lock(batch->mutex);
+                batch->failures++;
+            }
+        }
+    }
 }
 
 
@@ -133,6 +188,7 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
     else
     {
         // Error, failed to load the image
+        Lock lock(m_errorMutex);
         err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
@@ -140,6 +196,39 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 }
 
 
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImagesFromFiles(const std::vector<std::string>& filenames, std::vector<std::vector<Uint8> >& pixels, std::vector<Vector2u>& sizes, unsigned int threadCount)
+{
+    Batch batch;
+    batch.filenames = &filenames;
+    batch.pixels    = &pixels;
+    batch.sizes     = &sizes;
+    batch.next      = 0;
+    batch.failures  = 0;
+
+    // Don't start more threads than there are files to decode
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, filenames.size()));
+
+    // Start the other threads, the calling thread takes part in the decoding too
+    std::vector<Thread*> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(new Thread(&decodeBatch, &batch));
+        threads.back()->launch();
+    }
+
+    decodeBatch(&batch);
+
+    // Wait until the other threads are done
+    for (std::vector<Thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+        delete *it;
+
+    return batch.failures == 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
 {
@@ -177,6 +266,7 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         else
         {
             // Error, failed to load the image
+            Lock lock(m_errorMutex);
             err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
             return false;
@@ -232,6 +322,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     else
     {
         // Error, failed to load the image
+        Lock lock(m_errorMutex);
         err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -70,6 +71,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from files on disk, in parallel
+    ///
+    /// The files are decoded by \a threadCount threads (including
+    /// the calling one), each taking the next file as soon as it
+    /// is done with the previous one. This function returns when
+    /// all the files are decoded.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param pixels      Arrays of pixels to fill, one per file (must have the same size as \a filenames)
+    /// \param sizes       Sizes of loaded images, one per file (must have the same size as \a filenames)
+    /// \param threadCount Number of threads decoding the files, 0 to use one per processor core
+    ///
+    /// \return True if all the images were loaded successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImagesFromFiles(const std::vector<std::string>& filenames, std::vector<std::vector<Uint8> >& pixels, std::vector<Vector2u>& sizes, unsigned int threadCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
@@ -133,6 +152,11 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     ~ImageLoader();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex m_errorMutex; //!< Serializes the error messages of the threads loading images
 };
 
 } // namespace priv
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageRequest.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Asynchronous copies need pixel buffers that can be mapped for reading, and fences to poll them
+    bool isAsyncCopyAvailable()
+    {
+        return GLEXT_pixel_buffer_object && GLEXT_map_buffer_range && GLEXT_sync;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageRequest::ImageRequest() :
+m_buffer   (0),
+m_capacity (0),
+m_fence    (NULL),
+m_size     (0, 0),
+m_rowLength(0),
+m_flipped  (false),
+m_pending  (false),
+m_pixels   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageRequest::~ImageRequest()
+{
+    if (m_buffer || m_fence)
+    {
+        TransientContextLock contextLock;
+
+        releaseFence();
+
+        if (m_buffer)
+            glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageRequest::isPending() const
+{
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageRequest::isReady() const
+{
+    if (!m_pending)
+        return false;
+
+    // Synchronous copies are ready as soon as they are requested
+    if (!m_fence)
+        return true;
+
+    TransientContextLock contextLock;
+
+    GLenum status = 0;
+    glCheck(status = GLEXT_glClientWaitSync(static_cast<GLsync>(m_fence), 0, 0));
+
+    return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageRequest::getImage(Image& image)
+{
+    if (!m_pending)
+        return false;
+
+    m_pending = false;
+
+    // Synchronous copy: the pixels are already there
+    if (m_pixels.size() == static_cast<std::size_t>(m_size.x) * m_size.y * 4)
+    {
+        image.create(m_size.x, m_size.y, &m_pixels[0]);
+        m_pixels.clear();
+        return true;
+    }
+
+    TransientContextLock contextLock;
+
+    // Wait for the transfer to the pixel buffer, if it is not finished yet
+    if (m_fence)
+        glCheck(GLEXT_glClientWaitSync(static_cast<GLsync>(m_fence), GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, GLEXT_GL_TIMEOUT_IGNORED));
+
+    releaseFence();
+
+    // Only the rows of the image are needed, padded textures have more
+    std::size_t size = static_cast<std::size_t>(m_rowLength) * m_size.y * 4;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+    const Uint8* source = NULL;
+    glCheck(source = static_cast<const Uint8*>(GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GLEXT_GL_MAP_READ_BIT)));
+
+    bool success = (source != NULL);
+    if (success)
+    {
+        if ((m_rowLength == m_size.x) && !m_flipped)
+        {
+            // Rows are neither padded nor flipped, we can use a direct copy
+            image.create(m_size.x, m_size.y, source);
+        }
+        else
+        {
+            // Copy the useful pixels row by row
+            m_pixels.resize(static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+
+            const Uint8* src = source;
+            Uint8* dst = &m_pixels[0];
+            std::ptrdiff_t srcPitch = static_cast<std::ptrdiff_t>(m_rowLength) * 4;
+            std::size_t dstPitch = static_cast<std::size_t>(m_size.x) * 4;
+
+            // Handle the case where source pixels are flipped vertically
+            if (m_flipped)
+            {
+                src += srcPitch * (m_size.y - 1);
+                srcPitch = -srcPitch;
+            }
+
+            for (unsigned int i = 0; i < m_size.y; ++i)
+            {
+                std::memcpy(dst, src, dstPitch);
+                src += srcPitch;
+                dst += dstPitch;
+            }
+
+            image.create(m_size.x, m_size.y, &m_pixels[0]);
+            m_pixels.clear();
+        }
+
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+    }
+    else
+    {
+        err() << "Failed to retrieve the pixels of an image request, failed to map the pixel buffer" << std::endl;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageRequest::beginCopy(const Vector2u& size, unsigned int rowLength, unsigned int rowCount, bool flipped)
+{
+    // Abandon the previous copy
+    releaseFence();
+    m_pending = false;
+    m_pixels.clear();
+
+    if (!isAsyncCopyAvailable())
+        return false;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create the pixel buffer of an image request, falling back to a synchronous copy" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+    // Only reallocate the storage when the copy doesn't fit anymore
+    std::size_t bytes = static_cast<std::size_t>(rowLength) * rowCount * 4;
+    if (bytes > m_capacity)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), 0, GLEXT_GL_STREAM_READ));
+        m_capacity = bytes;
+    }
+
+    m_size      = size;
+    m_rowLength = rowLength;
+    m_flipped   = flipped;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageRequest::endCopy()
+{
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    GLsync fence = 0;
+    glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    m_fence = fence;
+    m_pending = true;
+
+    // Make sure that the commands are submitted, so that the fence can be signaled
+    glCheck(glFlush());
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageRequest::setImage(const Image& image)
+{
+    releaseFence();
+
+    m_size      = image.getSize();
+    m_rowLength = m_size.x;
+    m_flipped   = false;
+    m_pending   = true;
+
+    if (image.getPixelsPtr())
+        m_pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+    else
+        m_pending = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageRequest::releaseFence()
+{
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLsync>(m_fence)));
+        m_fence = NULL;
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+namespace
+{
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                        return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer() :
+m_buffer(0),
+m_size  (0),
+m_type  (Index16),
+m_usage (VertexBuffer::Stream)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(IndexType type) :
+m_buffer(0),
+m_size  (0),
+m_type  (type),
+m_usage (VertexBuffer::Stream)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(VertexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_type  (Index16),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(IndexType type, VertexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_type  (type),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexBuffer(const IndexBuffer& copy) :
+m_buffer(0),
+m_size  (0),
+m_type  (copy.m_type),
+m_usage (copy.m_usage)
+{
+    if (copy.m_buffer && copy.m_size)
+    {
+        if (!create(copy.m_size))
+        {
+            err() << "Could not create index buffer for copying" << std::endl;
+            return;
+        }
+
+        if (!update(copy))
+            err() << "Could not copy index buffer" << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::~IndexBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::create(std::size_t indexCount)
+{
+    if (!isAvailable())
+        return false;
+
+#ifdef SFML_OPENGL_ES
+
+    if (m_type == Index32)
+    {
+        err() << "32-bit indices are not supported on OpenGL ES, index buffer creation failed" << std::endl;
+        return false;
+    }
+
+#endif
+
+    TransientContextLock contextLock;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create index buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, getIndexSize() * indexCount, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    m_size = indexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getIndexCount() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint16* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != Index16)
+        return false;
+
+    return updateData(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const Uint32* indices, std::size_t indexCount, unsigned int offset)
+{
+    if (m_type != Index32)
+        return false;
+
+    return updateData(indices, indexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::update(const IndexBuffer& indexBuffer)
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_buffer || !indexBuffer.m_buffer || (m_type != indexBuffer.m_type))
+        return false;
+
+    // The copied indices must fit in the storage of this buffer
+    if (indexBuffer.m_size > m_size)
+        return false;
+
+    TransientContextLock contextLock;
+
+    // Make sure that extensions are initialized
+    sf::priv::ensureExtensionsInit();
+
+    std::size_t size = getIndexSize() * indexBuffer.m_size;
+
+    if (GLEXT_copy_buffer)
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, indexBuffer.m_buffer));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
+
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, size));
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
+
+        return true;
+    }
+
+    // Map both buffers through GL_ARRAY_BUFFER, which doesn't disturb the element array binding
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, size, 0, usageToGlEnum(m_usage)));
+
+    void* destination = 0;
+    glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, indexBuffer.m_buffer));
+
+    void* source = 0;
+    glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
+
+    std::memcpy(destination, source, size);
+
+    GLboolean sourceResult = GL_FALSE;
+    glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    GLboolean destinationResult = GL_FALSE;
+    glCheck(destinationResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
+        return false;
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer& IndexBuffer::operator =(const IndexBuffer& right)
+{
+    IndexBuffer temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::swap(IndexBuffer& right)
+{
+    std::swap(m_size,   right.m_size);
+    std::swap(m_buffer, right.m_buffer);
+    std::swap(m_type,   right.m_type);
+    std::swap(m_usage,  right.m_usage);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int IndexBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::setIndexType(IndexType type)
+{
+#ifdef SFML_OPENGL_ES
+
+    if (type == Index32)
+    {
+        err() << "32-bit indices are not supported on OpenGL ES, index type left unchanged" << std::endl;
+        return;
+    }
+
+#endif
+
+    if (type == m_type)
+        return;
+
+    m_type = type;
+
+    // The storage was allocated for the previous index size: forget its
+    // contents so that nothing is read or written until it is created again
+    if (m_buffer)
+        m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+IndexBuffer::IndexType IndexBuffer::getIndexType() const
+{
+    return m_type;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::setUsage(VertexBuffer::Usage usage)
+{
+    m_usage = usage;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage IndexBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void IndexBuffer::bind(const IndexBuffer* indexBuffer)
+{
+    if (!isAvailable())
+        return;
+
+    TransientContextLock lock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexBuffer ? indexBuffer->m_buffer : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::isAvailable()
+{
+    return VertexBuffer::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t IndexBuffer::getIndexSize() const
+{
+    return (m_type == Index32) ? sizeof(Uint32) : sizeof(Uint16);
+}
+
+
+////////////////////////////////////////////////////////////
+bool IndexBuffer::updateData(const void* indices, std::size_t indexCount, unsigned int offset)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!indices)
+        return false;
+
+    if (offset && (offset + indexCount > m_size))
+        return false;
+
+    TransientContextLock contextLock;
+
+    std::size_t indexSize = getIndexSize();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, m_buffer));
+
+    // Check if we need to resize or orphan the buffer
+    if (indexCount >= m_size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexSize * indexCount, 0, usageToGlEnum(m_usage)));
+
+        m_size = indexCount;
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexSize * offset, indexSize * indexCount, indices));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
+} // namespace sf
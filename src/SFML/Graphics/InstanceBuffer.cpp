@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/InstancingShader.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                        return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+
+    // Convert an instance to the layout expected by the instancing shader
+    sf::priv::PackedInstance packInstance(const sf::InstanceBuffer::Instance& instance)
+    {
+        const float* matrix = &instance.transform.getMatrix()[0];
+
+        sf::priv::PackedInstance packed;
+        packed.row0[0] = matrix[0];
+        packed.row0[1] = matrix[4];
+        packed.row0[2] = matrix[12];
+        packed.row1[0] = matrix[1];
+        packed.row1[1] = matrix[5];
+        packed.row1[2] = matrix[13];
+        packed.color[0] = instance.color.r;
+        packed.color[1] = instance.color.g;
+        packed.color[2] = instance.color.b;
+        packed.color[3] = instance.color.a;
+        packed.textureOffset[0] = instance.textureOffset.x;
+        packed.textureOffset[1] = instance.textureOffset.y;
+
+        return packed;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+InstanceBuffer::Instance::Instance() :
+transform    (),
+color        (Colors::White),
+textureOffset(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::Instance::Instance(const Transform& theTransform, const Color& theColor, const Vector2f& theTextureOffset) :
+transform    (theTransform),
+color        (theColor),
+textureOffset(theTextureOffset)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::InstanceBuffer(VertexBuffer::Usage usage) :
+m_instances (),
+m_usage     (usage),
+m_buffer    (0),
+m_bufferSize(0),
+m_needUpload(true),
+m_packed    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::InstanceBuffer(const InstanceBuffer& copy) :
+GlResource  (),
+m_instances (copy.m_instances),
+m_usage     (copy.m_usage),
+m_buffer    (0),
+m_bufferSize(0),
+m_needUpload(true),
+m_packed    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer::~InstanceBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+InstanceBuffer& InstanceBuffer::operator =(const InstanceBuffer& right)
+{
+    InstanceBuffer temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::swap(InstanceBuffer& right)
+{
+    std::swap(m_instances,  right.m_instances);
+    std::swap(m_usage,      right.m_usage);
+    std::swap(m_buffer,     right.m_buffer);
+    std::swap(m_bufferSize, right.m_bufferSize);
+    std::swap(m_needUpload, right.m_needUpload);
+    std::swap(m_packed,     right.m_packed);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t InstanceBuffer::getInstanceCount() const
+{
+    return m_instances.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::resize(std::size_t instanceCount)
+{
+    m_instances.resize(instanceCount);
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::clear()
+{
+    m_instances.clear();
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::append(const Instance& instance)
+{
+    m_instances.push_back(instance);
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::setInstance(std::size_t index, const Instance& instance)
+{
+    m_instances[index] = instance;
+    m_needUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const InstanceBuffer::Instance& InstanceBuffer::getInstance(std::size_t index) const
+{
+    return m_instances[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void InstanceBuffer::setUsage(VertexBuffer::Usage usage)
+{
+    m_usage = usage;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage InstanceBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceBuffer::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        if (!VertexBuffer::isAvailable() || !Shader::isAvailable())
+            return false;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstanceBuffer::ensureUpload() const
+{
+    if (!m_needUpload)
+        return true;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create instance buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    // The scratch memory keeps its capacity, so packing doesn't allocate after the first upload
+    std::size_t byteCount = sizeof(priv::PackedInstance) * m_instances.size();
+    m_packed.resize(byteCount);
+
+    priv::PackedInstance* packed = reinterpret_cast<priv::PackedInstance*>(m_packed.data());
+    for (std::size_t i = 0; i < m_instances.size(); ++i)
+        packed[i] = packInstance(m_instances[i]);
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Reallocate (or orphan) the storage only when the buffer grows
+    if (m_instances.size() > m_bufferSize)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, byteCount, packed, usageToGlEnum(m_usage)));
+        m_bufferSize = m_instances.size();
+    }
+    else if (byteCount > 0)
+    {
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, byteCount, packed));
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_needUpload = false;
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstancingShader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstddef>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+#endif
+
+namespace
+{
+    // Names of the instance attributes, in the order of InstancingShader::m_attributes
+    const char* const attributeNames[] = {"sf_instanceRow0", "sf_instanceRow1", "sf_instanceColor", "sf_instanceTextureOffset"};
+
+    // The instance transform applies to the XY plane, the depth of 3D meshes
+    // is kept. The texture coordinates are offset before the texture matrix
+    // normalizes them, so that the offset is expressed in pixels
+    const char vertexSource[] =
+        "attribute vec3 sf_instanceRow0;\n"
+        "attribute vec3 sf_instanceRow1;\n"
+        "attribute vec4 sf_instanceColor;\n"
+        "attribute vec2 sf_instanceTextureOffset;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 position = vec3(gl_Vertex.xy, 1.0);\n"
+        "    vec4 instancePosition = vec4(dot(sf_instanceRow0, position), dot(sf_instanceRow1, position), gl_Vertex.z, 1.0);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * instancePosition;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(gl_MultiTexCoord0.xy + sf_instanceTextureOffset, 0.0, 1.0);\n"
+        "    gl_FrontColor = gl_Color * sf_instanceColor;\n"
+        "}\n";
+
+    const char fragmentSource[] =
+        "uniform sampler2D sf_texture;\n"
+        "uniform float sf_textured;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 texel = texture2D(sf_texture, gl_TexCoord[0].xy);\n"
+        "    gl_FragColor = gl_Color * mix(vec4(1.0), texel, sf_textured);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InstancingShader::InstancingShader() :
+m_shader(),
+m_loaded(false),
+m_failed(false)
+{
+    for (int i = 0; i < 4; ++i)
+        m_attributes[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancingShader::bind(const Texture* texture, unsigned int instanceBuffer)
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_loaded)
+    {
+        // Don't retry on every draw if the compilation failed once
+        if (m_failed)
+            return false;
+
+        if (!m_shader.loadFromMemory(vertexSource, fragmentSource))
+        {
+            err() << "Failed to compile the instancing shader, instances will be expanded on the CPU" << std::endl;
+            m_failed = true;
+            return false;
+        }
+
+        for (int i = 0; i < 4; ++i)
+            glCheck(m_attributes[i] = GLEXT_glGetAttribLocation(castToGlHandle(m_shader.getNativeHandle()), attributeNames[i]));
+
+        m_shader.setUniform("sf_texture", Shader::CurrentTexture);
+        m_loaded = true;
+    }
+
+    m_shader.setUniform("sf_textured", texture ? 1.f : 0.f);
+    Shader::bind(&m_shader);
+
+    // Source the instance attributes, advancing once per instance
+    static const GLint       sizes[]      = {3, 3, 4, 2};
+    static const GLenum      types[]      = {GL_FLOAT, GL_FLOAT, GL_UNSIGNED_BYTE, GL_FLOAT};
+    static const GLboolean   normalized[] = {GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE};
+    static const std::size_t offsets[]    = {offsetof(PackedInstance, row0), offsetof(PackedInstance, row1),
+                                             offsetof(PackedInstance, color), offsetof(PackedInstance, textureOffset)};
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, instanceBuffer));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        if (m_attributes[i] < 0)
+            continue;
+
+        GLuint location = static_cast<GLuint>(m_attributes[i]);
+        glCheck(GLEXT_glEnableVertexAttribArray(location));
+        glCheck(GLEXT_glVertexAttribPointer(location, sizes[i], types[i], normalized[i], sizeof(PackedInstance), reinterpret_cast<const void*>(offsets[i])));
+        glCheck(GLEXT_glVertexAttribDivisor(location, 1));
+    }
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancingShader::unbind()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Restore the default divisor, other draws source attributes per vertex
+    for (int i = 0; i < 4; ++i)
+    {
+        if (m_attributes[i] < 0)
+            continue;
+
+        GLuint location = static_cast<GLuint>(m_attributes[i]);
+        glCheck(GLEXT_glVertexAttribDivisor(location, 0));
+        glCheck(GLEXT_glDisableVertexAttribArray(location));
+    }
+
+    Shader::bind(NULL);
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace priv
+
+} // namespace sf
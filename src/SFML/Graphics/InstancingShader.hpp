@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCINGSHADER_HPP
+#define SFML_INSTANCINGSHADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Layout of an instance in graphics memory
+///
+////////////////////////////////////////////////////////////
+struct PackedInstance
+{
+    float row0[3];          //!< First row of the affine transform
+    float row1[3];          //!< Second row of the affine transform
+    Uint8 color[4];         //!< Color modulating the vertices
+    float textureOffset[2]; //!< Offset added to the texture coordinates
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Built-in shader applying per-instance attributes
+///        to the vertices of an instanced draw
+///
+////////////////////////////////////////////////////////////
+class InstancingShader
+{
+    SFML_DISALLOW_COPY_MOVE(InstancingShader);
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The shader is compiled on first use.
+    ///
+    ////////////////////////////////////////////////////////////
+    InstancingShader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the shader and source the instance attributes
+    ///
+    /// The instance buffer must contain PackedInstance elements.
+    /// An OpenGL context must be active when calling this function.
+    ///
+    /// \param texture        Texture used by the draw, can be null
+    /// \param instanceBuffer OpenGL handle of the instance buffer
+    ///
+    /// \return True if the shader is ready for drawing, false if it could not be compiled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool bind(const Texture* texture, unsigned int instanceBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the shader and stop sourcing the instance attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader m_shader;        //!< Built-in shader program
+    bool   m_loaded;        //!< Was the shader compiled successfully?
+    bool   m_failed;        //!< Did the compilation fail?
+    int    m_attributes[4]; //!< Locations of the instance attributes
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCINGSHADER_HPP
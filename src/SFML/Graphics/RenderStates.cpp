@@ -41,55 +41,78 @@ const RenderStates RenderStates::Default(BlendMode(
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates() :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (NULL),
-pointSize(1.0f)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Transform& theTransform) :
-blendMode(BlendAlpha),
-transform(theTransform),
-texture  (NULL),
-shader   (NULL),
-pointSize(1.0f)
+blendMode   (BlendAlpha),
+transform   (theTransform),
+texture     (NULL),
+shader      (NULL),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode) :
-blendMode(theBlendMode),
-transform(),
-texture  (NULL),
-shader   (NULL),
-pointSize(1.0f)
+blendMode   (theBlendMode),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const DepthMode& theDepthMode) :
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (NULL),
+pointSize   (1.0f),
+depthMode   (theDepthMode),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Texture* theTexture) :
-blendMode(BlendAlpha),
-transform(),
-texture  (theTexture),
-shader   (NULL),
-pointSize(1.0f)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (theTexture),
+shader      (NULL),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Shader* theShader) :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (theShader),
-pointSize(1.0f)
+blendMode   (BlendAlpha),
+transform   (),
+texture     (NULL),
+shader      (theShader),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
 {
 }
 
@@ -97,11 +120,13 @@ pointSize(1.0f)
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                            const Texture* theTexture, const Shader* theShader) :
-blendMode(theBlendMode),
-transform(theTransform),
-texture  (theTexture),
-shader   (theShader),
-pointSize(1.0f)
+blendMode   (theBlendMode),
+transform   (theTransform),
+texture     (theTexture),
+shader      (theShader),
+pointSize   (1.0f),
+depthMode   (),
+textureArray(NULL)
 {
 }
 
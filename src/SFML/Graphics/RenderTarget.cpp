@@ -27,11 +27,17 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/InstanceBuffer.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/InstancingShader.hpp>
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/TextureArrayShader.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
@@ -142,6 +148,113 @@ namespace
 
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // Convert an sf::DepthMode::Function constant to the corresponding OpenGL constant.
+    sf::Uint32 depthFunctionToGlConstant(sf::DepthMode::Function depthFunction)
+    {
+        switch (depthFunction)
+        {
+            case sf::DepthMode::Never:        return GL_NEVER;
+            case sf::DepthMode::Less:         return GL_LESS;
+            case sf::DepthMode::LessEqual:    return GL_LEQUAL;
+            case sf::DepthMode::Equal:        return GL_EQUAL;
+            case sf::DepthMode::GreaterEqual: return GL_GEQUAL;
+            case sf::DepthMode::Greater:      return GL_GREATER;
+            case sf::DepthMode::NotEqual:     return GL_NOTEQUAL;
+            case sf::DepthMode::Always:       return GL_ALWAYS;
+        }
+
+        sf::err() << "Invalid value for sf::DepthMode::Function! Fallback to sf::DepthMode::Always." << std::endl;
+        assert(false);
+        return GL_ALWAYS;
+    }
+
+
+    // Get the primitive type a list of vertices is converted to by appendPrimitives
+    sf::PrimitiveType getListPrimitiveType(sf::PrimitiveType type)
+    {
+        // Strips, fans and quads are converted to independent primitives
+        if ((type == sf::Points) || (type == sf::Lines) || (type == sf::LineStrip))
+            return (type == sf::Points) ? sf::Points : sf::Lines;
+
+        return sf::Triangles;
+    }
+
+
+    // Pre-transform vertices and append them as a list of independent primitives
+    void appendPrimitives(std::vector<sf::Vertex>& target, const sf::Vertex* vertices, std::size_t vertexCount,
+                          sf::PrimitiveType type, const sf::Transform& transform)
+    {
+        std::size_t first = target.size();
+
+        switch (type)
+        {
+            case sf::Points:
+            case sf::Lines:
+            case sf::Triangles:
+            {
+                // Incomplete primitives would break the following ones, drop them
+                std::size_t verticesPerPrimitive = (type == sf::Points) ? 1 : ((type == sf::Lines) ? 2 : 3);
+                std::size_t count = vertexCount - vertexCount % verticesPerPrimitive;
+
+                for (std::size_t i = 0; i < count; ++i)
+                    target.push_back(vertices[i]);
+                break;
+            }
+
+            case sf::LineStrip:
+            {
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    target.push_back(vertices[i - 1]);
+                    target.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::TriangleStrip:
+            {
+                // Every other triangle of a strip has its winding reversed
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    target.push_back(vertices[(i % 2) ? i - 1 : i - 2]);
+                    target.push_back(vertices[(i % 2) ? i - 2 : i - 1]);
+                    target.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::TriangleFan:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    target.push_back(vertices[0]);
+                    target.push_back(vertices[i - 1]);
+                    target.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::Quads:
+            {
+                for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+                {
+                    target.push_back(vertices[i + 0]);
+                    target.push_back(vertices[i + 1]);
+                    target.push_back(vertices[i + 2]);
+                    target.push_back(vertices[i + 0]);
+                    target.push_back(vertices[i + 2]);
+                    target.push_back(vertices[i + 3]);
+                }
+                break;
+            }
+        }
+
+        // Transform all the appended vertices at once
+        if (target.size() > first)
+            transform.transformPoints(&target[first], &target[first], target.size() - first);
+    }
 }
 
 
@@ -149,31 +262,93 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      (),
-m_id         (0)
+m_defaultView       (),
+m_view              (),
+m_cache             (),
+m_batch             (),
+m_id                (0),
+m_streamBuffer      (NULL),
+m_instancingShader  (NULL),
+m_textureArrayShader(NULL),
+m_instanceMesh      (),
+m_instanceMeshId    (0),
+m_instanceVertices  ()
 {
     m_cache.glStatesSet = false;
+    m_batch.enabled = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_textureArrayShader;
+    delete m_instancingShader;
+    delete m_streamBuffer;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Pending draws must be rendered before they get cleared
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+
+        // The depth buffer is only cleared if depth writes are enabled,
+        // which is the case unless the last depth mode was read-only
+        bool depthMaskCleared = isDepthMaskCleared();
+        if (depthMaskCleared)
+            glCheck(glDepthMask(GL_TRUE));
+
         glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+        if (depthMaskCleared)
+            glCheck(glDepthMask(GL_FALSE));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::clearDepth(float depth)
+{
+    // Pending draws must be rendered before they get cleared
+    flush();
+
+    if (isActive(m_id) || setActive(true))
+    {
+#ifdef SFML_OPENGL_ES
+        glCheck(glClearDepthf(depth));
+#else
+        glCheck(glClearDepth(depth));
+#endif
+
+        // The depth buffer is only cleared if depth writes are enabled,
+        // which is the case unless the last depth mode was read-only
+        bool depthMaskCleared = isDepthMaskCleared();
+        if (depthMaskCleared)
+            glCheck(glDepthMask(GL_TRUE));
+
+        glCheck(glClear(GL_DEPTH_BUFFER_BIT));
+
+        if (depthMaskCleared)
+            glCheck(glDepthMask(GL_FALSE));
+
+        // Restore the default clear depth used by clear()
+        if (depth != 1.f)
+        {
+#ifdef SFML_OPENGL_ES
+            glCheck(glClearDepthf(1.f));
+#else
+            glCheck(glClearDepth(1.f));
+#endif
+        }
     }
 }
 
@@ -181,6 +356,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending draws were made with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -282,6 +460,22 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
+    if (m_batch.enabled)
+    {
+        if (batchVertices(vertices, vertexCount, type, states))
+            return;
+
+        // The draw can't be merged, render what was accumulated so far first
+        flush();
+    }
+
+    drawVertices(vertices, vertexCount, type, states);
+}
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
     if (isActive(m_id) || setActive(true))
     {
         // Check if the vertex count is low enough so that we can pre-transform them
@@ -290,13 +484,7 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            states.transform.transformPoints(vertices, m_cache.vertexCache, vertexCount);
         }
 
         setupDraw(useVertexCache, states);
@@ -313,13 +501,17 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 
         // If we switch between non-cache and cache mode or enable texture
         // coordinates we need to set up the pointers to the vertices' components
+        bool useStreamBuffer = false;
         if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
 
-            // If we pre-transform the vertices, we must use our internal vertex cache
+            // If we pre-transform the vertices, we must use our internal vertex cache,
+            // otherwise stream them to graphics memory instead of sourcing client memory
             if (useVertexCache)
                 data = reinterpret_cast<const char*>(m_cache.vertexCache);
+            else
+                useStreamBuffer = streamVertices(vertices, sizeof(Vertex) * vertexCount, data);
 
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
@@ -335,6 +527,11 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
 
         drawPrimitives(type, 0, vertexCount);
+
+        // The vertex cache is sourced from client memory, which requires no bound buffer
+        if (useStreamBuffer)
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
         cleanupDraw(states);
 
         // Update the cache
@@ -360,6 +557,9 @@ void RenderTarget::draw(const Vertex3D* vertices, std::size_t vertexCount,
         }
     #endif
 
+    // 3D vertices are never batched
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         // Check if the vertex count is low enough so that we can pre-transform them
@@ -368,13 +568,7 @@ void RenderTarget::draw(const Vertex3D* vertices, std::size_t vertexCount,
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex3D& vertex = m_cache.vertex3DCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            states.transform.transformPoints(vertices, m_cache.vertex3DCache, vertexCount);
         }
 
         setupDraw(useVertexCache, states);
@@ -391,13 +585,17 @@ void RenderTarget::draw(const Vertex3D* vertices, std::size_t vertexCount,
 
         // If we switch between non-cache and cache mode or enable texture
         // coordinates we need to set up the pointers to the vertices' components
+        bool useStreamBuffer = false;
         if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
 
-            // If we pre-transform the vertices, we must use our internal vertex cache
+            // If we pre-transform the vertices, we must use our internal vertex cache,
+            // otherwise stream them to graphics memory instead of sourcing client memory
             if (useVertexCache)
                 data = reinterpret_cast<const char*>(m_cache.vertex3DCache);
+            else
+                useStreamBuffer = streamVertices(vertices, sizeof(Vertex3D) * vertexCount, data);
 
             glCheck(glVertexPointer(3, GL_FLOAT, sizeof(Vertex3D), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex3D), data + 12));
@@ -413,6 +611,11 @@ void RenderTarget::draw(const Vertex3D* vertices, std::size_t vertexCount,
         }
 
         drawPrimitives(type, 0, vertexCount);
+
+        // The vertex cache is sourced from client memory, which requires no bound buffer
+        if (useStreamBuffer)
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
         cleanupDraw(states);
 
         // Update the cache
@@ -460,20 +663,15 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         }
     #endif
 
+    // Vertex buffers are never batched
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         setupDraw(false, states);
 
         // Bind vertex buffer
-        VertexBuffer::bind(&vertexBuffer);
-
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        bindVertexBuffer(vertexBuffer);
 
         drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
 
@@ -489,6 +687,194 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                        std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstIndex > indexBuffer.getIndexCount())
+        return;
+
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
+
+    // Nothing to draw?
+    if (!indexCount || !vertexBuffer.getVertexCount() || !vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Vertex buffers are never batched
+    flush();
+
+    if (isActive(m_id) || setActive(true))
+    {
+        setupDraw(false, states);
+
+        // Bind vertex and index buffers
+        bindVertexBuffer(vertexBuffer);
+        IndexBuffer::bind(&indexBuffer);
+
+        drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), indexBuffer, firstIndex, indexCount);
+
+        // Unbind vertex and index buffers
+        IndexBuffer::bind(NULL);
+        VertexBuffer::bind(NULL);
+
+        cleanupDraw(states);
+
+        // Update the cache
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
+{
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Nothing to draw?
+    if (!vertexBuffer.getVertexCount() || !vertexBuffer.getNativeHandle() || !instanceBuffer.getInstanceCount())
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    // Vertex buffers are never batched
+    flush();
+
+    if (!isActive(m_id) && !setActive(true))
+        return;
+
+    // User shaders don't know about the instance attributes, they get expanded instances
+    if (!states.shader && InstanceBuffer::isAvailable() && drawInstancedPrimitives(vertexBuffer, instanceBuffer, states))
+        return;
+
+#ifdef SFML_OPENGL_ES
+
+    err() << "Instanced rendering is not available, drawing skipped" << std::endl;
+
+#else
+
+    // Only 2D meshes can be expanded
+    if (vertexBuffer.getVertexLayout() != VertexBuffer::Layout2D)
+    {
+        err() << "Instanced rendering is not available for 3D vertex buffers, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Read the mesh back from graphics memory, only when its contents changed since
+    // the last expansion: reading a buffer stalls the pipeline until it is written
+    if (vertexBuffer.m_cacheId != m_instanceMeshId)
+    {
+        m_instanceMesh.resize(vertexBuffer.getVertexCount());
+        VertexBuffer::bind(&vertexBuffer);
+        glCheck(GLEXT_glGetBufferSubData(GLEXT_GL_ARRAY_BUFFER, 0, sizeof(Vertex) * m_instanceMesh.size(), &m_instanceMesh[0]));
+        VertexBuffer::bind(NULL);
+
+        m_instanceMeshId = vertexBuffer.m_cacheId;
+    }
+
+    // Expand the instances into a single list of pre-transformed primitives,
+    // keeping the allocated memory for the next draws
+    m_instanceVertices.clear();
+    for (std::size_t i = 0; i < instanceBuffer.getInstanceCount(); ++i)
+    {
+        const InstanceBuffer::Instance& instance = instanceBuffer.getInstance(i);
+        std::size_t first = m_instanceVertices.size();
+
+        appendPrimitives(m_instanceVertices, &m_instanceMesh[0], m_instanceMesh.size(), vertexBuffer.getPrimitiveType(), states.transform * instance.transform);
+
+        for (std::size_t j = first; j < m_instanceVertices.size(); ++j)
+        {
+            m_instanceVertices[j].color = m_instanceVertices[j].color * instance.color;
+            m_instanceVertices[j].texCoords += instance.textureOffset;
+        }
+    }
+
+    if (m_instanceVertices.empty())
+        return;
+
+    RenderStates expandedStates(states);
+    expandedStates.transform = Transform::Identity;
+
+    drawVertices(&m_instanceVertices[0], m_instanceVertices.size(), getListPrimitiveType(vertexBuffer.getPrimitiveType()), expandedStates);
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_batch.enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    // Nothing to draw?
+    if (m_batch.vertices.empty())
+        return;
+
+    // The batched vertices are already transformed
+    RenderStates states(m_batch.blendMode, Transform::Identity, m_batch.texture, NULL);
+    states.pointSize = m_batch.pointSize;
+    states.depthMode = m_batch.depthMode;
+    states.textureArray = m_batch.textureArray;
+
+    drawVertices(&m_batch.vertices[0], m_batch.vertices.size(), m_batch.type, states);
+
+    // Keep the allocated memory for the next batch
+    m_batch.vertices.clear();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTarget::setActive(bool active)
 {
@@ -532,6 +918,9 @@ bool RenderTarget::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    // Pending draws must not leak into the user's OpenGL code
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -564,6 +953,9 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    // Pending draws must be rendered with SFML's states
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         glCheck(glMatrixMode(GL_PROJECTION));
@@ -621,10 +1013,14 @@ void RenderTarget::resetGLStates()
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
+        applyDepthMode(DepthDisabled);
         applyTexture(NULL);
         if (shaderAvailable)
             applyShader(NULL);
 
+        // The texture array is rebound by the next draw that uses one
+        m_cache.lastTextureArrayId = 0;
+
         if (vertexBufferAvailable)
             glCheck(VertexBuffer::bind(NULL));
 
@@ -632,8 +1028,9 @@ void RenderTarget::resetGLStates()
 
         m_cache.useVertexCache = false;
 
-        // Set the default view
-        setView(getView());
+        // Apply the current view on next draw (don't go through
+        // setView, as it would flush the batch while we reset states)
+        m_cache.viewChanged = true;
 
         m_cache.enable = true;
     }
@@ -656,6 +1053,64 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    // Shader parameters may change between draws and render-texture
+    // attachments may be drawn to, so these draws can't be deferred
+    if (states.shader || (states.texture && states.texture->m_fboAttachment))
+        return false;
+
+    // Strips, fans and quads are merged as independent primitives
+    PrimitiveType batchType = getListPrimitiveType(type);
+
+    // Flush the current batch if the states are different
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    Uint64 textureArrayId = states.textureArray ? states.textureArray->m_cacheId : 0;
+    if (!m_batch.vertices.empty() && ((batchType != m_batch.type) ||
+                                      (textureId != m_batch.textureId) ||
+                                      (textureArrayId != m_batch.textureArrayId) ||
+                                      (states.blendMode != m_batch.blendMode) ||
+                                      (states.pointSize != m_batch.pointSize) ||
+                                      (states.depthMode != m_batch.depthMode)))
+    {
+        flush();
+    }
+
+    m_batch.type           = batchType;
+    m_batch.blendMode      = states.blendMode;
+    m_batch.texture        = states.texture;
+    m_batch.textureId      = textureId;
+    m_batch.textureArray   = states.textureArray;
+    m_batch.textureArrayId = textureArrayId;
+    m_batch.pointSize      = states.pointSize;
+    m_batch.depthMode      = states.depthMode;
+
+    // Pre-transform the vertices and convert them to a list of independent primitives
+    appendPrimitives(m_batch.vertices, vertices, vertexCount, type, states.transform);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::streamVertices(const void* vertices, std::size_t size, const char*& data)
+{
+    if (!m_streamBuffer)
+        m_streamBuffer = new priv::StreamBuffer;
+
+    std::size_t offset = 0;
+    if (!m_streamBuffer->append(vertices, size, offset))
+        return false;
+
+    // Pointers are offsets into the bound buffer
+    data = reinterpret_cast<const char*>(offset);
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -735,6 +1190,37 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::applyDepthMode(const DepthMode& mode)
+{
+    // Depth writes only happen while the depth test is enabled,
+    // so write-only modes use a test that always passes
+    if (mode.isEnabled())
+    {
+        glCheck(glEnable(GL_DEPTH_TEST));
+        glCheck(glDepthFunc(depthFunctionToGlConstant(mode.function)));
+    }
+    else
+    {
+        glCheck(glDisable(GL_DEPTH_TEST));
+    }
+
+    // The mask is only cleared for modes which test without writing; it is left
+    // enabled otherwise, so that depth clears done outside SFML keep working
+    glCheck(glDepthMask((mode.write || !mode.isEnabled()) ? GL_TRUE : GL_FALSE));
+
+    m_cache.lastDepthMode = mode;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isDepthMaskCleared() const
+{
+    // Until the GL states are set, the depth mask is whatever resetGLStates will apply
+    return m_cache.glStatesSet && m_cache.lastDepthMode.isEnabled() && !m_cache.lastDepthMode.write;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
@@ -793,6 +1279,10 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
         applyBlendMode(states.blendMode);
 
+    // Apply the depth mode
+    if (!m_cache.enable || (states.depthMode != m_cache.lastDepthMode))
+        applyDepthMode(states.depthMode);
+
     // Apply the texture
     if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
     {
@@ -811,9 +1301,54 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
             applyTexture(states.texture);
     }
 
-    // Apply the shader
+    // Apply the texture array
+    if (states.textureArray)
+    {
+        if (!m_cache.enable || (states.textureArray->m_cacheId != m_cache.lastTextureArrayId))
+        {
+            TextureArray::bind(states.textureArray);
+            m_cache.lastTextureArrayId = states.textureArray->m_cacheId;
+        }
+    }
+
+    // Apply the shader, texture arrays can only be sampled by shaders
+    // so they get the built-in one if no custom shader is given
     if (states.shader)
+    {
         applyShader(states.shader);
+    }
+    else if (states.textureArray)
+    {
+        if (!m_textureArrayShader)
+            m_textureArrayShader = new priv::TextureArrayShader;
+
+        applyShader(m_textureArrayShader->getShader(*states.textureArray));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::bindVertexBuffer(const VertexBuffer& vertexBuffer)
+{
+    VertexBuffer::bind(&vertexBuffer);
+
+    // Always enable texture coordinates
+    if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+
+    // Pointers are offsets into the bound buffer
+    if (vertexBuffer.getVertexLayout() == VertexBuffer::Layout3D)
+    {
+        glCheck(glVertexPointer(3, GL_FLOAT, sizeof(Vertex3D), reinterpret_cast<const void*>(0)));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex3D), reinterpret_cast<const void*>(12)));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex3D), reinterpret_cast<const void*>(16)));
+    }
+    else
+    {
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+    }
 }
 
 
@@ -830,11 +1365,71 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, s
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount)
+{
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
+
+    // Find the OpenGL index type, the offset of the first index is given in bytes
+    bool wideIndices = (indexBuffer.getIndexType() == IndexBuffer::Index32);
+    GLenum indexType = wideIndices ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    std::size_t offset = firstIndex * (wideIndices ? sizeof(Uint32) : sizeof(Uint16));
+
+    // Draw the primitives
+    glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), indexType, reinterpret_cast<const void*>(offset)));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::drawInstancedPrimitives(const VertexBuffer& vertexBuffer, const InstanceBuffer& instanceBuffer, const RenderStates& states)
+{
+    if (!instanceBuffer.ensureUpload())
+        return false;
+
+    if (!m_instancingShader)
+        m_instancingShader = new priv::InstancingShader;
+
+    setupDraw(false, states);
+
+    if (!m_instancingShader->bind(states.texture, instanceBuffer.m_buffer))
+    {
+        cleanupDraw(states);
+        return false;
+    }
+
+    // Bind vertex buffer
+    bindVertexBuffer(vertexBuffer);
+
+    // Find the OpenGL primitive type
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[vertexBuffer.getPrimitiveType()];
+
+    // Draw all the instances at once
+    glCheck(GLEXT_glDrawArraysInstanced(mode, 0, static_cast<GLsizei>(vertexBuffer.getVertexCount()), static_cast<GLsizei>(instanceBuffer.getInstanceCount())));
+
+    // Unbind vertex buffer and instance attributes
+    VertexBuffer::bind(NULL);
+    m_instancingShader->unbind();
+
+    cleanupDraw(states);
+
+    // Update the cache
+    m_cache.useVertexCache = false;
+    m_cache.texCoordsArrayEnabled = true;
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::cleanupDraw(const RenderStates& states)
 {
     // Unbind the shader, if any
-    if (states.shader)
+    if (states.shader || states.textureArray)
         applyShader(NULL);
 
     // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
@@ -870,6 +1465,10 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   whether any of the 6 blending components changed and,
 //   thus, whether we need to update the blend mode.
 //
+// * Depth mode
+//   Same as the blending mode: the test function and write
+//   mask are only sent to OpenGL when they change.
+//
 // * Texture
 //   Storing the pointer or OpenGL ID of the last used texture
 //   is not enough; if the sf::Texture instance is destroyed,
@@ -877,6 +1476,19 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   a new texture instance. We need to use our own unique
 //   identifier system to ensure consistent caching.
 //
+// * Batching
+//   When enabled, consecutive draws sharing the same texture,
+//   blend mode and point size are pre-transformed and merged
+//   into a single list of independent primitives, rendered
+//   with one draw call when the states change. Strips and fans
+//   are unrolled into lists so that they can be merged too.
+//
+// * Vertex streaming
+//   Vertices that are not pre-transformed are appended to a
+//   stream buffer in graphics memory, mapped without
+//   synchronization and orphaned when full, instead of having
+//   the driver copy them synchronously from client memory.
+//
 // * Shader
 //   Shaders are very hard to optimize, because they have
 //   parameters that can be hard (if not impossible) to track,
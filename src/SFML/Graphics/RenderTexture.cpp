@@ -160,6 +160,9 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Render the pending batch before updating the texture
+    flush();
+
     // Update the target texture
     if (m_impl && (priv::RenderTextureImplFBO::isAvailable() || setActive(true)))
     {
@@ -32,6 +32,7 @@
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <utility>
+#include <map>
 #include <set>
 
 
@@ -42,13 +43,14 @@ namespace
     // RenderTextureImplFBO is still alive
     std::set<std::map<sf::Uint64, unsigned int>*> frameBuffers;
 
-    // Set to track all stale FBOs
+    // Map to track all stale FBOs, by context
     // This is used to free stale FBOs after their owning
     // RenderTextureImplFBO has already been destroyed
     // An FBO cannot be destroyed until it's containing context
     // becomes active, so the destruction of the RenderTextureImplFBO
     // has to be decoupled from the destruction of the FBOs themselves
-    std::set<std::pair<sf::Uint64, unsigned int> > staleFrameBuffers;
+    typedef std::multimap<sf::Uint64, unsigned int> StaleFrameBuffers;
+    StaleFrameBuffers staleFrameBuffers;
 
     // Mutex to protect both active and stale frame buffer sets
     sf::Mutex mutex;
@@ -60,20 +62,16 @@ namespace
     {
         sf::Uint64 contextId = sf::Context::getActiveContextId();
 
-        for (std::set<std::pair<sf::Uint64, unsigned int> >::iterator iter = staleFrameBuffers.begin(); iter != staleFrameBuffers.end();)
-        {
-            if (iter->first == contextId)
-            {
-                GLuint frameBuffer = static_cast<GLuint>(iter->second);
-                glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        // Only visit the FBOs of the active context, the others can't be deleted yet
+        std::pair<StaleFrameBuffers::iterator, StaleFrameBuffers::iterator> range = staleFrameBuffers.equal_range(contextId);
 
-                staleFrameBuffers.erase(iter++);
-            }
-            else
-            {
-                ++iter;
-            }
+        for (StaleFrameBuffers::iterator iter = range.first; iter != range.second; ++iter)
+        {
+            GLuint frameBuffer = static_cast<GLuint>(iter->second);
+            glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
         }
+
+        staleFrameBuffers.erase(range.first, range.second);
     }
 
     // Callback that is called every time a context is destroyed
@@ -86,24 +84,37 @@ namespace
         // Destroy active frame buffer objects
         for (std::set<std::map<sf::Uint64, unsigned int>*>::iterator frameBuffersIter = frameBuffers.begin(); frameBuffersIter != frameBuffers.end(); ++frameBuffersIter)
         {
-            for (std::map<sf::Uint64, unsigned int>::iterator iter = (*frameBuffersIter)->begin(); iter != (*frameBuffersIter)->end(); ++iter)
-            {
-                if (iter->first == contextId)
-                {
-                    GLuint frameBuffer = static_cast<GLuint>(iter->second);
-                    glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+            std::map<sf::Uint64, unsigned int>::iterator iter = (*frameBuffersIter)->find(contextId);
 
-                    // Erase the entry from the RenderTextureImplFBO's map
-                    (*frameBuffersIter)->erase(iter);
+            if (iter != (*frameBuffersIter)->end())
+            {
+                GLuint frameBuffer = static_cast<GLuint>(iter->second);
+                glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
 
-                    break;
-                }
+                // Erase the entry from the RenderTextureImplFBO's map
+                (*frameBuffersIter)->erase(iter);
             }
         }
 
         // Destroy stale frame buffer objects
         destroyStaleFBOs();
     }
+
+    // Get the depth buffer format providing the requested precision
+    GLenum getDepthFormat(unsigned int depthBits)
+    {
+#ifndef SFML_OPENGL_ES
+
+        // 24 bits is the widest format guaranteed to be renderable
+        return (depthBits > 16) ? GL_DEPTH_COMPONENT24 : GL_DEPTH_COMPONENT16;
+
+#else
+
+        (void)depthBits;
+        return GLEXT_GL_DEPTH_COMPONENT;
+
+#endif
+    }
 }
 
 
@@ -120,7 +131,10 @@ m_height            (0),
 m_context           (NULL),
 m_textureId         (0),
 m_multisample       (false),
-m_stencil           (false)
+m_stencil           (false),
+m_cachedContextId   (0),
+m_cachedFrameBuffer (0),
+m_cachedMultisampleFrameBuffer(0)
 {
     Lock lock(mutex);
 
@@ -287,7 +301,7 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
                     return false;
                 }
                 glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthStencilBuffer));
-                glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+                glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, getDepthFormat(settings.depthBits), width, height));
             }
         }
         else
@@ -334,7 +348,7 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
                     return false;
                 }
                 glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthStencilBuffer));
-                glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, settings.antialiasingLevel, GLEXT_GL_DEPTH_COMPONENT, width, height));
+                glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, settings.antialiasingLevel, getDepthFormat(settings.depthBits), width, height));
             }
 
 #else
@@ -492,10 +506,50 @@ bool RenderTextureImplFBO::createFrameBuffer()
             // Insert the FBO into our map
             m_multisampleFrameBuffers.insert(std::make_pair(Context::getActiveContextId(), static_cast<unsigned int>(multisampleFrameBuffer)));
         }
+
+        m_cachedMultisampleFrameBuffer = static_cast<unsigned int>(multisampleFrameBuffer);
     }
 
 #endif
 
+    // Remember the FBOs of this context for the next activations
+    m_cachedContextId = Context::getActiveContextId();
+    m_cachedFrameBuffer = static_cast<unsigned int>(frameBuffer);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::findFrameBuffers(Uint64 contextId)
+{
+    // Fast path, the FBOs of this context were the last ones used
+    if (contextId == m_cachedContextId)
+        return true;
+
+    Lock lock(mutex);
+
+    std::map<Uint64, unsigned int>::iterator iter = m_frameBuffers.find(contextId);
+
+    if (iter == m_frameBuffers.end())
+        return false;
+
+    unsigned int multisampleFrameBuffer = 0;
+
+    if (m_multisample)
+    {
+        std::map<Uint64, unsigned int>::iterator multisampleIter = m_multisampleFrameBuffers.find(contextId);
+
+        if (multisampleIter == m_multisampleFrameBuffers.end())
+            return false;
+
+        multisampleFrameBuffer = multisampleIter->second;
+    }
+
+    m_cachedContextId = contextId;
+    m_cachedFrameBuffer = iter->second;
+    m_cachedMultisampleFrameBuffer = multisampleFrameBuffer;
+
     return true;
 }
 
@@ -531,38 +585,20 @@ bool RenderTextureImplFBO::activate(bool active)
         }
     }
 
-    // Lookup the FBO corresponding to the currently active context
-    // If none is found, there is no FBO corresponding to the
-    // currently active context so we will have to create a new FBO
+    // Most activations happen in the same context as the previous one,
+    // its FBOs are then known without locking the shared maps
+    // Context identifiers are never reused, and the context can't be
+    // destroyed by another thread while it is active in this one, so
+    // the cached FBOs are valid as long as the context is the same
+    if (findFrameBuffers(contextId))
     {
-        Lock lock(mutex);
-
-        std::map<Uint64, unsigned int>::iterator iter;
-        
-        if (m_multisample)
-        {
-            iter = m_multisampleFrameBuffers.find(contextId);
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_multisample ? m_cachedMultisampleFrameBuffer : m_cachedFrameBuffer));
 
-            if (iter != m_multisampleFrameBuffers.end())
-            {
-                glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, iter->second));
-
-                return true;
-            }
-        }
-        else
-        {
-            iter = m_frameBuffers.find(contextId);
-
-            if (iter != m_frameBuffers.end())
-            {
-                glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, iter->second));
-
-                return true;
-            }
-        }
+        return true;
     }
 
+    // There is no FBO corresponding to the currently
+    // active context so we will have to create a new FBO
     return createFrameBuffer();
 }
 
@@ -580,19 +616,13 @@ void RenderTextureImplFBO::updateTexture(unsigned int)
     // are already available within the current context
     if (m_multisample && m_width && m_height && activate(true))
     {
-        Uint64 contextId = Context::getActiveContextId();
-
-        Lock lock(mutex);
-
-        std::map<Uint64, unsigned int>::iterator iter = m_frameBuffers.find(contextId);
-        std::map<Uint64, unsigned int>::iterator multisampleIter = m_multisampleFrameBuffers.find(contextId);
-
-        if ((iter != m_frameBuffers.end()) && (multisampleIter != m_multisampleFrameBuffers.end()))
+        // activate() left the FBOs of the current context in the cache
+        if (m_cachedContextId == Context::getActiveContextId())
         {
             // Set up the blit target (draw framebuffer) and blit (from the read framebuffer, our multisample FBO)
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, iter->second));
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, m_cachedFrameBuffer));
             glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, multisampleIter->second));
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, m_cachedMultisampleFrameBuffer));
         }
     }
 
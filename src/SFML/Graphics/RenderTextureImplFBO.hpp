@@ -104,6 +104,19 @@ private:
     ////////////////////////////////////////////////////////////
     bool createFrameBuffer();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the FBOs of a context and make them the cached ones
+    ///
+    /// The shared maps are only searched, under lock, when
+    /// the context is not the one of the previous lookup.
+    ///
+    /// \param contextId Identifier of the context
+    ///
+    /// \return True if the FBOs of the context exist
+    ///
+    ////////////////////////////////////////////////////////////
+    bool findFrameBuffers(Uint64 contextId);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
     ///
@@ -125,16 +138,19 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::map<Uint64, unsigned int> m_frameBuffers;            //!< OpenGL frame buffer objects per context
-    std::map<Uint64, unsigned int> m_multisampleFrameBuffers; //!< Optional per-context OpenGL frame buffer objects with multisample attachments
-    unsigned int                   m_depthStencilBuffer;      //!< Optional depth/stencil buffer attached to the frame buffer
-    unsigned int                   m_colorBuffer;             //!< Optional multisample color buffer attached to the frame buffer
-    unsigned int                   m_width;                   //!< Width of the attachments
-    unsigned int                   m_height;                  //!< Height of the attachments
-    Context*                       m_context;                 //!< Backup OpenGL context, used when none already exist
-    unsigned int                   m_textureId;               //!< The ID of the texture to attach to the FBO
-    bool                           m_multisample;             //!< Whether we have to create a multisample frame buffer as well
-    bool                           m_stencil;                 //!< Whether we have stencil attachment
+    std::map<Uint64, unsigned int> m_frameBuffers;                 //!< OpenGL frame buffer objects per context
+    std::map<Uint64, unsigned int> m_multisampleFrameBuffers;      //!< Optional per-context OpenGL frame buffer objects with multisample attachments
+    unsigned int                   m_depthStencilBuffer;           //!< Optional depth/stencil buffer attached to the frame buffer
+    unsigned int                   m_colorBuffer;                  //!< Optional multisample color buffer attached to the frame buffer
+    unsigned int                   m_width;                        //!< Width of the attachments
+    unsigned int                   m_height;                       //!< Height of the attachments
+    Context*                       m_context;                      //!< Backup OpenGL context, used when none already exist
+    unsigned int                   m_textureId;                    //!< The ID of the texture to attach to the FBO
+    bool                           m_multisample;                  //!< Whether we have to create a multisample frame buffer as well
+    bool                           m_stencil;                      //!< Whether we have stencil attachment
+    Uint64                         m_cachedContextId;              //!< Context of the last FBO lookup
+    unsigned int                   m_cachedFrameBuffer;            //!< FBO of the cached context, with the texture attached
+    unsigned int                   m_cachedMultisampleFrameBuffer; //!< Multisample FBO of the cached context, if any
 };
 
 } // namespace priv
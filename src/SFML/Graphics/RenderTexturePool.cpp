@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Check whether two sets of settings create the same render texture attachments
+    bool haveSameAttachments(const sf::ContextSettings& left, const sf::ContextSettings& right)
+    {
+        return (left.depthBits == right.depthBits) &&
+               (left.stencilBits == right.stencilBits) &&
+               (left.antialiasingLevel == right.antialiasingLevel) &&
+               (left.sRgbCapable == right.sRgbCapable);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_entries()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    // Reuse a released render texture of the same size and settings
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (!it->inUse && (it->size == Vector2u(width, height)) && haveSameAttachments(it->settings, settings))
+        {
+            RenderTexture* renderTexture = it->renderTexture;
+
+            // Restore the state of a new render texture
+            renderTexture->setView(renderTexture->getDefaultView());
+            renderTexture->setSmooth(false);
+            renderTexture->setRepeated(false);
+
+            it->inUse = true;
+
+            return renderTexture;
+        }
+    }
+
+    // None is available, create a new one
+    RenderTexture* renderTexture = new RenderTexture;
+
+    if (!renderTexture->create(width, height, settings))
+    {
+        err() << "Failed to acquire render texture from pool" << std::endl;
+        delete renderTexture;
+        return NULL;
+    }
+
+    Entry entry;
+    entry.renderTexture = renderTexture;
+    entry.size          = Vector2u(width, height);
+    entry.settings      = settings;
+    entry.inUse         = true;
+    m_entries.push_back(entry);
+
+    return renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* renderTexture)
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->renderTexture == renderTexture)
+        {
+            it->inUse = false;
+            return;
+        }
+    }
+
+    err() << "Failed to release render texture, it doesn't belong to the pool" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::clear()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (!it->inUse)
+        {
+            delete it->renderTexture;
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getSize() const
+{
+    return m_entries.size();
+}
+
+} // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/ImageRequest.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 
@@ -98,6 +99,10 @@ bool RenderWindow::setActive(bool active)
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // Render the pending batch, so that it is part of the capture
+    // (drawing it doesn't change what the window logically contains)
+    const_cast<RenderWindow*>(this)->flush();
+
     Vector2u windowSize = getSize();
 
     Texture texture;
@@ -108,6 +113,50 @@ Image RenderWindow::capture() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderWindow::requestCapture(ImageRequest& request)
+{
+    // Render the pending batch, so that it is part of the capture
+    flush();
+
+    if (!setActive(true))
+        return false;
+
+    Vector2u windowSize = getSize();
+
+    // The rows of the back buffer are stored bottom to top
+    if (request.beginCopy(windowSize, windowSize.x, windowSize.y, true))
+    {
+        // The destination pointer is an offset into the bound pixel buffer
+        glCheck(glReadPixels(0, 0, static_cast<GLsizei>(windowSize.x), static_cast<GLsizei>(windowSize.y), GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+        request.endCopy();
+
+        return true;
+    }
+
+    // Asynchronous copies are not supported, copy the pixels right away
+    Texture texture;
+    if (!texture.create(windowSize.x, windowSize.y))
+        return false;
+
+    texture.update(*this);
+    request.setImage(texture.copyToImage());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    // Render the pending batch before the buffers are swapped
+    flush();
+
+    Window::display();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderWindow::onCreate()
 {
@@ -129,5 +178,4 @@ void RenderWindow::onResize()
     // Update the current view (recompute the viewport, which is stored in relative coordinates)
     setView(getView());
 }
-
 } // namespace sf
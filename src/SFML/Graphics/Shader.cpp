@@ -30,6 +30,8 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/DeferredUniformTable.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
@@ -38,6 +40,7 @@
 #include <SFML/System/Err.hpp>
 #include <fstream>
 #include <vector>
+#include <cstdio>
 
 
 #ifndef SFML_OPENGL_ES
@@ -58,6 +61,13 @@ namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
+    sf::Mutex cacheDirectoryMutex;
+
+    std::string cacheDirectory;
+
+    // Header of the files of the program cache
+    const sf::Uint32 programCacheMagic   = 0x42534653; // "SFSB"
+    const sf::Uint32 programCacheVersion = 1;
 
     GLint checkMaxTextureUnits()
     {
@@ -167,6 +177,185 @@ namespace
 
         return contiguous;
     }
+
+    // Hash a string into a running 64-bits FNV-1a hash
+    void hashString(sf::Uint64& hash, const char* string)
+    {
+        // The terminating zero is hashed too, so that the strings can't be shifted into each other
+        for (;; ++string)
+        {
+            hash ^= static_cast<sf::Uint8>(*string);
+            hash *= 0x100000001B3ull;
+
+            if (*string == '\0')
+                break;
+        }
+    }
+
+    // Get the path of the cache file of a program, or an empty string if the cache can't be used
+    std::string getProgramCachePath(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(cacheDirectoryMutex);
+            directory = cacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        // Binaries can only be retrieved if the driver supports at least one format
+        GLint formats = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        if (formats <= 0)
+            return "";
+
+        // Binaries are only valid for the driver that produced them, so it is part of the key
+        sf::Uint64 hash = 0xCBF29CE484222325ull;
+        hashString(hash, vertexShaderCode ? vertexShaderCode : "");
+        hashString(hash, geometryShaderCode ? geometryShaderCode : "");
+        hashString(hash, fragmentShaderCode ? fragmentShaderCode : "");
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hash));
+
+        char last = directory[directory.size() - 1];
+        if ((last != '/') && (last != '\\'))
+            directory += '/';
+
+        return directory + name;
+    }
+
+    // Create a program from the binary stored in a cache file, returns 0 if the file is missing or rejected
+    GLEXT_GLhandle loadProgramBinary(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return 0;
+
+        sf::Uint32 header[4] = {0, 0, 0, 0}; // magic, version, format, size
+        if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            (header[0] != programCacheMagic) || (header[1] != programCacheVersion) || (header[3] == 0))
+            return 0;
+
+        // Don't trust the size of the header before checking it against the file
+        std::streamoff begin = file.tellg();
+        if (!file.seekg(0, std::ios_base::end))
+            return 0;
+        std::streamoff end = file.tellg();
+        if ((begin < 0) || (end < begin) || (static_cast<sf::Uint64>(end - begin) < header[3]) || !file.seekg(begin))
+            return 0;
+
+        std::vector<char> binary(header[3]);
+        if (!file.read(&binary[0], static_cast<std::streamsize>(binary.size())))
+            return 0;
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), static_cast<GLenum>(header[2]), &binary[0], static_cast<GLsizei>(binary.size())));
+
+        // The driver rejects binaries that it can't use anymore (after an update for example)
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Write the binary of a linked program to a cache file
+    void saveProgramBinary(const std::string& path, GLEXT_GLhandle program)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetProgramiv(castFromGlHandle(program), GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, &written, &format, &binary[0]));
+        if (written <= 0)
+            return;
+
+        // Write to a temporary file first, so that a crash while writing can't leave a truncated entry behind
+        std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath.c_str(), std::ios_base::binary | std::ios_base::trunc);
+            if (!file)
+            {
+                sf::err() << "Failed to write shader cache file \"" << temporaryPath << "\"" << std::endl;
+                return;
+            }
+
+            sf::Uint32 header[4] = {programCacheMagic, programCacheVersion, static_cast<sf::Uint32>(format), static_cast<sf::Uint32>(written)};
+            file.write(reinterpret_cast<const char*>(header), sizeof(header));
+            file.write(&binary[0], written);
+            file.close();
+
+            if (!file)
+            {
+                sf::err() << "Failed to write shader cache file \"" << temporaryPath << "\"" << std::endl;
+                std::remove(temporaryPath.c_str());
+                return;
+            }
+        }
+
+        // Some platforms can't rename over an existing file
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+        {
+            std::remove(path.c_str());
+            if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+            {
+                sf::err() << "Failed to write shader cache file \"" << path << "\"" << std::endl;
+                std::remove(temporaryPath.c_str());
+            }
+        }
+    }
+
+    // Upload the values of a float uniform to the current program
+    void uploadUniform(GLint location, std::size_t components, std::size_t count, const float* values)
+    {
+        GLsizei size = static_cast<GLsizei>(count);
+        switch (components)
+        {
+            case 1:  glCheck(GLEXT_glUniform1fv(location, size, values));                  break;
+            case 2:  glCheck(GLEXT_glUniform2fv(location, size, values));                  break;
+            case 3:  glCheck(GLEXT_glUniform3fv(location, size, values));                  break;
+            case 4:  glCheck(GLEXT_glUniform4fv(location, size, values));                  break;
+            case 9:  glCheck(GLEXT_glUniformMatrix3fv(location, size, GL_FALSE, values)); break;
+            case 16: glCheck(GLEXT_glUniformMatrix4fv(location, size, GL_FALSE, values)); break;
+        }
+    }
+
+    // Upload the values of an integer uniform to the current program
+    void uploadUniform(GLint location, std::size_t components, std::size_t count, const int* values)
+    {
+        GLsizei size = static_cast<GLsizei>(count);
+        switch (components)
+        {
+            case 1: glCheck(GLEXT_glUniform1iv(location, size, values)); break;
+            case 2: glCheck(GLEXT_glUniform2iv(location, size, values)); break;
+            case 3: glCheck(GLEXT_glUniform3iv(location, size, values)); break;
+            case 4: glCheck(GLEXT_glUniform4iv(location, size, values)); break;
+        }
+    }
+
+    // Function object uploading deferred uniforms to the current program
+    struct UniformUploader
+    {
+        template <typename T>
+        void operator()(int location, std::size_t components, std::size_t count, const T* values) const
+        {
+            uploadUniform(location, components, count, values);
+        }
+    };
 }
 
 
@@ -186,10 +375,9 @@ public:
     /// \brief Constructor: set up state before uniform is set
     ///
     ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const std::string& name) :
+    explicit UniformBinder(Shader& shader) :
     savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
+    currentProgram(castToGlHandle(shader.m_shaderProgram))
     {
         if (currentProgram)
         {
@@ -197,9 +385,6 @@ public:
             glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
             if (currentProgram != savedProgram)
                 glCheck(GLEXT_glUseProgramObject(currentProgram));
-
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
         }
     }
 
@@ -217,16 +402,39 @@ public:
     TransientContextLock lock;           //!< Lock to keep context active while uniform is bound
     GLEXT_GLhandle       savedProgram;   //!< Handle to the previously active program object
     GLEXT_GLhandle       currentProgram; //!< Handle to the program object of the modified sf::Shader instance
-    GLint                location;       //!< Uniform location, used by the surrounding sf::Shader code
 };
 
 
+////////////////////////////////////////////////////////////
+Shader::Uniform::Uniform() :
+m_location(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Uniform::Uniform(int location) :
+m_location(location)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::Uniform::isValid() const
+{
+    return m_location != -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_uniforms      ()
+m_shaderProgram   (0),
+m_currentTexture  (-1),
+m_textures        (),
+m_uniforms        (),
+m_uniformsDeferred(false),
+m_deferredUniforms(new priv::DeferredUniformTable),
+m_uniformBlocks   ()
 {
 }
 
@@ -239,6 +447,8 @@ Shader::~Shader()
     // Destroy effect program
     if (m_shaderProgram)
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+
+    delete m_deferredUniforms;
 }
 
 
@@ -428,213 +638,363 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+    setUniform(getUniform(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+    setUniform(getUniform(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, bool x)
 {
-    setUniform(name, static_cast<int>(x));
+    setUniform(getUniform(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec2& v)
 {
-    setUniform(name, Glsl::Ivec2(v));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec3& v)
 {
-    setUniform(name, Glsl::Ivec3(v));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec4& v)
 {
-    setUniform(name, Glsl::Ivec4(v));
+    setUniform(getUniform(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniform(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniform(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Texture& texture)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
+    setUniform(getUniform(name), texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const std::string& name, CurrentTextureType)
+{
+    setUniform(getUniform(name), CurrentTexture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), scalarArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), vectorArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), vectorArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), vectorArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), matrixArray, length);
+}
+
 
-        // Find the location of the variable in the shader
-        int location = getUniformLocation(name);
-        if (location != -1)
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    setUniformArray(getUniform(name), matrixArray, length);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Uniform Shader::getUniform(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return Uniform();
+
+    // Check the cache first, OpenGL is only queried the first time
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
+        return Uniform(it->second);
+
+    TransientContextLock lock;
+
+    return Uniform(getUniformLocation(name));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, float x)
+{
+    setUniformValues(uniform.m_location, 1, 1, &x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec2& v)
+{
+    float values[] = {v.x, v.y};
+    setUniformValues(uniform.m_location, 2, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec3& v)
+{
+    float values[] = {v.x, v.y, v.z};
+    setUniformValues(uniform.m_location, 3, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec4& v)
+{
+    float values[] = {v.x, v.y, v.z, v.w};
+    setUniformValues(uniform.m_location, 4, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, int x)
+{
+    setUniformValues(uniform.m_location, 1, 1, &x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec2& v)
+{
+    int values[] = {v.x, v.y};
+    setUniformValues(uniform.m_location, 2, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec3& v)
+{
+    int values[] = {v.x, v.y, v.z};
+    setUniformValues(uniform.m_location, 3, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec4& v)
+{
+    int values[] = {v.x, v.y, v.z, v.w};
+    setUniformValues(uniform.m_location, 4, 1, values);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, bool x)
+{
+    setUniform(uniform, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec2& v)
+{
+    setUniform(uniform, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec3& v)
+{
+    setUniform(uniform, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec4& v)
+{
+    setUniform(uniform, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Mat3& matrix)
+{
+    setUniformValues(uniform.m_location, 3 * 3, 1, matrix.array);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Mat4& matrix)
+{
+    setUniformValues(uniform.m_location, 4 * 4, 1, matrix.array);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Texture& texture)
+{
+    if (m_shaderProgram && (uniform.m_location != -1))
+    {
+        // Store the location -> texture mapping
+        TextureTable::iterator it = m_textures.find(uniform.m_location);
+        if (it == m_textures.end())
         {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
+            TransientContextLock lock;
+
+            // New entry, make sure there are enough texture units
+            GLint maxUnits = getMaxTextureUnits();
+            if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
             {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                // Handles only hold the location, find the name for the message
+                std::string name;
+                for (UniformTable::const_iterator uniformIt = m_uniforms.begin(); uniformIt != m_uniforms.end(); ++uniformIt)
                 {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
+                    if (uniformIt->second == uniform.m_location)
+                    {
+                        name = uniformIt->first;
+                        break;
+                    }
                 }
 
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
+                err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
+                return;
             }
+
+            m_textures[uniform.m_location] = &texture;
+        }
+        else
+        {
+            // Location already used, just replace the texture
+            it->second = &texture;
         }
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniform(const std::string& name, CurrentTextureType)
+void Shader::setUniform(const Uniform& uniform, CurrentTextureType)
 {
     if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
-    }
+        m_currentTexture = uniform.m_location;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+    setUniformValues(uniform.m_location, 1, length, scalarArray);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec2* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformValues(uniform.m_location, 2, length, &contiguous[0]);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec3* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformValues(uniform.m_location, 3, length, &contiguous[0]);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec4* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformValues(uniform.m_location, 4, length, &contiguous[0]);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Mat3* matrixArray, std::size_t length)
 {
     const std::size_t matrixSize = 3 * 3;
 
@@ -642,14 +1002,12 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    setUniformValues(uniform.m_location, matrixSize, length, &contiguous[0]);
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length)
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Mat4* matrixArray, std::size_t length)
 {
     const std::size_t matrixSize = 4 * 4;
 
@@ -657,9 +1015,61 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    setUniformValues(uniform.m_location, matrixSize, length, &contiguous[0]);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const UniformBuffer& buffer)
+{
+    if (m_shaderProgram)
+    {
+        if (!UniformBuffer::isAvailable())
+        {
+            err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform buffers "
+                  << "(you should test UniformBuffer::isAvailable() before trying to use uniform blocks)" << std::endl;
+            return;
+        }
+
+        TransientContextLock lock;
+
+        // Find the index of the block in the shader
+        GLuint index = GLEXT_GL_INVALID_INDEX;
+        glCheck(index = GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+            return;
+        }
+
+        // Each block reads its buffer from the binding point matching its index
+        if (m_uniformBlocks.find(index) == m_uniformBlocks.end())
+            glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, index));
+
+        m_uniformBlocks[index] = &buffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformsDeferred(bool deferred)
+{
+    // Apply the values stored so far, the next immediate updates must not be overwritten by them
+    if (m_uniformsDeferred && !deferred && m_shaderProgram && m_deferredUniforms->hasPending())
+    {
+        UniformBinder binder(*this);
+        UniformUploader uploader;
+        m_deferredUniforms->upload(uploader);
+    }
+
+    m_uniformsDeferred = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::areUniformsDeferred() const
+{
+    return m_uniformsDeferred;
 }
 
 
@@ -758,9 +1168,15 @@ void Shader::bind(const Shader* shader)
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
+        // Upload the uniforms set since the last time the shader was used
+        shader->uploadDeferredUniforms();
+
         // Bind the textures
         shader->bindTextures();
 
+        // Bind the buffers of the uniform blocks
+        shader->bindUniformBlocks();
+
         // Bind the current texture
         if (shader->m_currentTexture != -1)
             glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
@@ -773,6 +1189,15 @@ void Shader::bind(const Shader* shader)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+    Lock lock(cacheDirectoryMutex);
+
+    cacheDirectory = directory;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::isAvailable()
 {
@@ -857,11 +1282,34 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_deferredUniforms->clear();
+    m_uniformBlocks.clear();
+
+    // Look for an already linked version of the program in the cache
+    std::string cachePath = getProgramCachePath(vertexShaderCode, geometryShaderCode, fragmentShaderCode);
+    if (!cachePath.empty())
+    {
+        GLEXT_GLhandle cachedProgram = loadProgramBinary(cachePath);
+        if (cachedProgram)
+        {
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+
+            // Force an OpenGL flush, so that the shader will appear updated
+            // in all contexts immediately (solves problems in multi-threaded apps)
+            glCheck(glFlush());
+
+            return true;
+        }
+    }
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
     glCheck(shaderProgram = GLEXT_glCreateProgramObject());
 
+    // Tell the driver that the binary will be retrieved, so that it keeps it
+    if (!cachePath.empty())
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
     // Create the vertex shader if needed
     if (vertexShaderCode)
     {
@@ -961,6 +1409,10 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         return false;
     }
 
+    // Store the linked program in the cache, for the next time
+    if (!cachePath.empty())
+        saveProgramBinary(cachePath, shaderProgram);
+
     m_shaderProgram = castFromGlHandle(shaderProgram);
 
     // Force an OpenGL flush, so that the shader will appear updated
@@ -989,6 +1441,66 @@ void Shader::bindTextures() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniformValues(int location, std::size_t components, std::size_t count, const float* values)
+{
+    if (!m_shaderProgram || (location == -1))
+        return;
+
+    if (m_uniformsDeferred)
+    {
+        // Store the values until the shader is bound
+        m_deferredUniforms->store(location, components, count, values);
+    }
+    else
+    {
+        // A value stored while uniforms were deferred must not overwrite this one
+        m_deferredUniforms->discard(location);
+
+        UniformBinder binder(*this);
+        uploadUniform(location, components, count, values);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformValues(int location, std::size_t components, std::size_t count, const int* values)
+{
+    if (!m_shaderProgram || (location == -1))
+        return;
+
+    if (m_uniformsDeferred)
+    {
+        // Store the values until the shader is bound
+        m_deferredUniforms->store(location, components, count, values);
+    }
+    else
+    {
+        // A value stored while uniforms were deferred must not overwrite this one
+        m_deferredUniforms->discard(location);
+
+        UniformBinder binder(*this);
+        uploadUniform(location, components, count, values);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::uploadDeferredUniforms() const
+{
+    UniformUploader uploader;
+    m_deferredUniforms->upload(uploader);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks() const
+{
+    for (UniformBlockTable::const_iterator it = m_uniformBlocks.begin(); it != m_uniformBlocks.end(); ++it)
+        glCheck(GLEXT_glBindBufferBase(GLEXT_GL_UNIFORM_BUFFER, it->first, it->second->getNativeHandle()));
+}
+
+
 ////////////////////////////////////////////////////////////
 int Shader::getUniformLocation(const std::string& name)
 {
@@ -1024,10 +1536,33 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
+////////////////////////////////////////////////////////////
+Shader::Uniform::Uniform() :
+m_location(-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::Uniform::Uniform(int location) :
+m_location(location)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::Uniform::isValid() const
+{
+    return m_location != -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1)
+m_shaderProgram   (0),
+m_currentTexture  (-1),
+m_uniformsDeferred(false),
+m_deferredUniforms(NULL)
 {
 }
 
@@ -1233,6 +1768,165 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::Uniform Shader::getUniform(const std::string& name)
+{
+    return Uniform();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const Uniform& uniform, CurrentTextureType)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const float* scalarArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const Uniform& uniform, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const UniformBuffer& buffer)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformsDeferred(bool deferred)
+{
+    m_uniformsDeferred = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::areUniformsDeferred() const
+{
+    return m_uniformsDeferred;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1306,6 +2000,12 @@ void Shader::bind(const Shader* shader)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setCacheDirectory(const std::string& directory)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::isAvailable()
 {
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker() :
+m_size   (0, 0),
+m_skyline()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker(const Vector2u& size) :
+m_size   (0, 0),
+m_skyline()
+{
+    reset(size);
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::reset(const Vector2u& size)
+{
+    m_size = size;
+    m_skyline.clear();
+
+    // Start with a flat skyline at the top of the area
+    if (size.x > 0)
+    {
+        Segment segment = {0, 0, size.x};
+        m_skyline.push_back(segment);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SkylinePacker::grow(const Vector2u& size)
+{
+    // The new columns are empty, extend the skyline over them at height 0
+    if (size.x > m_size.x)
+    {
+        if (!m_skyline.empty() && (m_skyline.back().y == 0))
+        {
+            m_skyline.back().width += size.x - m_size.x;
+        }
+        else
+        {
+            Segment segment = {m_size.x, 0, size.x - m_size.x};
+            m_skyline.push_back(segment);
+        }
+    }
+
+    m_size.x = std::max(m_size.x, size.x);
+    m_size.y = std::max(m_size.y, size.y);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insert(const Vector2u& size, Vector2u& position)
+{
+    if ((size.x == 0) || (size.y == 0))
+        return false;
+
+    // Find the segment where the rectangle's bottom is the lowest, break
+    // ties with the narrowest segment to keep wide gaps for wide rectangles
+    std::size_t  bestIndex  = m_skyline.size();
+    unsigned int bestBottom = 0;
+    unsigned int bestWidth  = 0;
+    unsigned int bestY      = 0;
+
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        unsigned int y = 0;
+        if (!fit(i, size, y))
+            continue;
+
+        unsigned int bottom = y + size.y;
+        if ((bestIndex == m_skyline.size()) || (bottom < bestBottom) ||
+            ((bottom == bestBottom) && (m_skyline[i].width < bestWidth)))
+        {
+            bestIndex  = i;
+            bestBottom = bottom;
+            bestWidth  = m_skyline[i].width;
+            bestY      = y;
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    position = Vector2u(m_skyline[bestIndex].x, bestY);
+
+    // Raise the skyline over the rectangle
+    Segment segment = {position.x, bestBottom, size.x};
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), segment);
+
+    // Shrink or remove the segments now hidden by the rectangle
+    unsigned int right = position.x + size.x;
+    std::size_t i = bestIndex + 1;
+    while ((i < m_skyline.size()) && (m_skyline[i].x < right))
+    {
+        unsigned int segmentRight = m_skyline[i].x + m_skyline[i].width;
+        if (segmentRight <= right)
+        {
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        else
+        {
+            m_skyline[i].width = segmentRight - right;
+            m_skyline[i].x = right;
+            break;
+        }
+    }
+
+    // Merge neighbour segments of the same height
+    for (std::size_t j = 1; j < m_skyline.size();)
+    {
+        if (m_skyline[j - 1].y == m_skyline[j].y)
+        {
+            m_skyline[j - 1].width += m_skyline[j].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(j));
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& SkylinePacker::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SkylinePacker::getUsedHeight() const
+{
+    unsigned int height = 0;
+    for (std::size_t i = 0; i < m_skyline.size(); ++i)
+        height = std::max(height, m_skyline[i].y);
+
+    return height;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::fit(std::size_t index, const Vector2u& size, unsigned int& y) const
+{
+    unsigned int x = m_skyline[index].x;
+    if (x + size.x > m_size.x)
+        return false;
+
+    // The rectangle rests on the highest segment it spans
+    y = 0;
+    unsigned int remaining = size.x;
+    for (std::size_t i = index; remaining > 0; ++i)
+    {
+        y = std::max(y, m_skyline[i].y);
+        if (y + size.y > m_size.y)
+            return false;
+
+        remaining -= std::min(remaining, m_skyline[i].width);
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
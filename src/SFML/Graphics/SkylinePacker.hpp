@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SKYLINEPACKER_HPP
+#define SFML_SKYLINEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Rectangle packer using the skyline bottom-left heuristic
+///
+/// The packer keeps track of the top edge ("skyline") of the
+/// rectangles packed so far, as a list of horizontal segments.
+/// A new rectangle is placed on the segment where its top ends
+/// up the lowest, which keeps the packing dense for rectangles
+/// of similar heights such as glyphs or sprites, while costing
+/// only a scan of the skyline per insertion.
+///
+/// The space below the skyline that is not covered by packed
+/// rectangles is lost: rectangles can't be removed individually,
+/// only all at once with reset().
+///
+////////////////////////////////////////////////////////////
+class SkylinePacker
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a packer with an empty area.
+    ///
+    ////////////////////////////////////////////////////////////
+    SkylinePacker();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a packer for an area of the given size
+    ///
+    /// \param size Size of the area to pack rectangles into
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SkylinePacker(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the packed rectangles and change the size of the area
+    ///
+    /// \param size New size of the area to pack rectangles into
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enlarge the area, keeping the packed rectangles
+    ///
+    /// \param size New size of the area, must not be smaller than the current one
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle and reserve it
+    ///
+    /// \param size     Size of the rectangle to pack
+    /// \param position Receives the top-left corner of the reserved room
+    ///
+    /// \return True if the rectangle was packed, false if it doesn't fit in the area
+    ///
+    ////////////////////////////////////////////////////////////
+    bool insert(const Vector2u& size, Vector2u& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area
+    ///
+    /// \return Size of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the height of the highest point of the skyline
+    ///
+    /// \return Height of the area used by the packed rectangles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUsedHeight() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        unsigned int x;     //!< Left of the segment
+        unsigned int y;     //!< Height of the skyline over the segment
+        unsigned int width; //!< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the lowest position of a rectangle starting at a segment
+    ///
+    /// \param index Index of the segment the rectangle starts at
+    /// \param size  Size of the rectangle
+    /// \param y     Receives the top of the rectangle
+    ///
+    /// \return True if the rectangle fits, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool fit(std::size_t index, const Vector2u& size, unsigned int& y) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u             m_size;    //!< Size of the area
+    std::vector<Segment> m_skyline; //!< Segments of the skyline, from left to right
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SKYLINEPACKER_HPP
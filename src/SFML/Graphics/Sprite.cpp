@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <cstdlib>
 
@@ -35,16 +36,20 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sprite::Sprite() :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_layer       (0),
+m_textureRect ()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture) :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_layer       (0),
+m_textureRect ()
 {
     setTexture(texture, true);
 }
@@ -52,8 +57,10 @@ m_textureRect()
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture, const IntRect& rectangle) :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_layer       (0),
+m_textureRect ()
 {
     // Compute the texture area
     setTextureRect(rectangle);
@@ -62,18 +69,77 @@ m_textureRect()
 }
 
 
+////////////////////////////////////////////////////////////
+Sprite::Sprite(const TextureArray& textureArray, unsigned int layer) :
+m_texture     (NULL),
+m_textureArray(NULL),
+m_layer       (0),
+m_textureRect ()
+{
+    setTexture(textureArray, layer, true);
+}
+
+
+////////////////////////////////////////////////////////////
+Sprite::Sprite(const TextureArray& textureArray, unsigned int layer, const IntRect& rectangle) :
+m_texture     (NULL),
+m_textureArray(NULL),
+m_layer       (0),
+m_textureRect ()
+{
+    // Compute the texture area
+    setTextureRect(rectangle);
+    // Assign texture array
+    setTexture(textureArray, layer, false);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sprite::setTexture(const Texture& texture, bool resetRect)
 {
     // Recompute the texture area if requested, or if there was no valid texture & rect before
-    if (resetRect || (!m_texture && (m_textureRect == sf::IntRect())))
+    if (resetRect || (!m_texture && !m_textureArray && (m_textureRect == sf::IntRect())))
     {
         Vector2u size = texture.getSize();
         setTextureRect(IntRect(0, 0, size.x, size.y));
     }
 
+    // Drop the layer offset of the previous texture array, if any
+    bool hadTextureArray = (m_textureArray != NULL);
+
     // Assign the new texture
     m_texture = &texture;
+    m_textureArray = NULL;
+    m_layer = 0;
+
+    if (hadTextureArray)
+        updateTexCoords();
+}
+
+
+////////////////////////////////////////////////////////////
+void Sprite::setTexture(const TextureArray& textureArray, unsigned int layer, bool resetRect)
+{
+    // Assign the new texture array first, the texture coordinates depend on it
+    bool hadSource = m_texture || m_textureArray;
+    m_texture = NULL;
+    m_textureArray = &textureArray;
+    m_layer = layer;
+
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (resetRect || (!hadSource && (m_textureRect == sf::IntRect())))
+    {
+        Vector2u size = textureArray.getSize();
+        IntRect rectangle(0, 0, size.x, size.y);
+
+        if (rectangle != m_textureRect)
+        {
+            m_textureRect = rectangle;
+            updatePositions();
+        }
+    }
+
+    updateTexCoords();
 }
 
 
@@ -107,6 +173,20 @@ const Texture* Sprite::getTexture() const
 }
 
 
+////////////////////////////////////////////////////////////
+const TextureArray* Sprite::getTextureArray() const
+{
+    return m_textureArray;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sprite::getLayer() const
+{
+    return m_layer;
+}
+
+
 ////////////////////////////////////////////////////////////
 const IntRect& Sprite::getTextureRect() const
 {
@@ -147,6 +227,13 @@ void Sprite::draw(RenderTarget& target, RenderStates states) const
         states.texture = m_texture;
         target.draw(m_vertices, 4, TriangleStrip, states);
     }
+    else if (m_textureArray)
+    {
+        states.transform *= getTransform();
+        states.texture = NULL;
+        states.textureArray = m_textureArray;
+        target.draw(m_vertices, 4, TriangleStrip, states);
+    }
 }
 
 
@@ -168,6 +255,11 @@ void Sprite::updateTexCoords()
     float left   = static_cast<float>(m_textureRect.left);
     float right  = left + m_textureRect.width;
     float top    = static_cast<float>(m_textureRect.top);
+
+    // Layers of texture arrays are addressed as if they were stacked vertically
+    if (m_textureArray)
+        top += m_textureArray->getLayerOffset(m_layer).y;
+
     float bottom = top + m_textureRect.height;
 
     m_vertices[0].texCoords = Vector2f(left, top);
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Smallest storage allocated, large enough to hold a few thousand vertices
+    const std::size_t minimumCapacity = 1024 * 1024;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+StreamBuffer::StreamBuffer() :
+m_buffer  (0),
+m_capacity(0),
+m_offset  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+StreamBuffer::~StreamBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamBuffer::append(const void* data, std::size_t size, std::size_t& offset)
+{
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_vertex_buffer_object)
+        return false;
+
+    if (!m_buffer)
+    {
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+        if (!m_buffer)
+        {
+            err() << "Could not create stream buffer, generation failed" << std::endl;
+            return false;
+        }
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    // Grow the storage if the data doesn't fit, or orphan it and
+    // start over if we reached its end; the driver keeps the old
+    // storage alive until the draws that source it are complete
+    if (size > m_capacity)
+    {
+        m_capacity = std::max(std::max(size, m_capacity * 2), minimumCapacity);
+        m_offset = 0;
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_capacity), NULL, GLEXT_GL_STREAM_DRAW));
+    }
+    else if (m_offset + size > m_capacity)
+    {
+        m_offset = 0;
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_capacity), NULL, GLEXT_GL_STREAM_DRAW));
+    }
+
+    // The range we write to is never sourced by pending draws, so
+    // it can be mapped without synchronizing with the GPU
+    void* destination = NULL;
+
+    if (GLEXT_map_buffer_range)
+    {
+        glCheck(destination = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, static_cast<GLintptr>(m_offset), static_cast<GLsizeiptr>(size),
+                                                     GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT | GLEXT_GL_MAP_UNSYNCHRONIZED_BIT));
+    }
+
+    if (destination)
+    {
+        std::memcpy(destination, data, size);
+
+        GLboolean result = GL_FALSE;
+        glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+        // The contents got corrupted (e.g. screen mode change), upload them again
+        if (result == GL_FALSE)
+            destination = NULL;
+    }
+
+    if (!destination)
+    {
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLintptr>(m_offset), static_cast<GLsizeiptr>(size), data));
+    }
+
+    offset = m_offset;
+
+    // Keep the next write aligned on 16 bytes
+    m_offset += (size + 15) & ~static_cast<std::size_t>(15);
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMBUFFER_HPP
+#define SFML_STREAMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Ring of graphics memory used to stream vertex
+///        data that changes on every draw
+///
+////////////////////////////////////////////////////////////
+class StreamBuffer : GlResource
+{
+    SFML_DISALLOW_COPY_MOVE(StreamBuffer);
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append data to the buffer
+    ///
+    /// The data is written right after the data appended by the
+    /// previous call. When the end of the buffer is reached, its
+    /// storage is orphaned so that the driver can hand out a fresh
+    /// one without waiting for pending draws to complete, and
+    /// writing starts over at the beginning.
+    ///
+    /// On success, the buffer is left bound to GL_ARRAY_BUFFER
+    /// so that the data can be sourced right away. The caller is
+    /// responsible for unbinding it when it is done drawing.
+    ///
+    /// An OpenGL context must be active when calling this function.
+    ///
+    /// \param data   Pointer to the data to copy
+    /// \param size   Size of the data, in bytes
+    /// \param offset Receives the offset of the data in the buffer, in bytes
+    ///
+    /// \return True if the data was appended, false if vertex buffers are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool append(const void* data, std::size_t size, std::size_t& offset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;   //!< Internal buffer identifier
+    std::size_t  m_capacity; //!< Size of the buffer storage, in bytes
+    std::size_t  m_offset;   //!< Offset at which the next data will be written, in bytes
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMBUFFER_HPP
@@ -28,30 +28,34 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/DistanceFieldShader.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 namespace
 {
-    // Add an underline or strikethrough line to the vertex array
-    void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
+    // Add an underline or strikethrough line to the vertex array, and grow the vertical range covered by the geometry
+    void addLine(std::vector<sf::Vertex>& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float& minY, float& maxY, float outlineThickness = 0)
     {
         float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
         float bottom = top + std::floor(thickness + 0.5f);
 
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        minY = std::min(minY, std::min(top - outlineThickness, bottom + outlineThickness));
+        maxY = std::max(maxY, std::max(top - outlineThickness, bottom + outlineThickness));
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
     }
 
     // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
+    void addGlyphQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0, float padding = 1)
     {
-        float padding = 1.0;
-
         float left   = glyph.bounds.left - padding;
         float top    = glyph.bounds.top - padding;
         float right  = glyph.bounds.left + glyph.bounds.width + padding;
@@ -62,12 +66,46 @@ namespace
         float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
         float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height) + padding;
 
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Get a glyph of the font, from the distance field in distance field mode
+    const sf::Glyph& getGlyph(const sf::Font& font, sf::Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness = 0)
+    {
+        if (font.isDistanceField())
+            return font.getDistanceFieldGlyph(codePoint, bold);
+        else
+            return font.getGlyph(codePoint, characterSize, bold, outlineThickness);
+    }
+
+    // Get the character size at which the geometry of a text is computed
+    unsigned int getLayoutSize(const sf::Font& font, unsigned int characterSize)
+    {
+        // Distance field glyphs have a single size, the geometry is scaled afterwards
+        return font.isDistanceField() ? sf::Font::DistanceFieldSize : characterSize;
+    }
+
+    // Get the distance between the baselines of two lines, at the character size of the text
+    float getLineDistance(const sf::Font& font, unsigned int characterSize, float spacingFactor)
+    {
+        unsigned int layoutSize = getLayoutSize(font, characterSize);
+        float scale = static_cast<float>(characterSize) / static_cast<float>(layoutSize);
+
+        return font.getLineSpacing(layoutSize) * spacingFactor * scale;
+    }
+
+    // Convert an outline thickness to distance field pixels, within the range that the field covers
+    float getDistanceFieldOutline(float outlineThickness, unsigned int characterSize)
+    {
+        float spread = static_cast<float>(sf::Font::DistanceFieldSpread);
+        float thickness = outlineThickness * static_cast<float>(sf::Font::DistanceFieldSize) / static_cast<float>(characterSize);
+
+        return std::max(-spread, std::min(spread, thickness));
     }
 }
 
@@ -85,9 +123,14 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
-m_vertices           (Triangles),
-m_outlineVertices    (Triangles),
+m_vertices           (),
+m_outlineVertices    (),
+m_lines              (),
 m_bounds             (),
+m_boundsMin          (),
+m_boundsMax          (),
+m_lineTop            (0),
+m_lineBottom         (0),
 m_geometryNeedUpdate (false),
 m_fontTextureId      (0)
 {
@@ -106,9 +149,14 @@ m_style              (Regular),
 m_fillColor          (255, 255, 255),
 m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
-m_vertices           (Triangles),
-m_outlineVertices    (Triangles),
+m_vertices           (),
+m_outlineVertices    (),
+m_lines              (),
 m_bounds             (),
+m_boundsMin          (),
+m_boundsMax          (),
+m_lineTop            (0),
+m_lineBottom         (0),
 m_geometryNeedUpdate (true),
 m_fontTextureId      (0)
 {
@@ -121,8 +169,65 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Only the characters between the common prefix and suffix of both strings have changed
+        std::size_t oldSize = m_string.getSize();
+        std::size_t newSize = string.getSize();
+
+        std::size_t prefix = 0;
+        while ((prefix < oldSize) && (prefix < newSize) && (m_string[prefix] == string[prefix]))
+            ++prefix;
+
+        std::size_t suffix = 0;
+        while ((suffix < oldSize - prefix) && (suffix < newSize - prefix) && (m_string[oldSize - suffix - 1] == string[newSize - suffix - 1]))
+            ++suffix;
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+        updateLines(prefix, oldSize - prefix - suffix, newSize - prefix - suffix);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::appendString(const String& string)
+{
+    if (!string.isEmpty())
+    {
+        std::size_t position = m_string.getSize();
+
+        m_string += string;
+        updateLines(position, 0, string.getSize());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::insertString(std::size_t position, const String& string)
+{
+    // Adjust the position if it's out of range
+    if (position > m_string.getSize())
+        position = m_string.getSize();
+
+    if (!string.isEmpty())
+    {
+        m_string.insert(position, string);
+        updateLines(position, 0, string.getSize());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::eraseString(std::size_t position, std::size_t count)
+{
+    // Adjust the range if it's out of range
+    if (position > m_string.getSize())
+        position = m_string.getSize();
+    if (count > m_string.getSize() - position)
+        count = m_string.getSize() - position;
+
+    if (count > 0)
+    {
+        m_string.erase(position, count);
+        updateLines(position, count, 0);
     }
 }
 
@@ -200,7 +305,7 @@ void Text::setFillColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+            for (std::size_t i = 0; i < m_vertices.size(); ++i)
                 m_vertices[i].color = m_fillColor;
         }
     }
@@ -218,7 +323,7 @@ void Text::setOutlineColor(const Color& color)
         // (if geometry is updated anyway, we can skip this step)
         if (!m_geometryNeedUpdate)
         {
-            for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+            for (std::size_t i = 0; i < m_outlineVertices.size(); ++i)
                 m_outlineVertices[i].color = m_outlineColor;
         }
     }
@@ -317,22 +422,27 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (index > m_string.getSize())
         index = m_string.getSize();
 
+    // Find the line containing the character
+    ensureGeometryUpdate();
+    std::size_t lineIndex = findLine(index);
+
     // Precompute the variables needed by the algorithm
+    unsigned int characterSize = getLayoutSize(*m_font, m_characterSize);
     bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = getGlyph(*m_font, L' ', characterSize, isBold).advance;
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+    float lineSpacing     = m_font->getLineSpacing(characterSize) * m_lineSpacingFactor;
 
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
+    // Compute the position, from the beginning of the line
+    Vector2f position(0.f, static_cast<float>(lineIndex) * lineSpacing);
+    Uint32 prevChar = (lineIndex > 0) ? L'\n' : 0;
+    for (std::size_t i = m_lines[lineIndex].first; i < index; ++i)
     {
         Uint32 curChar = m_string[i];
 
         // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        position.x += m_font->getKerning(prevChar, curChar, characterSize, isBold);
         prevChar = curChar;
 
         // Handle special characters
@@ -344,9 +454,12 @@ Vector2f Text::findCharacterPos(std::size_t index) const
         }
 
         // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+        position.x += getGlyph(*m_font, curChar, characterSize, isBold).advance + letterSpacing;
     }
 
+    // Scale the position computed on distance field glyphs to the character size
+    position *= static_cast<float>(m_characterSize) / static_cast<float>(characterSize);
+
     // Transform the position to global coordinates
     position = getTransform().transformPoint(position);
 
@@ -378,13 +491,56 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
 
-        // Only draw the outline if there is something to draw
-        if (m_outlineThickness != 0)
-            target.draw(m_outlineVertices, states);
+        // Only draw the lines inside the view
+        std::size_t beginLine;
+        std::size_t endLine;
+        findVisibleLines(target, states.transform, beginLine, endLine);
+        if (beginLine == endLine)
+            return;
+
+        std::size_t vertexBegin  = m_lines[beginLine].vertexOffset;
+        std::size_t vertexEnd    = (endLine < m_lines.size()) ? m_lines[endLine].vertexOffset : m_vertices.size();
+        std::size_t outlineBegin = m_lines[beginLine].outlineVertexOffset;
+        std::size_t outlineEnd   = (endLine < m_lines.size()) ? m_lines[endLine].outlineVertexOffset : m_outlineVertices.size();
 
-        target.draw(m_vertices, states);
+        const Vertex* vertices        = m_vertices.data() + vertexBegin;
+        const Vertex* outlineVertices = m_outlineVertices.data() + outlineBegin;
+
+        if (m_font->isDistanceField())
+        {
+            states.texture = &m_font->getDistanceFieldTexture();
+
+            // Use the built-in distance field shader, unless a custom shader is provided
+            priv::DistanceFieldShader* shader = states.shader ? NULL : &m_font->getDistanceFieldShader();
+
+            // The outline is the glyph thickened by lowering the distance threshold
+            if (m_outlineThickness != 0)
+            {
+                if (shader)
+                {
+                    float thickness = getDistanceFieldOutline(m_outlineThickness, m_characterSize);
+                    states.shader = shader->getShader(0.5f - thickness / static_cast<float>(2 * Font::DistanceFieldSpread));
+                }
+
+                target.draw(outlineVertices, outlineEnd - outlineBegin, Triangles, states);
+            }
+
+            if (shader)
+                states.shader = shader->getShader(0.5f);
+
+            target.draw(vertices, vertexEnd - vertexBegin, Triangles, states);
+        }
+        else
+        {
+            states.texture = &m_font->getTexture(m_characterSize);
+
+            // Only draw the outline if there is something to draw
+            if (m_outlineThickness != 0)
+                target.draw(outlineVertices, outlineEnd - outlineBegin, Triangles, states);
+
+            target.draw(vertices, vertexEnd - vertexBegin, Triangles, states);
+        }
     }
 }
 
@@ -395,54 +551,213 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
+    // Distance field glyphs are in their own texture
+    const Texture& fontTexture = m_font->isDistanceField() ? m_font->getDistanceFieldTexture() : m_font->getTexture(m_characterSize);
+
     // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    if (!m_geometryNeedUpdate && fontTexture.m_cacheId == m_fontTextureId)
         return;
 
     // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    m_fontTextureId = fontTexture.m_cacheId;
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
 
-    // Clear the previous geometry
+    // Loading the glyphs of the text must not evict the ones it already uses
+    m_font->pinRequestedGlyphs(m_characterSize, true);
+
+    // Compute the whole geometry, one line after the other
     m_vertices.clear();
     m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    m_lines.clear();
 
-    // No text: nothing to draw
-    if (m_string.isEmpty())
+    layoutLines(0, m_string.getSize(), 0, m_vertices, m_outlineVertices, m_lines);
+
+    m_font->pinRequestedGlyphs(m_characterSize, false);
+
+    updateBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateLines(std::size_t position, std::size_t erased, std::size_t inserted)
+{
+    // The lines can only be updated in place if the rest of the geometry is up to date
+    if (m_geometryNeedUpdate || !m_font || m_lines.empty())
+    {
+        m_geometryNeedUpdate = true;
+        return;
+    }
+
+    const Texture& fontTexture = m_font->isDistanceField() ? m_font->getDistanceFieldTexture() : m_font->getTexture(m_characterSize);
+    if (fontTexture.m_cacheId != m_fontTextureId)
+    {
+        m_geometryNeedUpdate = true;
+        return;
+    }
+
+    // Find the lines touched by the edit, in the previous string
+    std::size_t firstLine = findLine(position);
+    std::size_t nextLine  = findLine(position + erased) + 1;
+
+    // In the new string, they extend up to the first line break after the edit
+    std::size_t begin = m_lines[firstLine].first;
+    std::size_t end   = position + inserted;
+    while ((end < m_string.getSize()) && (m_string[end] != L'\n'))
+        ++end;
+    if (end < m_string.getSize())
+        ++end;
+
+    std::vector<Vertex> vertices;
+    std::vector<Vertex> outlineVertices;
+    std::vector<Line>   lines;
+    layoutLines(begin, end, firstLine, vertices, outlineVertices, lines);
+
+    // If new glyphs had to be loaded, the glyphs of the other lines may have moved in the font texture
+    if (fontTexture.m_cacheId != m_fontTextureId)
+    {
+        m_geometryNeedUpdate = true;
         return;
+    }
+
+    // The cached bounds only need to be merged from all the lines again if a line
+    // reaching their edge is replaced or moved: the other lines may not reach as far.
+    // Appending to the last line keeps its previous geometry, so its bounds can only grow.
+    float lineDistance = getLineDistance(*m_font, m_characterSize, m_lineSpacingFactor);
+    std::size_t previousSize = m_string.getSize() - inserted + erased;
+    bool isAppend = (erased == 0) && (position == previousSize);
+    bool rescanBounds = (previousSize == 0);
+    if (!isAppend)
+    {
+        for (std::size_t i = firstLine; (i < nextLine) && !rescanBounds; ++i)
+            rescanBounds = isOnBoundsEdge(i, lineDistance);
+    }
+
+    // Replace the geometry of the previous lines
+    std::size_t vertexBegin  = m_lines[firstLine].vertexOffset;
+    std::size_t vertexEnd    = (nextLine < m_lines.size()) ? m_lines[nextLine].vertexOffset : m_vertices.size();
+    std::size_t outlineBegin = m_lines[firstLine].outlineVertexOffset;
+    std::size_t outlineEnd   = (nextLine < m_lines.size()) ? m_lines[nextLine].outlineVertexOffset : m_outlineVertices.size();
+
+    m_vertices.erase(m_vertices.begin() + vertexBegin, m_vertices.begin() + vertexEnd);
+    m_vertices.insert(m_vertices.begin() + vertexBegin, vertices.begin(), vertices.end());
+    m_outlineVertices.erase(m_outlineVertices.begin() + outlineBegin, m_outlineVertices.begin() + outlineEnd);
+    m_outlineVertices.insert(m_outlineVertices.begin() + outlineBegin, outlineVertices.begin(), outlineVertices.end());
+
+    for (std::vector<Line>::iterator it = lines.begin(); it != lines.end(); ++it)
+    {
+        it->vertexOffset        += vertexBegin;
+        it->outlineVertexOffset += outlineBegin;
+    }
+
+    // Move the following lines (the unsigned offsets wrap around when they decrease)
+    std::size_t characterOffset = inserted - erased;
+    std::size_t vertexOffset    = vertices.size() - (vertexEnd - vertexBegin);
+    std::size_t outlineOffset   = outlineVertices.size() - (outlineEnd - outlineBegin);
+
+    float lineOffset = (static_cast<float>(lines.size()) - static_cast<float>(nextLine - firstLine)) * lineDistance;
+
+    for (std::size_t i = nextLine; i < m_lines.size(); ++i)
+    {
+        Line& line = m_lines[i];
+
+        // Moving a line vertically only matters to the bounds if it's on their top or bottom edge
+        // (the distance to its baseline doesn't change, the baseline moves with it)
+        if ((lineOffset != 0) && (line.minY <= line.maxY) && ((line.minY <= m_boundsMin.y) || (line.maxY >= m_boundsMax.y)))
+            rescanBounds = true;
+
+        line.first               += characterOffset;
+        line.vertexOffset        += vertexOffset;
+        line.outlineVertexOffset += outlineOffset;
+        line.minY                += lineOffset;
+        line.maxY                += lineOffset;
+        line.drawMinY            += lineOffset;
+        line.drawMaxY            += lineOffset;
+    }
+
+    if (lineOffset != 0)
+    {
+        for (std::size_t i = vertexBegin + vertices.size(); i < m_vertices.size(); ++i)
+            m_vertices[i].position.y += lineOffset;
+
+        for (std::size_t i = outlineBegin + outlineVertices.size(); i < m_outlineVertices.size(); ++i)
+            m_outlineVertices[i].position.y += lineOffset;
+    }
+
+    m_lines.erase(m_lines.begin() + firstLine, m_lines.begin() + nextLine);
+    m_lines.insert(m_lines.begin() + firstLine, lines.begin(), lines.end());
+
+    if (rescanBounds || m_string.isEmpty())
+    {
+        updateBounds();
+    }
+    else
+    {
+        // Grow the bounds by the new lines, and by the moved lines at their new place
+        std::size_t extendEnd = (lineOffset != 0) ? m_lines.size() : firstLine + lines.size();
+        for (std::size_t i = firstLine; i < extendEnd; ++i)
+            extendBounds(i, lineDistance);
+
+        updateBoundsRect();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::layoutLines(std::size_t begin, std::size_t end, std::size_t lineIndex, std::vector<Vertex>& vertices, std::vector<Vertex>& outlineVertices, std::vector<Line>& lines) const
+{
+    // In distance field mode, the geometry is computed at the size of the distance
+    // field glyphs, and scaled to the character size at the end
+    bool distanceField = m_font->isDistanceField();
 
     // Compute values related to the text style
     bool  isBold             = m_style & Bold;
     bool  isUnderlined       = m_style & Underlined;
     bool  isStrikeThrough    = m_style & StrikeThrough;
     float italicShear        = (m_style & Italic) ? 0.209f : 0.f; // 12 degrees in radians
-    float underlineOffset    = m_font->getUnderlinePosition(m_characterSize);
-    float underlineThickness = m_font->getUnderlineThickness(m_characterSize);
+    unsigned int characterSize = getLayoutSize(*m_font, m_characterSize);
+    float underlineOffset    = m_font->getUnderlinePosition(characterSize);
+    float underlineThickness = m_font->getUnderlineThickness(characterSize);
+
+    // Distance field glyphs are padded by the field itself, and their outline only widens the bounds
+    float glyphPadding     = distanceField ? 0.f : 1.f;
+    float glyphInset       = distanceField ? static_cast<float>(Font::DistanceFieldSpread) : 0.f;
+    float outlineThickness = distanceField ? getDistanceFieldOutline(m_outlineThickness, m_characterSize) : m_outlineThickness;
 
     // Compute the location of the strike through dynamically
     // We use the center point of the lowercase 'x' glyph as the reference
     // We reuse the underline thickness as the thickness of the strike through as well
-    FloatRect xBounds = m_font->getGlyph(L'x', m_characterSize, isBold).bounds;
+    FloatRect xBounds = getGlyph(*m_font, L'x', characterSize, isBold).bounds;
     float strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
 
     // Precompute the variables needed by the algorithm
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float whitespaceWidth = getGlyph(*m_font, L' ', characterSize, isBold).advance;
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+    float lineSpacing     = m_font->getLineSpacing(characterSize) * m_lineSpacingFactor;
     float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
+    float y               = static_cast<float>(characterSize) + static_cast<float>(lineIndex) * lineSpacing;
+
+    std::size_t firstVertex        = vertices.size();
+    std::size_t firstOutlineVertex = outlineVertices.size();
+    std::size_t firstLine          = lines.size();
+
+    // Start the first line, the bounds of each line are grown by its characters
+    Line line;
+    line.first               = begin;
+    line.vertexOffset        = vertices.size();
+    line.outlineVertexOffset = outlineVertices.size();
+    line.minX                = std::numeric_limits<float>::max();
+    line.minY                = std::numeric_limits<float>::max();
+    line.maxX                = -std::numeric_limits<float>::max();
+    line.maxY                = -std::numeric_limits<float>::max();
+    line.drawMinY            = std::numeric_limits<float>::max();
+    line.drawMaxY            = -std::numeric_limits<float>::max();
 
     // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    Uint32 prevChar = (lineIndex > 0) ? L'\n' : 0;
+    for (std::size_t i = begin; i < end; ++i)
     {
         Uint32 curChar = m_string[i];
 
@@ -451,24 +766,24 @@ void Text::ensureGeometryUpdate() const
             continue;
 
         // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        x += m_font->getKerning(prevChar, curChar, characterSize, isBold);
 
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == L'\n' && prevChar != L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+            addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness, line.drawMinY, line.drawMaxY);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+                addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, line.drawMinY, line.drawMaxY, outlineThickness);
         }
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (isStrikeThrough && (curChar == L'\n' && prevChar != L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+            addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness, line.drawMinY, line.drawMaxY);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+                addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, line.drawMinY, line.drawMaxY, outlineThickness);
         }
 
         prevChar = curChar;
@@ -477,8 +792,8 @@ void Text::ensureGeometryUpdate() const
         if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
         {
             // Update the current bounds (min coordinates)
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+            line.minX = std::min(line.minX, x);
+            line.minY = std::min(line.minY, y);
 
             switch (curChar)
             {
@@ -488,8 +803,29 @@ void Text::ensureGeometryUpdate() const
             }
 
             // Update the current bounds (max coordinates)
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
+            line.maxX = std::max(line.maxX, x);
+            line.maxY = std::max(line.maxY, y);
+
+            // The line ends with its line break, start the next one
+            if (curChar == L'\n')
+            {
+                line.drawMinY = std::min(line.drawMinY, line.minY);
+                line.drawMaxY = std::max(line.drawMaxY, line.maxY);
+                lines.push_back(line);
+
+                ++lineIndex;
+                y = static_cast<float>(characterSize) + static_cast<float>(lineIndex) * lineSpacing;
+
+                line.first               = i + 1;
+                line.vertexOffset        = vertices.size();
+                line.outlineVertexOffset = outlineVertices.size();
+                line.minX                = std::numeric_limits<float>::max();
+                line.minY                = std::numeric_limits<float>::max();
+                line.maxX                = -std::numeric_limits<float>::max();
+                line.maxY                = -std::numeric_limits<float>::max();
+                line.drawMinY            = std::numeric_limits<float>::max();
+                line.drawMaxY            = -std::numeric_limits<float>::max();
+            }
 
             // Next glyph, no need to create a quad for whitespace
             continue;
@@ -498,70 +834,247 @@ void Text::ensureGeometryUpdate() const
         // Apply the outline
         if (m_outlineThickness != 0)
         {
-            const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness);
-
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-            // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+            const Glyph& glyph = getGlyph(*m_font, curChar, characterSize, isBold, m_outlineThickness);
 
-            // Update the current bounds with the outlined glyph bounds
-            minX = std::min(minX, x + left   - italicShear * bottom - m_outlineThickness);
-            maxX = std::max(maxX, x + right  - italicShear * top    - m_outlineThickness);
-            minY = std::min(minY, y + top    - m_outlineThickness);
-            maxY = std::max(maxY, y + bottom - m_outlineThickness);
+            if (distanceField)
+            {
+                // The outline uses the same quad as the glyph, it grows the bounds on all sides
+                float left   = glyph.bounds.left + glyphInset - outlineThickness;
+                float top    = glyph.bounds.top  + glyphInset - outlineThickness;
+                float right  = glyph.bounds.left + glyph.bounds.width  - glyphInset + outlineThickness;
+                float bottom = glyph.bounds.top  + glyph.bounds.height - glyphInset + outlineThickness;
+
+                addGlyphQuad(outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, 0, glyphPadding);
+
+                line.minX = std::min(line.minX, x + left   - italicShear * bottom);
+                line.maxX = std::max(line.maxX, x + right  - italicShear * top);
+                line.minY = std::min(line.minY, y + top);
+                line.maxY = std::max(line.maxY, y + bottom);
+            }
+            else
+            {
+                float left   = glyph.bounds.left;
+                float top    = glyph.bounds.top;
+                float right  = glyph.bounds.left + glyph.bounds.width;
+                float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+                // Add the outline glyph to the vertices
+                addGlyphQuad(outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+
+                // Update the current bounds with the outlined glyph bounds
+                line.minX = std::min(line.minX, x + left   - italicShear * bottom - m_outlineThickness);
+                line.maxX = std::max(line.maxX, x + right  - italicShear * top    - m_outlineThickness);
+                line.minY = std::min(line.minY, y + top    - m_outlineThickness);
+                line.maxY = std::max(line.maxY, y + bottom - m_outlineThickness);
+            }
         }
 
         // Extract the current glyph's description
-        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
+        const Glyph& glyph = getGlyph(*m_font, curChar, characterSize, isBold);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        addGlyphQuad(vertices, Vector2f(x, y), m_fillColor, glyph, italicShear, 0, glyphPadding);
 
         // Update the current bounds with the non outlined glyph bounds
         if (m_outlineThickness == 0)
         {
-            float left   = glyph.bounds.left;
-            float top    = glyph.bounds.top;
-            float right  = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top  + glyph.bounds.height;
-
-            minX = std::min(minX, x + left  - italicShear * bottom);
-            maxX = std::max(maxX, x + right - italicShear * top);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            float left   = glyph.bounds.left + glyphInset;
+            float top    = glyph.bounds.top  + glyphInset;
+            float right  = glyph.bounds.left + glyph.bounds.width  - glyphInset;
+            float bottom = glyph.bounds.top  + glyph.bounds.height - glyphInset;
+
+            line.minX = std::min(line.minX, x + left  - italicShear * bottom);
+            line.maxX = std::max(line.maxX, x + right - italicShear * top);
+            line.minY = std::min(line.minY, y + top);
+            line.maxY = std::max(line.maxY, y + bottom);
         }
 
         // Advance to the next character
         x += glyph.advance + letterSpacing;
     }
 
-    // If we're using the underlined style, add the last line
-    if (isUnderlined && (x > 0))
+    // The last line of the text has no line break, it ends with the string
+    if (end == m_string.getSize())
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+        // If we're using the underlined style, add the last line
+        if (isUnderlined && (x > 0))
+        {
+            addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness, line.drawMinY, line.drawMaxY);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+            if (m_outlineThickness != 0)
+                addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, line.drawMinY, line.drawMaxY, outlineThickness);
+        }
+
+        // If we're using the strike through style, add the last line across all characters
+        if (isStrikeThrough && (x > 0))
+        {
+            addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness, line.drawMinY, line.drawMaxY);
+
+            if (m_outlineThickness != 0)
+                addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, line.drawMinY, line.drawMaxY, outlineThickness);
+        }
+
+        // The drawn geometry covers the glyphs as well as the underline and strike through
+        line.drawMinY = std::min(line.drawMinY, line.minY);
+        line.drawMaxY = std::max(line.drawMaxY, line.maxY);
+        lines.push_back(line);
     }
 
-    // If we're using the strike through style, add the last line across all characters
-    if (isStrikeThrough && (x > 0))
+    // Scale the geometry computed on distance field glyphs to the character size
+    if (distanceField)
     {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        float scale = static_cast<float>(m_characterSize) / static_cast<float>(characterSize);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+        for (std::size_t i = firstVertex; i < vertices.size(); ++i)
+            vertices[i].position *= scale;
+
+        for (std::size_t i = firstOutlineVertex; i < outlineVertices.size(); ++i)
+            outlineVertices[i].position *= scale;
+
+        for (std::size_t i = firstLine; i < lines.size(); ++i)
+        {
+            lines[i].minX *= scale;
+            lines[i].minY *= scale;
+            lines[i].maxX *= scale;
+            lines[i].maxY *= scale;
+            lines[i].drawMinY *= scale;
+            lines[i].drawMaxY *= scale;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Text::findLine(std::size_t index) const
+{
+    // Binary search of the last line starting at or before the character
+    std::size_t low  = 0;
+    std::size_t high = m_lines.size();
+    while (high - low > 1)
+    {
+        std::size_t middle = (low + high) / 2;
+
+        if (m_lines[middle].first <= index)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateBounds() const
+{
+    // No text: no bounds
+    if (m_string.isEmpty())
+    {
+        m_bounds     = FloatRect();
+        m_boundsMin  = Vector2f();
+        m_boundsMax  = Vector2f();
+        m_lineTop    = 0;
+        m_lineBottom = 0;
+        return;
+    }
+
+    // Merge the bounds of all the lines, and find how far their drawn geometry extends from their baseline
+    m_boundsMin  = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+    m_boundsMax  = Vector2f(0.f, 0.f);
+    m_lineTop    = 0;
+    m_lineBottom = 0;
+    float lineDistance = getLineDistance(*m_font, m_characterSize, m_lineSpacingFactor);
+    for (std::size_t i = 0; i < m_lines.size(); ++i)
+        extendBounds(i, lineDistance);
+
+    updateBoundsRect();
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::extendBounds(std::size_t index, float lineDistance) const
+{
+    const Line& line = m_lines[index];
+
+    // Skip the empty last line
+    if (line.minY > line.maxY)
+        return;
+
+    m_boundsMin.x = std::min(m_boundsMin.x, line.minX);
+    m_boundsMin.y = std::min(m_boundsMin.y, line.minY);
+    m_boundsMax.x = std::max(m_boundsMax.x, line.maxX);
+    m_boundsMax.y = std::max(m_boundsMax.y, line.maxY);
+
+    float baseline = static_cast<float>(m_characterSize) + static_cast<float>(index) * lineDistance;
+    m_lineTop    = std::min(m_lineTop,    line.drawMinY - baseline);
+    m_lineBottom = std::max(m_lineBottom, line.drawMaxY - baseline);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Text::isOnBoundsEdge(std::size_t index, float lineDistance) const
+{
+    const Line& line = m_lines[index];
+
+    // The empty last line doesn't take part in the bounds
+    if (line.minY > line.maxY)
+        return false;
+
+    float baseline = static_cast<float>(m_characterSize) + static_cast<float>(index) * lineDistance;
+
+    return (line.minX <= m_boundsMin.x) || (line.minY <= m_boundsMin.y) ||
+           (line.maxX >= m_boundsMax.x) || (line.maxY >= m_boundsMax.y) ||
+           (line.drawMinY - baseline <= m_lineTop) || (line.drawMaxY - baseline >= m_lineBottom);
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::updateBoundsRect() const
+{
+    m_bounds.left   = m_boundsMin.x;
+    m_bounds.top    = m_boundsMin.y;
+    m_bounds.width  = m_boundsMax.x - m_boundsMin.x;
+    m_bounds.height = m_boundsMax.y - m_boundsMin.y;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::findVisibleLines(const RenderTarget& target, const Transform& transform, std::size_t& begin, std::size_t& end) const
+{
+    // Get the area of the view in the local coordinates of the text
+    FloatRect viewArea = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    FloatRect area = transform.getInverse().transformRect(viewArea);
+
+    // The lines are evenly spaced, a line may be visible if its baseline is close enough to the area
+    float firstBaseline = static_cast<float>(m_characterSize);
+    float lineDistance  = getLineDistance(*m_font, m_characterSize, m_lineSpacingFactor);
+    float top           = area.top - m_lineBottom - firstBaseline;
+    float bottom        = area.top + area.height - m_lineTop - firstBaseline;
+    float lineCount     = static_cast<float>(m_lines.size());
+
+    float first;
+    float last;
+    if (lineDistance > 0)
+    {
+        first = std::ceil(top / lineDistance);
+        last  = std::floor(bottom / lineDistance);
+    }
+    else if (lineDistance < 0)
+    {
+        first = std::ceil(bottom / lineDistance);
+        last  = std::floor(top / lineDistance);
+    }
+    else
+    {
+        // All the lines are on the same baseline
+        bool visible = (top <= 0) && (bottom >= 0);
+        first = 0;
+        last  = visible ? lineCount : -1;
     }
 
-    // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+    begin = static_cast<std::size_t>(std::max(0.f, std::min(first, lineCount)));
+    end   = static_cast<std::size_t>(std::max(0.f, std::min(last + 1, lineCount)));
+    end   = std::max(begin, end);
 }
 
 } // namespace sf
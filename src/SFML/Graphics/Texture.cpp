@@ -27,15 +27,19 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageRequest.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/CompressedImageLoader.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <vector>
 
 
 namespace
@@ -53,11 +57,145 @@ namespace
 
         return id++;
     }
+
+    // Retrieve the compressed formats listed by the driver
+    std::vector<GLint> getCompressedFormats()
+    {
+        GLint count = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count));
+
+        std::vector<GLint> formats(static_cast<std::size_t>(std::max(count, 0)));
+        if (!formats.empty())
+            glCheck(glGetIntegerv(GLEXT_GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]));
+
+        return formats;
+    }
+
+    // Check whether the driver can sample a compressed format
+    bool isCompressedFormatAvailable(GLenum format)
+    {
+        // The initialization of function-local statics is thread-safe
+        static const std::vector<GLint> formats = getCompressedFormats();
+
+        if (std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end())
+            return true;
+
+        // Drivers only have to list the general-purpose formats, the
+        // ones that are part of the core profile may not be listed
+        switch (format)
+        {
+            case GLEXT_GL_COMPRESSED_RED_RGTC1:
+            case GLEXT_GL_COMPRESSED_RG_RGTC2:
+                return GLEXT_GL_VERSION_3_0;
+
+            case GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM:
+            case GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+                return GLEXT_GL_VERSION_4_2;
+
+            case GLEXT_GL_COMPRESSED_RGB8_ETC2:
+            case GLEXT_GL_COMPRESSED_SRGB8_ETC2:
+            case GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC:
+            case GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+                return GLEXT_GL_VERSION_4_3;
+
+            default:
+                return false;
+        }
+    }
+
+    // Get the OpenGL internal format of a compression format
+    GLenum getCompressedInternalFormat(sf::priv::CompressedImage::Format format, bool sRgb)
+    {
+        switch (format)
+        {
+            case sf::priv::CompressedImage::Bc1:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT1;
+            case sf::priv::CompressedImage::Bc2:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT3;
+            case sf::priv::CompressedImage::Bc3:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : GLEXT_GL_COMPRESSED_RGBA_S3TC_DXT5;
+            case sf::priv::CompressedImage::Bc4:      return GLEXT_GL_COMPRESSED_RED_RGTC1;
+            case sf::priv::CompressedImage::Bc5:      return GLEXT_GL_COMPRESSED_RG_RGTC2;
+            case sf::priv::CompressedImage::Bc7:      return sRgb ? GLEXT_GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GLEXT_GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case sf::priv::CompressedImage::Etc2Rgb:  return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ETC2 : GLEXT_GL_COMPRESSED_RGB8_ETC2;
+            default:                                  return sRgb ? GLEXT_GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLEXT_GL_COMPRESSED_RGBA8_ETC2_EAC;
+        }
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+struct Texture::UploadRing
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Pixel buffer of the ring, with the fence of its last upload
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        unsigned int buffer; //!< OpenGL identifier of the pixel buffer
+        GLsync       fence;  //!< Fence signaled when the last upload from the buffer is finished
+        Uint64       id;     //!< Identifier of the last upload from the buffer
+    };
+
+    static const std::size_t SlotCount = 3;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    UploadRing() :
+    current(0),
+    lastId (0),
+    mapped (false),
+    area   (),
+    staging()
+    {
+        for (std::size_t i = 0; i < SlotCount; ++i)
+        {
+            slots[i].buffer = 0;
+            slots[i].fence  = 0;
+            slots[i].id     = 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether uploads can go through pixel buffers
+    ///
+    /// Otherwise, the staging area lives in system memory and
+    /// the uploads are synchronous.
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool usePixelBuffers()
+    {
+        return GLEXT_pixel_buffer_object && GLEXT_map_buffer_range;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the last upload of a slot is finished, and release its fence
+    ///
+    ////////////////////////////////////////////////////////////
+    static void wait(Slot& slot)
+    {
+        if (slot.fence)
+        {
+            glCheck(GLEXT_glClientWaitSync(slot.fence, GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, GLEXT_GL_TIMEOUT_IGNORED));
+            glCheck(GLEXT_glDeleteSync(slot.fence));
+            slot.fence = 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Slot               slots[SlotCount]; //!< Pixel buffers, used in turn
+    std::size_t        current;          //!< Index of the slot used by the next upload
+    Uint64             lastId;           //!< Identifier of the last upload
+    bool               mapped;           //!< Is an update in progress?
+    Rect<unsigned int> area;             //!< Area of the texture targeted by the update in progress
+    std::vector<Uint8> staging;          //!< Staging area, when pixel buffers are not supported
+};
+
+
 ////////////////////////////////////////////////////////////
 Texture::Texture() :
 m_size         (0, 0),
@@ -69,7 +207,9 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_isCompressed (false),
+m_cacheId      (getUniqueId()),
+m_uploadRing   (NULL)
 {
 }
 
@@ -85,12 +225,16 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_isCompressed (false),
+m_cacheId      (getUniqueId()),
+m_uploadRing   (NULL)
 {
     if (copy.m_texture)
     {
         if (create(copy.getSize().x, copy.getSize().y))
         {
+            // Keep the orientation of the source, so that its rows can be copied as they are
+            m_pixelsFlipped = copy.m_pixelsFlipped;
             update(copy);
         }
         else
@@ -112,6 +256,28 @@ Texture::~Texture()
         GLuint texture = static_cast<GLuint>(m_texture);
         glCheck(glDeleteTextures(1, &texture));
     }
+
+    // Destroy the pixel buffers of the asynchronous updates
+    if (m_uploadRing)
+    {
+        TransientContextLock lock;
+
+        for (std::size_t i = 0; i < UploadRing::SlotCount; ++i)
+        {
+            UploadRing::Slot& slot = m_uploadRing->slots[i];
+
+            if (slot.fence)
+                glCheck(GLEXT_glDeleteSync(slot.fence));
+
+            if (slot.buffer)
+            {
+                GLuint buffer = static_cast<GLuint>(slot.buffer);
+                glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+            }
+        }
+
+        delete m_uploadRing;
+    }
 }
 
 
@@ -150,6 +316,7 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_isCompressed  = false;
 
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
@@ -206,6 +373,14 @@ bool Texture::create(unsigned int width, unsigned int height)
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+#ifndef SFML_OPENGL_ES
+
+    // Restore the default mipmap range, a compressed texture loaded before may have capped it
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000));
+
+#endif // SFML_OPENGL_ES
+
     m_cacheId = getUniqueId();
 
     m_hasMipmap = false;
@@ -217,6 +392,11 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
+    // Pre-compressed containers are uploaded without being decoded
+    std::vector<Uint8> contents;
+    if (priv::readCompressedImage(filename, contents))
+        return loadFromCompressedMemory(&contents[0], contents.size(), area);
+
     Image image;
     return image.loadFromFile(filename) && loadFromImage(image, area);
 }
@@ -225,6 +405,10 @@ bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    // Pre-compressed containers are uploaded without being decoded
+    if (priv::isCompressedImage(data, size))
+        return loadFromCompressedMemory(data, size, area);
+
     Image image;
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
@@ -233,6 +417,11 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    // Pre-compressed containers are uploaded without being decoded
+    std::vector<Uint8> contents;
+    if (priv::readCompressedImage(stream, contents))
+        return loadFromCompressedMemory(&contents[0], contents.size(), area);
+
     Image image;
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
@@ -395,6 +584,40 @@ Image Texture::copyToImage() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::requestCopy(ImageRequest& request) const
+{
+    if (!m_texture)
+        return false;
+
+    TransientContextLock lock;
+
+#ifndef SFML_OPENGL_ES
+
+    // The whole texture is read, padding and flipping are handled when the pixels are retrieved
+    if (request.beginCopy(m_size, m_actualSize.x, m_actualSize.y, m_pixelsFlipped))
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // The destination pointer is an offset into the bound pixel buffer
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+        request.endCopy();
+
+        return true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Asynchronous copies are not supported, copy the pixels right away
+    request.setImage(copyToImage());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels)
 {
@@ -409,6 +632,12 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated from pixels" << std::endl;
+        return;
+    }
+
     if (pixels && m_texture)
     {
         TransientContextLock lock;
@@ -448,95 +677,154 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
     if (!m_texture || !texture.m_texture)
         return;
 
-#ifndef SFML_OPENGL_ES
+    copyRegion(texture, IntRect(0, 0, texture.m_size.x, texture.m_size.y), Vector2u(x, y));
+}
 
+
+////////////////////////////////////////////////////////////
+bool Texture::copyRegion(const Texture& source, const IntRect& sourceRect, const Vector2u& destination)
+{
+    if (!m_texture || !source.m_texture)
     {
-        TransientContextLock lock;
+        err() << "Failed to copy texture region, texture not created" << std::endl;
+        return false;
+    }
 
-        // Make sure that extensions are initialized
-        priv::ensureExtensionsInit();
+    if (m_isCompressed)
+    {
+        err() << "Failed to copy texture region, compressed textures can't be updated" << std::endl;
+        return false;
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Check that both regions lie within their texture
+    if ((sourceRect.left < 0) || (sourceRect.top < 0) || (sourceRect.width <= 0) || (sourceRect.height <= 0) ||
+        (static_cast<unsigned int>(sourceRect.left + sourceRect.width) > source.m_size.x) ||
+        (static_cast<unsigned int>(sourceRect.top + sourceRect.height) > source.m_size.y) ||
+        (destination.x + sourceRect.width > m_size.x) || (destination.y + sourceRect.height > m_size.y))
+    {
+        err() << "Failed to copy texture region, the region doesn't fit in the textures" << std::endl;
+        return false;
+    }
+
+    GLint width  = sourceRect.width;
+    GLint height = sourceRect.height;
+
+#ifndef SFML_OPENGL_ES
+
+    // Compressed blocks can neither be copied raw to an uncompressed texture
+    // nor attached to a framebuffer, they are decoded by copyToImage instead
+    if (!source.m_isCompressed)
     {
         TransientContextLock lock;
 
-        // Save the current bindings so we can restore them after we are done
-        GLint readFramebuffer = 0;
-        GLint drawFramebuffer = 0;
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
 
-        glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
-        glCheck(glGetIntegerv(GLEXT_GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
+        // Flipped textures store their rows bottom-up, convert the regions to OpenGL rows
+        GLint sourceX = sourceRect.left;
+        GLint sourceY = source.m_pixelsFlipped ? static_cast<GLint>(source.m_size.y) - sourceRect.top - height : sourceRect.top;
+        GLint destX   = static_cast<GLint>(destination.x);
+        GLint destY   = m_pixelsFlipped ? static_cast<GLint>(m_size.y - destination.y) - height : static_cast<GLint>(destination.y);
 
-        // Create the framebuffers
-        GLuint sourceFrameBuffer = 0;
-        GLuint destFrameBuffer = 0;
-        glCheck(GLEXT_glGenFramebuffers(1, &sourceFrameBuffer));
-        glCheck(GLEXT_glGenFramebuffers(1, &destFrameBuffer));
+        bool copied = false;
 
-        if (!sourceFrameBuffer || !destFrameBuffer)
+        if (GLEXT_copy_image && (source.m_pixelsFlipped == m_pixelsFlipped))
         {
-            err() << "Cannot copy texture, failed to create a frame buffer object" << std::endl;
-            return;
+            // A raw copy keeps the order of the rows, which is only
+            // correct if both textures share the same orientation
+            glCheck(GLEXT_glCopyImageSubData(source.m_texture, GL_TEXTURE_2D, 0, sourceX, sourceY, 0,
+                                             m_texture, GL_TEXTURE_2D, 0, destX, destY, 0,
+                                             width, height, 1));
+            copied = true;
         }
+        else if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+        {
+            // Save the current bindings so we can restore them after we are done
+            GLint readFramebuffer = 0;
+            GLint drawFramebuffer = 0;
 
-        // Link the source texture to the source frame buffer
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, sourceFrameBuffer));
-        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_READ_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.m_texture, 0));
+            glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
+            glCheck(glGetIntegerv(GLEXT_GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
 
-        // Link the destination texture to the destination frame buffer
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, destFrameBuffer));
-        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_DRAW_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
+            // Create the framebuffers
+            GLuint sourceFrameBuffer = 0;
+            GLuint destFrameBuffer = 0;
+            glCheck(GLEXT_glGenFramebuffers(1, &sourceFrameBuffer));
+            glCheck(GLEXT_glGenFramebuffers(1, &destFrameBuffer));
 
-        // A final check, just to be sure...
-        GLenum sourceStatus;
-        glCheck(sourceStatus = GLEXT_glCheckFramebufferStatus(GLEXT_GL_READ_FRAMEBUFFER));
+            if (!sourceFrameBuffer || !destFrameBuffer)
+            {
+                err() << "Cannot copy texture, failed to create a frame buffer object" << std::endl;
+                return false;
+            }
 
-        GLenum destStatus;
-        glCheck(destStatus = GLEXT_glCheckFramebufferStatus(GLEXT_GL_DRAW_FRAMEBUFFER));
+            // Link the source texture to the source frame buffer
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, sourceFrameBuffer));
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_READ_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.m_texture, 0));
 
-        if ((sourceStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (destStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE))
-        {
-            // Blit the texture contents from the source to the destination texture
-            glCheck(GLEXT_glBlitFramebuffer(
-                0, texture.m_pixelsFlipped ? texture.m_size.y : 0, texture.m_size.x, texture.m_pixelsFlipped ? 0 : texture.m_size.y, // Source rectangle, flip y if source is flipped
-                x, y, x + texture.m_size.x, y + texture.m_size.y, // Destination rectangle
-                GL_COLOR_BUFFER_BIT, GL_NEAREST
-            ));
-        }
-        else
-        {
-            err() << "Cannot copy texture, failed to link texture to frame buffer" << std::endl;
-        }
+            // Link the destination texture to the destination frame buffer
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, destFrameBuffer));
+            glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_DRAW_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
 
-        // Restore previously bound framebuffers
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, readFramebuffer));
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, drawFramebuffer));
+            // A final check, just to be sure...
+            GLenum sourceStatus;
+            glCheck(sourceStatus = GLEXT_glCheckFramebufferStatus(GLEXT_GL_READ_FRAMEBUFFER));
 
-        // Delete the framebuffers
-        glCheck(GLEXT_glDeleteFramebuffers(1, &sourceFrameBuffer));
-        glCheck(GLEXT_glDeleteFramebuffers(1, &destFrameBuffer));
+            GLenum destStatus;
+            glCheck(destStatus = GLEXT_glCheckFramebufferStatus(GLEXT_GL_DRAW_FRAMEBUFFER));
 
-        // Make sure that the current texture binding will be preserved
-        priv::TextureSaver save;
+            if ((sourceStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (destStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE))
+            {
+                // Blit the region from the source to the destination texture,
+                // flip y if the textures don't share the same orientation
+                bool flip = (source.m_pixelsFlipped != m_pixelsFlipped);
+                glCheck(GLEXT_glBlitFramebuffer(
+                    sourceX, sourceY, sourceX + width, sourceY + height, // Source rectangle
+                    destX, flip ? destY + height : destY, destX + width, flip ? destY : destY + height, // Destination rectangle
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST
+                ));
+                copied = true;
+            }
+            else
+            {
+                err() << "Cannot copy texture, failed to link texture to frame buffer" << std::endl;
+            }
 
-        // Set the parameters of this texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-        m_hasMipmap = false;
-        m_pixelsFlipped = false;
-        m_cacheId = getUniqueId();
+            // Restore previously bound framebuffers
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, readFramebuffer));
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, drawFramebuffer));
 
-        // Force an OpenGL flush, so that the texture data will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+            // Delete the framebuffers
+            glCheck(GLEXT_glDeleteFramebuffers(1, &sourceFrameBuffer));
+            glCheck(GLEXT_glDeleteFramebuffers(1, &destFrameBuffer));
 
-        return;
+            if (!copied)
+                return false;
+        }
+
+        if (copied)
+        {
+            // The mipmaps no longer match the new contents
+            invalidateMipmap();
+            m_cacheId = getUniqueId();
+
+            // Force an OpenGL flush, so that the texture data will appear updated
+            // in all contexts immediately (solves problems in multi-threaded apps)
+            glCheck(glFlush());
+
+            return true;
+        }
     }
 
 #endif // SFML_OPENGL_ES
 
-    update(texture.copyToImage(), x, y);
+    // Neither direct copy is available, or the source is compressed: go through system memory
+    Image region;
+    region.create(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+    region.copy(source.copyToImage(), 0, 0, sourceRect);
+    update(region, destination.x, destination.y);
+
+    return true;
 }
 
 
@@ -568,6 +856,12 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
+    if (m_isCompressed)
+    {
+        err() << "Failed to update texture, compressed textures can't be updated from a window" << std::endl;
+        return;
+    }
+
     if (m_texture && window.setActive(true))
     {
         TransientContextLock lock;
@@ -590,6 +884,192 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint8* Texture::beginAsyncUpdate(unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (!m_texture || (width == 0) || (height == 0))
+        return NULL;
+
+    if (m_isCompressed)
+    {
+        err() << "Failed to start an asynchronous texture update, compressed textures can't be updated from pixels" << std::endl;
+        return NULL;
+    }
+
+    if (!m_uploadRing)
+        m_uploadRing = new UploadRing;
+
+    if (m_uploadRing->mapped)
+    {
+        err() << "Failed to start an asynchronous texture update, the previous one was not finished" << std::endl;
+        return NULL;
+    }
+
+    std::size_t size = static_cast<std::size_t>(width) * height * 4;
+    Uint8* pixels = NULL;
+
+    TransientContextLock lock;
+
+    if (UploadRing::usePixelBuffers())
+    {
+        UploadRing::Slot& slot = m_uploadRing->slots[m_uploadRing->current];
+
+        // Wait for the oldest upload if it is still in flight, so that
+        // the application can't get too far ahead of the graphics driver
+        UploadRing::wait(slot);
+
+        if (!slot.buffer)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            slot.buffer = static_cast<unsigned int>(buffer);
+        }
+
+        if (!slot.buffer)
+        {
+            err() << "Failed to start an asynchronous texture update, failed to create the pixel buffer" << std::endl;
+            return NULL;
+        }
+
+        // Allocate fresh storage and map it for writing
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, slot.buffer));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, size, 0, GLEXT_GL_STREAM_DRAW));
+        glCheck(pixels = static_cast<Uint8*>(GLEXT_glMapBufferRange(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT)));
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        if (!pixels)
+        {
+            err() << "Failed to start an asynchronous texture update, failed to map the pixel buffer" << std::endl;
+            return NULL;
+        }
+    }
+    else
+    {
+        m_uploadRing->staging.resize(size);
+        pixels = &m_uploadRing->staging[0];
+    }
+
+    m_uploadRing->mapped = true;
+    m_uploadRing->area   = Rect<unsigned int>(x, y, width, height);
+
+    return pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::endAsyncUpdate()
+{
+    if (!m_uploadRing || !m_uploadRing->mapped)
+        return 0;
+
+    m_uploadRing->mapped = false;
+
+    const Rect<unsigned int>& area = m_uploadRing->area;
+
+    // Without pixel buffers, the update is synchronous and complete right away
+    if (!UploadRing::usePixelBuffers())
+    {
+        update(&m_uploadRing->staging[0], area.width, area.height, area.left, area.top);
+        return ++m_uploadRing->lastId;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    UploadRing::Slot& slot = m_uploadRing->slots[m_uploadRing->current];
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, slot.buffer));
+
+    GLboolean unmapped = GL_FALSE;
+    glCheck(unmapped = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+
+    Uint64 id = 0;
+    if (unmapped == GL_TRUE)
+    {
+        // The source pointer is an offset into the bound pixel buffer,
+        // the driver performs the transfer without blocking the application
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width, area.height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueId();
+
+        if (GLEXT_sync)
+            glCheck(slot.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+        id = ++m_uploadRing->lastId;
+        slot.id = id;
+        m_uploadRing->current = (m_uploadRing->current + 1) % UploadRing::SlotCount;
+    }
+    else
+    {
+        // The contents of the buffer were lost while it was mapped (e.g. screen mode change)
+        err() << "Failed to finish an asynchronous texture update, the pixel buffer was corrupted" << std::endl;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::updateAsync(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    if (!pixels)
+        return 0;
+
+    Uint8* staging = beginAsyncUpdate(width, height, x, y);
+    if (!staging)
+        return 0;
+
+    std::memcpy(staging, pixels, static_cast<std::size_t>(width) * height * 4);
+
+    return endAsyncUpdate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isAsyncUpdateComplete(Uint64 update) const
+{
+    if (!m_uploadRing || (update == 0))
+        return true;
+
+    for (std::size_t i = 0; i < UploadRing::SlotCount; ++i)
+    {
+        UploadRing::Slot& slot = m_uploadRing->slots[i];
+        if ((slot.id != update) || !slot.fence)
+            continue;
+
+        TransientContextLock lock;
+
+        GLenum status = 0;
+        glCheck(status = GLEXT_glClientWaitSync(slot.fence, 0, 0));
+        if ((status != GLEXT_GL_ALREADY_SIGNALED) && (status != GLEXT_GL_CONDITION_SATISFIED))
+            return false;
+
+        // Release the fence now, the buffer can be reused without waiting
+        glCheck(GLEXT_glDeleteSync(slot.fence));
+        slot.fence = 0;
+
+        return true;
+    }
+
+    // Updates that left the ring were waited for, or didn't go through a pixel buffer
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::setSmooth(bool smooth)
 {
@@ -731,6 +1211,117 @@ void Texture::invalidateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedMemory(const void* data, std::size_t size, const IntRect& area)
+{
+    priv::CompressedImage image;
+    if (!priv::parseCompressedImage(data, size, image))
+        return false;
+
+    // Blocks can't be cropped
+    if ((area != IntRect()) && (area != IntRect(0, 0, static_cast<int>(image.size.x), static_cast<int>(image.size.y))))
+    {
+        err() << "Failed to load compressed texture, only whole images can be loaded" << std::endl;
+        return false;
+    }
+
+    if ((image.size.x == 0) || (image.size.y == 0))
+    {
+        err() << "Failed to load compressed texture, invalid size (" << image.size.x << "x" << image.size.y << ")" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Make sure that the driver can sample the format, so that the caller can fall back to another file
+    GLenum internalFormat = getCompressedInternalFormat(image.format, m_sRgb);
+    if (m_sRgb && !isCompressedFormatAvailable(internalFormat))
+        internalFormat = getCompressedInternalFormat(image.format, false);
+
+    if (!isCompressedFormatAvailable(internalFormat))
+    {
+        err() << "Failed to load compressed texture, format " << priv::getFormatName(image.format)
+              << " is not supported by the graphics driver" << std::endl;
+        return false;
+    }
+
+    // Compressed textures can't be padded
+    if ((getValidSize(image.size.x) != image.size.x) || (getValidSize(image.size.y) != image.size.y))
+    {
+        err() << "Failed to load compressed texture, its size must be a power of two "
+              << "(" << image.size.x << "x" << image.size.y << ")" << std::endl;
+        return false;
+    }
+
+    // Check the maximum texture size
+    unsigned int maxSize = getMaximumSize();
+    if ((image.size.x > maxSize) || (image.size.y > maxSize))
+    {
+        err() << "Failed to load compressed texture, its size is too high "
+              << "(" << image.size.x << "x" << image.size.y << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_GL_VERSION_1_2 || Context::isExtensionAvailable("GL_EXT_texture_edge_clamp");
+
+    // Upload the blocks of all the levels
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    for (std::size_t i = 0; i < image.levels.size(); ++i)
+    {
+        const priv::CompressedImage::Level& level = image.levels[i];
+        glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, static_cast<GLsizei>(level.size.x), static_cast<GLsizei>(level.size.y),
+                                             0, static_cast<GLsizei>(level.byteCount), level.data));
+    }
+
+    bool hasMipmap = image.levels.size() > 1;
+
+#ifndef SFML_OPENGL_ES
+
+    // The mipmap chain of the file may be incomplete
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1)));
+
+#endif // SFML_OPENGL_ES
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    if (hasMipmap)
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    else
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    m_size          = image.size;
+    m_actualSize    = image.size;
+    m_pixelsFlipped = false;
+    m_fboAttachment = false;
+    m_hasMipmap     = hasMipmap;
+    m_isCompressed  = true;
+    m_cacheId       = getUniqueId();
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
@@ -831,6 +1422,8 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_isCompressed,  right.m_isCompressed);
+    std::swap(m_uploadRing,    right.m_uploadRing);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
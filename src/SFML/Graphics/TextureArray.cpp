@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    sf::Mutex idMutex;
+    sf::Mutex maximumLayerCountMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no texture array"
+
+        return id++;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Preserve the texture array binding, TextureSaver only handles 2D textures
+    class ArrayBindingSaver
+    {
+    public:
+
+        ArrayBindingSaver() :
+        m_binding(0)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &m_binding));
+        }
+
+        ~ArrayBindingSaver()
+        {
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, static_cast<GLuint>(m_binding)));
+        }
+
+    private:
+
+        GLint m_binding;
+    };
+
+#endif // SFML_OPENGL_ES
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+// With 24 bits of mantissa, the pixels at this height are divided in 128 steps
+const unsigned int TextureArray::MaximumStackHeight = 65536;
+
+
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_size    (0, 0),
+m_layers  (0),
+m_texture (0),
+m_isSmooth(false),
+m_cacheId (getUniqueId())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+    // Destroy the OpenGL texture
+    if (m_texture)
+    {
+        TransientContextLock lock;
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layers)
+{
+#ifdef SFML_OPENGL_ES
+
+    // Texture arrays are not supported by OpenGL ES 1
+    (void)width;
+    (void)height;
+    (void)layers;
+
+    err() << "Failed to create texture array, texture arrays are not supported" << std::endl;
+    return false;
+
+#else
+
+    // Check if texture parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layers == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layers << ")" << std::endl;
+        return false;
+    }
+
+    // The layers are addressed by stacking them in the texture coordinates (see getLayerOffset)
+    if (static_cast<Uint64>(height) * layers > MaximumStackHeight)
+    {
+        err() << "Failed to create texture array, its layers are too high once stacked "
+              << "(" << height << "x" << layers << ", maximum is " << MaximumStackHeight << ")"
+              << std::endl;
+        return false;
+    }
+
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, texture arrays are not supported" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Check the maximum texture size and layer count
+    GLint maxSize = 0;
+    glCheck(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize));
+
+    unsigned int maxLayers = getMaximumLayerCount();
+    if ((width > static_cast<unsigned int>(maxSize)) || (height > static_cast<unsigned int>(maxSize)) || (layers > maxLayers))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layers << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayers << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    m_size.x = width;
+    m_size.y = height;
+    m_layers = layers;
+
+    // Make sure that the current texture binding will be preserved
+    ArrayBindingSaver save;
+
+    // Layers are always clamped, so that filtering doesn't read the opposite edge
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, m_size.x, m_size.y, m_layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GLEXT_GL_CLAMP_TO_EDGE));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_cacheId = getUniqueId();
+
+    return true;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::loadFromImages(const std::vector<Image>& images)
+{
+    if (images.empty())
+    {
+        err() << "Failed to load texture array, no image given" << std::endl;
+        return false;
+    }
+
+    // The layers must be large enough to hold every image
+    Vector2u size;
+    for (std::vector<Image>::const_iterator it = images.begin(); it != images.end(); ++it)
+    {
+        size.x = std::max(size.x, it->getSize().x);
+        size.y = std::max(size.y, it->getSize().y);
+    }
+
+    if (!create(size.x, size.y, static_cast<unsigned int>(images.size())))
+        return false;
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+        update(images[i], static_cast<unsigned int>(i));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image& image, unsigned int layer, unsigned int x, unsigned int y)
+{
+#ifdef SFML_OPENGL_ES
+
+    (void)image;
+    (void)layer;
+    (void)x;
+    (void)y;
+
+#else
+
+    const Uint8* pixels = image.getPixelsPtr();
+    Vector2u size = image.getSize();
+
+    assert(layer < m_layers);
+    assert(x + size.x <= m_size.x);
+    assert(y + size.y <= m_size.y);
+
+    if (pixels && m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        ArrayBindingSaver save;
+
+        // Copy pixels from the given array to the layer
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+        glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, x, y, layer, size.x, size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+        // Force an OpenGL flush, so that the texture array data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layers;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TextureArray::getLayerOffset(unsigned int layer) const
+{
+    assert(layer < m_layers);
+
+    return Vector2f(0.f, static_cast<float>(layer * m_size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+#ifndef SFML_OPENGL_ES
+
+        if (m_texture)
+        {
+            TransientContextLock lock;
+
+            // Make sure that the current texture binding will be preserved
+            ArrayBindingSaver save;
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        }
+
+#endif // SFML_OPENGL_ES
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::bind(const TextureArray* textureArray)
+{
+#ifdef SFML_OPENGL_ES
+
+    (void)textureArray;
+
+#else
+
+    TransientContextLock lock;
+
+    if (GLEXT_texture_array)
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, textureArray ? textureArray->m_texture : 0));
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    return GLEXT_texture_array && Shader::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+#ifdef SFML_OPENGL_ES
+
+    return 0;
+
+#else
+
+    Lock lock(maximumLayerCountMutex);
+
+    static bool checked = false;
+    static GLint count = 0;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        if (GLEXT_texture_array)
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &count));
+    }
+
+    return static_cast<unsigned int>(count);
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArrayShader.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // The texture coordinates are kept in pixels, the
+    // fragment shader splits them into a layer and a position
+    const char vertexSource[] =
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    // Fragments lie strictly inside their primitive, so the layer
+    // of a primitive spanning a whole layer is never rounded up
+    const char fragmentSource[] =
+        "#extension GL_EXT_texture_array : require\n"
+        "uniform sampler2DArray sf_texture;\n"
+        "uniform vec2 sf_size;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 coords = gl_TexCoord[0].xy;\n"
+        "    float layer = floor(coords.y / sf_size.y);\n"
+        "    coords.y -= layer * sf_size.y;\n"
+        "    gl_FragColor = gl_Color * texture2DArray(sf_texture, vec3(coords / sf_size, layer));\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+TextureArrayShader::TextureArrayShader() :
+m_shader(),
+m_size  (),
+m_loaded(false),
+m_failed(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Shader* TextureArrayShader::getShader(const TextureArray& textureArray)
+{
+    if (!m_loaded)
+    {
+        // Don't retry on every draw if the compilation failed once
+        if (m_failed || !TextureArray::isAvailable())
+            return NULL;
+
+        if (!m_shader.loadFromMemory(vertexSource, fragmentSource))
+        {
+            err() << "Failed to compile the texture array shader, texture arrays can't be drawn" << std::endl;
+            m_failed = true;
+            return NULL;
+        }
+
+        m_shader.setUniform("sf_texture", Shader::CurrentTexture);
+        m_size = m_shader.getUniform("sf_size");
+        m_loaded = true;
+    }
+
+    Vector2u size = textureArray.getSize();
+    m_shader.setUniform(m_size, Glsl::Vec2(static_cast<float>(size.x), static_cast<float>(size.y)));
+
+    return &m_shader;
+}
+
+} // namespace priv
+
+} // namespace sf
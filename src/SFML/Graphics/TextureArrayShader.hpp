@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAYSHADER_HPP
+#define SFML_TEXTUREARRAYSHADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+
+
+namespace sf
+{
+class TextureArray;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Built-in shader drawing from a texture array
+///
+/// The texture coordinates address the layers stacked
+/// vertically, in pixels. The layer is selected per fragment
+/// from the Y coordinate, so that the vertices of a single
+/// draw can each use a different layer. This is why the
+/// height of the stack is limited to
+/// TextureArray::MaximumStackHeight.
+///
+////////////////////////////////////////////////////////////
+class TextureArrayShader
+{
+    SFML_DISALLOW_COPY_MOVE(TextureArrayShader);
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The shader is compiled on first use.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArrayShader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader, ready to draw with the given texture array
+    ///
+    /// \param textureArray Texture array to sample
+    ///
+    /// \return Pointer to the shader, or NULL if it couldn't be compiled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getShader(const TextureArray& textureArray);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Shader          m_shader; //!< Built-in shader program
+    Shader::Uniform m_size;   //!< Handle of the uniform holding the size of the layers
+    bool            m_loaded; //!< Was the shader compiled successfully?
+    bool            m_failed; //!< Did the compilation fail?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAYSHADER_HPP
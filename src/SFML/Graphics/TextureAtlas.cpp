@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+    // Orders the images so that the tallest ones are packed first
+    struct TallerImage
+    {
+        TallerImage(const std::vector<sf::Image>& images) : m_images(images) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            return m_images[left].getSize().y > m_images[right].getSize().y;
+        }
+
+        const std::vector<sf::Image>& m_images;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const TextureAtlas::Handle TextureAtlas::InvalidHandle = static_cast<TextureAtlas::Handle>(-1);
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Page::Page() :
+packer(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding) :
+m_pageSize(pageSize),
+m_padding (padding),
+m_smooth  (false),
+m_pages   (),
+m_regions ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::~TextureAtlas()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::add(const Image& image)
+{
+    Region region;
+    if (!insert(image, region))
+        return InvalidHandle;
+
+    m_regions.push_back(region);
+    return m_regions.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Handle TextureAtlas::addFromFile(const std::string& filename)
+{
+    Image image;
+    if (!image.loadFromFile(filename))
+        return InvalidHandle;
+
+    return add(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::add(const std::vector<Image>& images, std::vector<Handle>& handles)
+{
+    handles.assign(images.size(), InvalidHandle);
+
+    // Packing the tallest images first leaves fewer holes under the skyline
+    std::vector<std::size_t> order(images.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), TallerImage(images));
+
+    bool success = true;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        handles[order[i]] = add(images[order[i]]);
+        if (handles[order[i]] == InvalidHandle)
+            success = false;
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromFiles(const std::vector<std::string>& filenames, std::vector<Handle>& handles)
+{
+    std::vector<Image> images(filenames.size());
+
+    bool success = true;
+    for (std::size_t i = 0; i < filenames.size(); ++i)
+    {
+        // Failed images are left empty, and add() will reject them
+        if (!images[i].loadFromFile(filenames[i]))
+            success = false;
+    }
+
+    return add(images, handles) && success;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(Handle handle) const
+{
+    assert(handle < m_regions.size());
+
+    return m_pages[m_regions[handle].page].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TextureAtlas::getTextureRect(Handle handle) const
+{
+    assert(handle < m_regions.size());
+
+    return m_regions[handle].rect;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getImageCount() const
+{
+    return m_regions.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextureAtlas::getPageCount() const
+{
+    return m_pages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getPageTexture(std::size_t index) const
+{
+    assert(index < m_pages.size());
+
+    return m_pages[index].texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+
+    for (std::deque<Page>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        it->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    for (std::deque<Page>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        delete it->packer;
+
+    m_pages.clear();
+    m_regions.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::insert(const Image& image, Region& region)
+{
+    Vector2u size = image.getSize();
+    if ((size.x == 0) || (size.y == 0))
+    {
+        err() << "Failed to add image to texture atlas, image is empty" << std::endl;
+        return false;
+    }
+
+    // The padding is reserved on the right and bottom of each image
+    Vector2u paddedSize(size.x + m_padding, size.y + m_padding);
+    unsigned int pageSize = std::min(m_pageSize, Texture::getMaximumSize());
+    if ((paddedSize.x > pageSize) || (paddedSize.y > pageSize))
+    {
+        err() << "Failed to add image to texture atlas, its size (" << size.x << "x" << size.y << ") "
+              << "doesn't fit in a page (" << pageSize << "x" << pageSize << ")" << std::endl;
+        return false;
+    }
+
+    // Look for a page with enough room
+    Vector2u position;
+    std::size_t index = 0;
+    for (; index < m_pages.size(); ++index)
+    {
+        if (m_pages[index].packer->insert(paddedSize, position))
+            break;
+    }
+
+    // None found: create a new page
+    if (index == m_pages.size())
+    {
+        m_pages.push_back(Page());
+        Page& page = m_pages.back();
+
+        if (!page.texture.create(pageSize, pageSize))
+        {
+            err() << "Failed to create a new texture atlas page" << std::endl;
+            m_pages.pop_back();
+            return false;
+        }
+
+        // Clear the page once, so that padding and free space stay transparent
+        std::vector<Uint8> pixels(static_cast<std::size_t>(pageSize) * pageSize * 4, 0);
+        page.texture.update(&pixels[0]);
+        page.texture.setSmooth(m_smooth);
+
+        page.packer = new priv::SkylinePacker(Vector2u(pageSize, pageSize));
+        page.packer->insert(paddedSize, position);
+    }
+
+    // Upload only the region covered by the image
+    m_pages[index].texture.update(image.getPixelsPtr(), size.x, size.y, position.x, position.y);
+
+    region.page = index;
+    region.rect = IntRect(static_cast<int>(position.x), static_cast<int>(position.y),
+                          static_cast<int>(size.x), static_cast<int>(size.y));
+
+    return true;
+}
+
+} // namespace sf
@@ -27,8 +27,202 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/MathConstants.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Vertex3D.hpp>
 #include <cmath>
 
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SFML_TRANSFORM_AVX
+    #define SFML_TRANSFORM_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
+
+namespace
+{
+    // All the kernels add the terms in the same order as transformPoint,
+    // ((m0 * x + m4 * y) + m8 * z) + m12, so that they give the same results
+
+    // Transform interleaved (x, y) pairs, several points per iteration
+    void transform2D(const float* m, const float* in, float* out, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_AVX)
+
+        // 4 points per iteration: duplicate the x and y of each point
+        // across its two lanes, then out = x * wideCol0 + y * wideCol1 + wideCol3
+        const __m256 wideCol0 = _mm256_setr_ps(m[0], m[1], m[0], m[1], m[0], m[1], m[0], m[1]);
+        const __m256 wideCol1 = _mm256_setr_ps(m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5]);
+        const __m256 wideCol3 = _mm256_setr_ps(m[12], m[13], m[12], m[13], m[12], m[13], m[12], m[13]);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256 points = _mm256_loadu_ps(in + 2 * i);
+            __m256 x = _mm256_moveldup_ps(points);
+            __m256 y = _mm256_movehdup_ps(points);
+            _mm256_storeu_ps(out + 2 * i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, wideCol0), _mm256_mul_ps(y, wideCol1)), wideCol3));
+        }
+
+#endif
+
+#if defined(SFML_TRANSFORM_SSE)
+
+        // 2 points per iteration
+        const __m128 col0 = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+        const __m128 col1 = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+        const __m128 col3 = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 points = _mm_loadu_ps(in + 2 * i);
+            __m128 x = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 y = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+            _mm_storeu_ps(out + 2 * i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, col0), _mm_mul_ps(y, col1)), col3));
+        }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+        // 4 points per iteration, deinterleaved by the load
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x2_t points = vld2q_f32(in + 2 * i);
+            float32x4x2_t result;
+            result.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(points.val[0], m[0]), vmulq_n_f32(points.val[1], m[4])), vdupq_n_f32(m[12]));
+            result.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(points.val[0], m[1]), vmulq_n_f32(points.val[1], m[5])), vdupq_n_f32(m[13]));
+            vst2q_f32(out + 2 * i, result);
+        }
+
+#endif
+
+        // Remaining points
+        for (; i < count; ++i)
+        {
+            float x = in[2 * i];
+            float y = in[2 * i + 1];
+            out[2 * i]     = m[0] * x + m[4] * y + m[12];
+            out[2 * i + 1] = m[1] * x + m[5] * y + m[13];
+        }
+    }
+
+    // Transform the positions of vertices in place in their structure, one vertex per iteration.
+    // The vertices are loaded with a single 16-byte read starting at the position, which
+    // stays within the structure: the lanes following the position (color and the start of
+    // the texture coordinates) are written back unchanged along with the result.
+    void transformVertices(const float* m, const sf::Vertex* in, sf::Vertex* out, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE)
+
+        const __m128 col0 = _mm_setr_ps(m[0], m[1], 0.f, 0.f);
+        const __m128 col1 = _mm_setr_ps(m[4], m[5], 0.f, 0.f);
+        const __m128 col3 = _mm_setr_ps(m[12], m[13], 0.f, 0.f);
+
+        for (; i < count; ++i)
+        {
+            __m128 vertex = _mm_loadu_ps(&in[i].position.x);
+            __m128 x = _mm_shuffle_ps(vertex, vertex, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(vertex, vertex, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, col0), _mm_mul_ps(y, col1)), col3);
+            float v = in[i].texCoords.y;
+            _mm_storeu_ps(&out[i].position.x, _mm_shuffle_ps(position, vertex, _MM_SHUFFLE(3, 2, 1, 0)));
+            out[i].texCoords.y = v;
+        }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+        const float32x4_t col0 = {m[0], m[1], 0.f, 0.f};
+        const float32x4_t col1 = {m[4], m[5], 0.f, 0.f};
+        const float32x4_t col3 = {m[12], m[13], 0.f, 0.f};
+
+        for (; i < count; ++i)
+        {
+            float32x4_t vertex = vld1q_f32(&in[i].position.x);
+            float32x4_t position = vaddq_f32(vaddq_f32(vmulq_n_f32(col0, vgetq_lane_f32(vertex, 0)), vmulq_n_f32(col1, vgetq_lane_f32(vertex, 1))), col3);
+            float v = in[i].texCoords.y;
+            vst1q_f32(&out[i].position.x, vcombine_f32(vget_low_f32(position), vget_high_f32(vertex)));
+            out[i].texCoords.y = v;
+        }
+
+#endif
+
+        // Remaining vertices
+        for (; i < count; ++i)
+        {
+            sf::Vector2f position = in[i].position;
+            out[i] = in[i];
+            out[i].position.x = m[0] * position.x + m[4] * position.y + m[12];
+            out[i].position.y = m[1] * position.x + m[5] * position.y + m[13];
+        }
+    }
+
+    // Same as above for 3D vertices, the lane following the position is the color
+    void transformVertices(const float* m, const sf::Vertex3D* in, sf::Vertex3D* out, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE)
+
+        const __m128 col0 = _mm_setr_ps(m[0], m[1], m[2], 0.f);
+        const __m128 col1 = _mm_setr_ps(m[4], m[5], m[6], 0.f);
+        const __m128 col2 = _mm_setr_ps(m[8], m[9], m[10], 0.f);
+        const __m128 col3 = _mm_setr_ps(m[12], m[13], m[14], 0.f);
+
+        for (; i < count; ++i)
+        {
+            __m128 vertex = _mm_loadu_ps(&in[i].position.x);
+            __m128 x = _mm_shuffle_ps(vertex, vertex, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 y = _mm_shuffle_ps(vertex, vertex, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 z = _mm_shuffle_ps(vertex, vertex, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 position = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, col0), _mm_mul_ps(y, col1)), _mm_mul_ps(z, col2)), col3);
+
+            // (x, y, z, color) from (x', y', z', w') and (x, y, z, color)
+            __m128 high = _mm_unpackhi_ps(position, vertex);
+            sf::Vector2f texCoords = in[i].texCoords;
+            _mm_storeu_ps(&out[i].position.x, _mm_shuffle_ps(position, high, _MM_SHUFFLE(3, 0, 1, 0)));
+            out[i].texCoords = texCoords;
+        }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+        const float32x4_t col0 = {m[0], m[1], m[2], 0.f};
+        const float32x4_t col1 = {m[4], m[5], m[6], 0.f};
+        const float32x4_t col2 = {m[8], m[9], m[10], 0.f};
+        const float32x4_t col3 = {m[12], m[13], m[14], 0.f};
+
+        for (; i < count; ++i)
+        {
+            float32x4_t vertex = vld1q_f32(&in[i].position.x);
+            float32x4_t position = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(col0, vgetq_lane_f32(vertex, 0)),
+                                                                 vmulq_n_f32(col1, vgetq_lane_f32(vertex, 1))),
+                                                       vmulq_n_f32(col2, vgetq_lane_f32(vertex, 2))),
+                                             col3);
+            sf::Vector2f texCoords = in[i].texCoords;
+            vst1q_f32(&out[i].position.x, vsetq_lane_f32(vgetq_lane_f32(vertex, 3), position, 3));
+            out[i].texCoords = texCoords;
+        }
+
+#endif
+
+        // Remaining vertices
+        for (; i < count; ++i)
+        {
+            sf::Vector3f position = in[i].position;
+            out[i] = in[i];
+            out[i].position.x = m[0] * position.x + m[4] * position.y + m[8]  * position.z + m[12];
+            out[i].position.y = m[1] * position.x + m[5] * position.y + m[9]  * position.z + m[13];
+            out[i].position.z = m[2] * position.x + m[6] * position.y + m[10] * position.z + m[14];
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -144,6 +338,28 @@ Vector3f Transform::transformPoint(const Vector3f& point) const noexcept
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* points, Vector2f* result, std::size_t count) const noexcept
+{
+    // Vector2f is two packed floats, the array can be processed in place
+    transform2D(m_matrix.data(), &points->x, &result->x, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex* vertices, Vertex* result, std::size_t count) const noexcept
+{
+    transformVertices(m_matrix.data(), vertices, result, count);
+}
+
+
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vertex3D* vertices, Vertex3D* result, std::size_t count) const noexcept
+{
+    transformVertices(m_matrix.data(), vertices, result, count);
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const noexcept
 {
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2021 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                        return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer(VertexBuffer::Usage usage) :
+m_buffer(0),
+m_size  (0),
+m_usage (usage)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+    if (m_buffer)
+    {
+        TransientContextLock contextLock;
+
+        glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t size)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create uniform buffer: your system doesn't support uniform buffers "
+              << "(you should test UniformBuffer::isAvailable() before trying to use the UniformBuffer class)" << std::endl;
+        return false;
+    }
+
+    TransientContextLock contextLock;
+
+    if (!m_buffer)
+        glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+
+    if (!m_buffer)
+    {
+        err() << "Could not create uniform buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    m_size = size;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(const void* data, std::size_t size, std::size_t offset)
+{
+    // Sanity checks
+    if (!m_buffer || !data)
+        return false;
+
+    if (offset + size > m_size)
+    {
+        err() << "Failed to update uniform buffer: " << size << " bytes at offset " << offset
+              << " don't fit in a buffer of " << m_size << " bytes" << std::endl;
+        return false;
+    }
+
+    TransientContextLock contextLock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+
+    // Replace the whole storage when possible, the driver doesn't have to wait for the draws using the previous contents
+    if ((offset == 0) && (size == m_size))
+        glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), data, usageToGlEnum(m_usage)));
+    else
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage UniformBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        if (!VertexBuffer::isAvailable() || !Shader::isAvailable())
+            return false;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_uniform_buffer_object;
+    }
+
+    return available;
+}
+
+} // namespace sf
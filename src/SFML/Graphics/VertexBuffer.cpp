@@ -28,6 +28,7 @@
 #include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Vertex3D.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
@@ -37,6 +38,18 @@
 namespace
 {
     sf::Mutex isAvailableMutex;
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no vertex buffer"
+
+        return id++;
+    }
 
     GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
     {
@@ -57,7 +70,9 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (Layout2D),
+m_cacheId      (getUniqueId())
 {
 }
 
@@ -67,7 +82,9 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (Layout2D),
+m_cacheId      (getUniqueId())
 {
 }
 
@@ -77,7 +94,9 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (Layout2D),
+m_cacheId      (getUniqueId())
 {
 }
 
@@ -87,7 +106,21 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (Layout2D),
+m_cacheId      (getUniqueId())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage, VertexLayout layout) :
+m_buffer       (0),
+m_size         (0),
+m_primitiveType(type),
+m_usage        (usage),
+m_layout       (layout),
+m_cacheId      (getUniqueId())
 {
 }
 
@@ -97,7 +130,9 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_layout       (copy.m_layout),
+m_cacheId      (getUniqueId())
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -143,10 +178,11 @@ bool VertexBuffer::create(std::size_t vertexCount)
     }
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, getVertexSize() * vertexCount, 0, usageToGlEnum(m_usage)));
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
     m_size = vertexCount;
+    m_cacheId = getUniqueId();
 
     return true;
 }
@@ -169,33 +205,27 @@ bool VertexBuffer::update(const Vertex* vertices)
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
 {
-    // Sanity checks
-    if (!m_buffer)
-        return false;
-
-    if (!vertices)
-        return false;
-
-    if (offset && (offset + vertexCount > m_size))
+    if (m_layout != Layout2D)
         return false;
 
-    TransientContextLock contextLock;
+    return updateData(vertices, vertexCount, offset);
+}
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
 
-    // Check if we need to resize or orphan the buffer
-    if (vertexCount >= m_size)
-    {
-        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
-
-        m_size = vertexCount;
-    }
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex3D* vertices)
+{
+    return update(vertices, m_size, 0);
+}
 
-    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount, vertices));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex3D* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    if (m_layout != Layout3D)
+        return false;
 
-    return true;
+    return updateData(vertices, vertexCount, offset);
 }
 
 
@@ -211,17 +241,27 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     if (!m_buffer || !vertexBuffer.m_buffer)
         return false;
 
+    if (m_layout != vertexBuffer.m_layout)
+        return false;
+
+    // The copied vertices must fit in the storage of this buffer
+    if (vertexBuffer.m_size > m_size)
+        return false;
+
     TransientContextLock contextLock;
 
     // Make sure that extensions are initialized
     sf::priv::ensureExtensionsInit();
 
+    // The contents are about to change
+    m_cacheId = getUniqueId();
+
     if (GLEXT_copy_buffer)
     {
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
 
-        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, sizeof(Vertex) * vertexBuffer.m_size));
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, getVertexSize() * vertexBuffer.m_size));
 
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
@@ -230,7 +270,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     }
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, getVertexSize() * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
 
     void* destination = 0;
     glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
@@ -240,7 +280,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     void* source = 0;
     glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
 
-    std::memcpy(destination, source, sizeof(Vertex) * vertexBuffer.m_size);
+    std::memcpy(destination, source, getVertexSize() * vertexBuffer.m_size);
 
     GLboolean sourceResult = GL_FALSE;
     glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
@@ -279,6 +319,8 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_layout,        right.m_layout);
+    std::swap(m_cacheId,       right.m_cacheId);
 }
 
 
@@ -329,6 +371,38 @@ VertexBuffer::Usage VertexBuffer::getUsage() const
 }
 
 
+////////////////////////////////////////////////////////////
+void VertexBuffer::setVertexLayout(VertexLayout layout)
+{
+    if (layout == m_layout)
+        return;
+
+    m_layout = layout;
+
+    // The storage was allocated for the previous vertex size: forget its
+    // contents so that nothing is read or written until it is created again
+    if (m_buffer)
+    {
+        m_size = 0;
+        m_cacheId = getUniqueId();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexLayout VertexBuffer::getVertexLayout() const
+{
+    return m_layout;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getVertexSize() const
+{
+    return (m_layout == Layout3D) ? sizeof(Vertex3D) : sizeof(Vertex);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::isAvailable()
 {
@@ -360,4 +434,41 @@ void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
         target.draw(*this, 0, m_size, states);
 }
 
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::updateData(const void* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (!vertices)
+        return false;
+
+    if (offset && (offset + vertexCount > m_size))
+        return false;
+
+    TransientContextLock contextLock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    std::size_t vertexSize = getVertexSize();
+
+    // Check if we need to resize or orphan the buffer
+    if (vertexCount >= m_size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, vertexSize * vertexCount, 0, usageToGlEnum(m_usage)));
+
+        m_size = vertexCount;
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, vertexSize * offset, vertexSize * vertexCount, vertices));
+
+    m_cacheId = getUniqueId();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
 } // namespace sf
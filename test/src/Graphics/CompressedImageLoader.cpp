@@ -0,0 +1,349 @@
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    void writeUint32(std::vector<sf::Uint8>& data, std::size_t offset, sf::Uint32 value)
+    {
+        data[offset]     = static_cast<sf::Uint8>(value);
+        data[offset + 1] = static_cast<sf::Uint8>(value >> 8);
+        data[offset + 2] = static_cast<sf::Uint8>(value >> 16);
+        data[offset + 3] = static_cast<sf::Uint8>(value >> 24);
+    }
+
+    // Append the blocks of a level, filled with a value identifying the level
+    void appendLevel(std::vector<sf::Uint8>& data, std::size_t byteCount, sf::Uint8 value)
+    {
+        data.insert(data.end(), byteCount, value);
+    }
+
+    // Build the header of a DDS file, with the "DX10" extension if dxgiFormat is not zero
+    std::vector<sf::Uint8> makeDdsHeader(sf::Uint32 width, sf::Uint32 height, sf::Uint32 mipMapCount, sf::Uint32 dxgiFormat = 0, sf::Uint32 arraySize = 1)
+    {
+        std::vector<sf::Uint8> data(dxgiFormat ? 148 : 128, 0);
+        data[0] = 'D'; data[1] = 'D'; data[2] = 'S'; data[3] = ' ';
+
+        writeUint32(data, 4, 124);                // Size of the header
+        writeUint32(data, 8, 0x1007 | 0x20000);   // Flags, with DDSD_MIPMAPCOUNT
+        writeUint32(data, 12, height);
+        writeUint32(data, 16, width);
+        writeUint32(data, 28, mipMapCount);
+        writeUint32(data, 76, 32);                // Size of the pixel format
+        writeUint32(data, 80, 0x4);               // DDPF_FOURCC
+        data[84] = 'D';                           // "DX10" or "DXT1"
+        data[85] = 'X';
+        data[86] = dxgiFormat ? '1' : 'T';
+        data[87] = dxgiFormat ? '0' : '1';
+
+        if (dxgiFormat)
+        {
+            writeUint32(data, 128, dxgiFormat);
+            writeUint32(data, 132, 3);            // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+            writeUint32(data, 140, arraySize);
+        }
+
+        return data;
+    }
+
+    // Build a BC1 DDS file of 8x8 pixels with its whole mipmap chain (8x8, 4x4, 2x2 and 1x1)
+    std::vector<sf::Uint8> makeDds()
+    {
+        std::vector<sf::Uint8> data = makeDdsHeader(8, 8, 4);
+        appendLevel(data, 32, 1);
+        appendLevel(data, 8, 2);
+        appendLevel(data, 8, 3);
+        appendLevel(data, 8, 4);
+        return data;
+    }
+
+    // Build the header of a KTX file
+    std::vector<sf::Uint8> makeKtxHeader(sf::Uint32 width, sf::Uint32 height, sf::Uint32 mipMapCount, sf::Uint32 keyValueBytes = 0)
+    {
+        const sf::Uint8 signature[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+        std::vector<sf::Uint8> data(signature, signature + 12);
+        data.resize(64, 0);
+
+        writeUint32(data, 12, 0x04030201);        // Endianness
+        writeUint32(data, 28, 0x83F1);            // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+        writeUint32(data, 32, 0x1908);            // GL_RGBA
+        writeUint32(data, 36, width);
+        writeUint32(data, 40, height);
+        writeUint32(data, 52, 1);                 // Number of faces
+        writeUint32(data, 56, mipMapCount);
+        writeUint32(data, 60, keyValueBytes);
+
+        return data;
+    }
+
+    // Append a KTX level, preceded by its size
+    void appendKtxLevel(std::vector<sf::Uint8>& data, sf::Uint32 byteCount, sf::Uint8 value)
+    {
+        data.resize(data.size() + 4);
+        writeUint32(data, data.size() - 4, byteCount);
+        appendLevel(data, byteCount, value);
+    }
+
+    // Build a BC1 KTX file of 8x8 pixels with its whole mipmap chain and some key/value data
+    std::vector<sf::Uint8> makeKtx()
+    {
+        std::vector<sf::Uint8> data = makeKtxHeader(8, 8, 4, 8);
+        appendLevel(data, 8, 0);
+        appendKtxLevel(data, 32, 1);
+        appendKtxLevel(data, 8, 2);
+        appendKtxLevel(data, 8, 3);
+        appendKtxLevel(data, 8, 4);
+        return data;
+    }
+
+    bool parse(const std::vector<sf::Uint8>& data, sf::priv::CompressedImage& image)
+    {
+        return sf::priv::parseCompressedImage(&data[0], data.size(), image);
+    }
+
+    bool parse(const std::vector<sf::Uint8>& data)
+    {
+        sf::priv::CompressedImage image;
+        return parse(data, image);
+    }
+
+    // Check the levels of the images built by makeDds and makeKtx
+    void checkLevels(const std::vector<sf::Uint8>& data, const sf::priv::CompressedImage& image)
+    {
+        CHECK(image.format == sf::priv::CompressedImage::Bc1);
+        CHECK(image.size == sf::Vector2u(8, 8));
+        REQUIRE(image.levels.size() == 4);
+
+        const sf::Vector2u sizes[4] = {sf::Vector2u(8, 8), sf::Vector2u(4, 4), sf::Vector2u(2, 2), sf::Vector2u(1, 1)};
+        const std::size_t byteCounts[4] = {32, 8, 8, 8};
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            const sf::Uint8* level = static_cast<const sf::Uint8*>(image.levels[i].data);
+
+            CHECK(image.levels[i].size == sizes[i]);
+            CHECK(image.levels[i].byteCount == byteCounts[i]);
+            CHECK(level >= &data[0]);
+            CHECK(level + byteCounts[i] <= &data[0] + data.size());
+            CHECK(level[0] == i + 1);
+            CHECK(level[byteCounts[i] - 1] == i + 1);
+        }
+    }
+}
+
+TEST_CASE("sf::priv::parseCompressedImage function", "[graphics]")
+{
+    SECTION("Signatures")
+    {
+        CHECK(sf::priv::isCompressedImage(&makeDds()[0], 128) == true);
+        CHECK(sf::priv::isCompressedImage(&makeKtx()[0], 64) == true);
+
+        const sf::Uint8 png[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        CHECK(sf::priv::isCompressedImage(png, sizeof(png)) == false);
+        CHECK(sf::priv::isCompressedImage(png, 0) == false);
+
+        sf::priv::CompressedImage image;
+        CHECK(sf::priv::parseCompressedImage(png, sizeof(png), image) == false);
+    }
+
+    SECTION("DDS")
+    {
+        SECTION("BC1 with a mipmap chain")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            sf::priv::CompressedImage image;
+
+            REQUIRE(parse(data, image) == true);
+            checkLevels(data, image);
+        }
+
+        SECTION("DX10 header")
+        {
+            std::vector<sf::Uint8> data = makeDdsHeader(4, 4, 1, 71); // DXGI_FORMAT_BC1_UNORM
+            appendLevel(data, 8, 1);
+            sf::priv::CompressedImage image;
+
+            REQUIRE(parse(data, image) == true);
+            CHECK(image.format == sf::priv::CompressedImage::Bc1);
+            REQUIRE(image.levels.size() == 1);
+            CHECK(image.levels[0].data == &data[148]);
+        }
+
+        SECTION("Levels past the 1x1 one are ignored")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            writeUint32(data, 28, 6);
+            appendLevel(data, 8, 5);
+            appendLevel(data, 8, 6);
+            sf::priv::CompressedImage image;
+
+            REQUIRE(parse(data, image) == true);
+            checkLevels(data, image);
+
+            // Non-square images stop at the level where the largest side is 1
+            data = makeDdsHeader(8, 2, 10);
+            appendLevel(data, 16, 1);
+            appendLevel(data, 8, 2);
+            appendLevel(data, 8, 3);
+            appendLevel(data, 8, 4);
+            appendLevel(data, 8, 5);
+
+            REQUIRE(parse(data, image) == true);
+            REQUIRE(image.levels.size() == 4);
+            CHECK(image.levels[3].size == sf::Vector2u(1, 1));
+        }
+
+        SECTION("Truncated level")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            data.pop_back();
+            CHECK(parse(data) == false);
+
+            data.resize(128 + 31);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Bad header size")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            writeUint32(data, 4, 128);
+            CHECK(parse(data) == false);
+
+            data = makeDds();
+            data.resize(100);
+            CHECK(parse(data) == false);
+
+            // The DX10 extension doesn't fit
+            data = makeDdsHeader(4, 4, 1, 71);
+            data.resize(140);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Cube maps and arrays are rejected")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            writeUint32(data, 112, 0x200 | 0xFC00); // DDSCAPS2_CUBEMAP with all faces
+            CHECK(parse(data) == false);
+
+            data = makeDdsHeader(4, 4, 1, 71, 2);
+            appendLevel(data, 16, 1);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Empty images are rejected")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            writeUint32(data, 16, 0);
+            CHECK(parse(data) == false);
+
+            data = makeDds();
+            writeUint32(data, 12, 0);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Uncompressed formats are rejected")
+        {
+            std::vector<sf::Uint8> data = makeDds();
+            writeUint32(data, 80, 0x40); // DDPF_RGB
+            CHECK(parse(data) == false);
+        }
+    }
+
+    SECTION("KTX")
+    {
+        SECTION("BC1 with a mipmap chain")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            sf::priv::CompressedImage image;
+
+            REQUIRE(parse(data, image) == true);
+            checkLevels(data, image);
+        }
+
+        SECTION("Levels past the 1x1 one are ignored")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            writeUint32(data, 56, 6);
+            appendKtxLevel(data, 8, 5);
+            appendKtxLevel(data, 8, 6);
+            sf::priv::CompressedImage image;
+
+            REQUIRE(parse(data, image) == true);
+            checkLevels(data, image);
+        }
+
+        SECTION("Truncated level")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            data.pop_back();
+            CHECK(parse(data) == false);
+
+            // Size of the last level missing
+            data = makeKtx();
+            data.resize(data.size() - 10);
+            CHECK(parse(data) == false);
+
+            // Level smaller than its size in pixels
+            data = makeKtxHeader(8, 8, 1);
+            appendKtxLevel(data, 16, 1);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Bad header")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            data.resize(60);
+            CHECK(parse(data) == false);
+
+            // Big-endian file
+            data = makeKtx();
+            writeUint32(data, 12, 0x01020304);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Oversized key/value data")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            writeUint32(data, 60, 0xFFFFFFF0);
+            CHECK(parse(data) == false);
+
+            data = makeKtx();
+            writeUint32(data, 60, static_cast<sf::Uint32>(data.size()));
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Cube maps and arrays are rejected")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            writeUint32(data, 52, 6);
+            CHECK(parse(data) == false);
+
+            data = makeKtx();
+            writeUint32(data, 48, 2);
+            CHECK(parse(data) == false);
+
+            data = makeKtx();
+            writeUint32(data, 44, 2);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Empty images are rejected")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            writeUint32(data, 36, 0);
+            CHECK(parse(data) == false);
+
+            data = makeKtx();
+            writeUint32(data, 40, 0);
+            CHECK(parse(data) == false);
+        }
+
+        SECTION("Uncompressed formats are rejected")
+        {
+            std::vector<sf::Uint8> data = makeKtx();
+            writeUint32(data, 16, 0x1401); // GL_UNSIGNED_BYTE
+            writeUint32(data, 28, 0x8058); // GL_RGBA8
+            CHECK(parse(data) == false);
+        }
+    }
+}
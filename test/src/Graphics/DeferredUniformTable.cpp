@@ -0,0 +1,133 @@
+#include <SFML/Graphics/DeferredUniformTable.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Record the uploads instead of writing them to a program
+    struct RecordingUploader
+    {
+        struct Upload
+        {
+            int                location;
+            std::size_t        components;
+            std::size_t        count;
+            std::vector<float> floats;
+            std::vector<int>   ints;
+        };
+
+        void operator()(int location, std::size_t components, std::size_t count, const float* values)
+        {
+            Upload upload = {location, components, count, std::vector<float>(values, values + components * count), std::vector<int>()};
+            uploads.push_back(upload);
+        }
+
+        void operator()(int location, std::size_t components, std::size_t count, const int* values)
+        {
+            Upload upload = {location, components, count, std::vector<float>(), std::vector<int>(values, values + components * count)};
+            uploads.push_back(upload);
+        }
+
+        std::vector<Upload> uploads;
+    };
+}
+
+TEST_CASE("sf::priv::DeferredUniformTable class", "[graphics]")
+{
+    SECTION("Empty table")
+    {
+        sf::priv::DeferredUniformTable table;
+        RecordingUploader uploader;
+
+        CHECK(table.hasPending() == false);
+        table.upload(uploader);
+        CHECK(uploader.uploads.empty());
+    }
+
+    SECTION("Upload of stored values")
+    {
+        sf::priv::DeferredUniformTable table;
+        RecordingUploader uploader;
+
+        const float vector[2] = {1.f, 2.f};
+        const int   integer   = 7;
+        table.store(3, 2, 1, vector);
+        table.store(5, 1, 1, &integer);
+        CHECK(table.hasPending() == true);
+
+        table.upload(uploader);
+        REQUIRE(uploader.uploads.size() == 2);
+        CHECK(uploader.uploads[0].location == 3);
+        CHECK(uploader.uploads[0].components == 2);
+        CHECK(uploader.uploads[0].count == 1);
+        CHECK(uploader.uploads[0].floats == std::vector<float>(vector, vector + 2));
+        CHECK(uploader.uploads[1].location == 5);
+        CHECK(uploader.uploads[1].ints == std::vector<int>(1, integer));
+        CHECK(table.hasPending() == false);
+
+        // Uploaded values are not uploaded again
+        table.upload(uploader);
+        CHECK(uploader.uploads.size() == 2);
+    }
+
+    SECTION("Last stored value wins")
+    {
+        sf::priv::DeferredUniformTable table;
+        RecordingUploader uploader;
+
+        const float first  = 1.f;
+        const int   second = 2;
+        table.store(3, 1, 1, &first);
+        table.store(3, 1, 1, &second);
+
+        table.upload(uploader);
+        REQUIRE(uploader.uploads.size() == 1);
+        CHECK(uploader.uploads[0].floats.empty());
+        CHECK(uploader.uploads[0].ints == std::vector<int>(1, second));
+    }
+
+    SECTION("Discarded values are not uploaded")
+    {
+        // Set deferred, disable deferral (upload), set immediately (discard), then bind (upload)
+        sf::priv::DeferredUniformTable table;
+        RecordingUploader uploader;
+
+        const float deferred = 1.f;
+        table.store(3, 1, 1, &deferred);
+        table.upload(uploader);
+        CHECK(uploader.uploads.size() == 1);
+
+        table.discard(3);
+        table.upload(uploader);
+        CHECK(uploader.uploads.size() == 1);
+
+        // Same without the upload when deferral is disabled
+        table.store(3, 1, 1, &deferred);
+        table.discard(3);
+        CHECK(table.hasPending() == false);
+        table.upload(uploader);
+        CHECK(uploader.uploads.size() == 1);
+    }
+
+    SECTION("Discard of an unknown location")
+    {
+        sf::priv::DeferredUniformTable table;
+
+        table.discard(3);
+        CHECK(table.hasPending() == false);
+    }
+
+    SECTION("Clear")
+    {
+        sf::priv::DeferredUniformTable table;
+        RecordingUploader uploader;
+
+        const float value = 1.f;
+        table.store(3, 1, 1, &value);
+        table.clear();
+
+        CHECK(table.hasPending() == false);
+        table.upload(uploader);
+        CHECK(uploader.uploads.empty());
+    }
+}
@@ -0,0 +1,71 @@
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include "GraphicsUtil.hpp"
+#include <cstring>
+
+namespace
+{
+    const unsigned int characterSize = 32;
+
+    sf::Image render(const sf::Text& text)
+    {
+        sf::RenderTexture target;
+        REQUIRE(target.create(1024, 128));
+
+        target.clear(sf::Colors::Transparent);
+        target.draw(text);
+        target.display();
+
+        return target.getTexture().copyToImage();
+    }
+
+    bool haveSamePixels(const sf::Image& left, const sf::Image& right)
+    {
+        return (left.getSize() == right.getSize()) &&
+               (std::memcmp(left.getPixelsPtr(), right.getPixelsPtr(), left.getSize().x * left.getSize().y * 4) == 0);
+    }
+}
+
+TEST_CASE("sf::Font class - page memory budget", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    sf::Font reference;
+    REQUIRE(reference.loadFromFile("resources/tuffy.ttf"));
+
+    // The smallest budget limits the pages to their initial size
+    sf::Font font;
+    REQUIRE(font.loadFromFile("resources/tuffy.ttf"));
+    font.setPageMemoryBudget(1);
+    const sf::Vector2u initialSize = font.getTexture(characterSize).getSize();
+
+    SECTION("Glyphs of a text larger than the budget")
+    {
+        const sf::String string = "ABCDEFGHIJKLMNOPQRSTUVWXYZ\nabcdefghijklmnopqrstuvwxyz";
+        sf::Text text(string, font, characterSize);
+        sf::Image expected = render(sf::Text(string, reference, characterSize));
+
+        // The glyphs of the text are not evicted for each other, the page grows instead
+        CHECK(haveSamePixels(render(text), expected));
+        CHECK(font.getTexture(characterSize).getSize().x > initialSize.x);
+
+        // The texture doesn't change anymore once all the glyphs are loaded
+        sf::Vector2u size = font.getTexture(characterSize).getSize();
+        CHECK(haveSamePixels(render(text), expected));
+        CHECK(haveSamePixels(render(text), expected));
+        CHECK(font.getTexture(characterSize).getSize() == size);
+    }
+
+    SECTION("Glyphs requested outside of a text")
+    {
+        // The page stays within the budget, the least recently used glyphs are evicted
+        for (sf::Uint32 codePoint = L'!'; codePoint <= L'~'; ++codePoint)
+            font.getGlyph(codePoint, characterSize, false);
+
+        CHECK(font.getTexture(characterSize).getSize() == initialSize);
+
+        sf::Text text("Evicted glyphs", font, characterSize);
+        CHECK(haveSamePixels(render(text), render(sf::Text("Evicted glyphs", reference, characterSize))));
+        CHECK(font.getTexture(characterSize).getSize() == initialSize);
+    }
+}
@@ -0,0 +1,194 @@
+#include <SFML/Graphics/GlyphTable.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Same hash as the table, for a table of 128 slots (its initial size)
+    std::size_t getInitialHomeSlot(sf::Uint64 key)
+    {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 57);
+    }
+
+    // Find keys whose home slot is the given one, to build clusters on purpose
+    std::vector<sf::Uint64> findKeys(std::size_t homeSlot, std::size_t count)
+    {
+        std::vector<sf::Uint64> keys;
+        for (sf::Uint64 key = 1; keys.size() < count; ++key)
+        {
+            if (getInitialHomeSlot(key) == homeSlot)
+                keys.push_back(key);
+        }
+
+        return keys;
+    }
+
+    sf::Glyph makeGlyph(sf::Uint64 key)
+    {
+        sf::Glyph glyph;
+        glyph.advance = static_cast<float>(key);
+        glyph.textureRect = sf::IntRect(static_cast<int>(key), 0, 1, 1);
+        return glyph;
+    }
+
+    // Check that every key is found with its own glyph
+    bool containsAll(sf::priv::GlyphTable& table, const std::vector<sf::Uint64>& keys)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            sf::priv::GlyphTable::Entry* entry = table.find(keys[i]);
+            if (!entry || (entry->key != keys[i]) || (entry->glyph.textureRect.left != static_cast<int>(keys[i])))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+TEST_CASE("sf::priv::GlyphTable class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        sf::priv::GlyphTable table;
+
+        CHECK(table.getSize() == 0);
+        CHECK(table.find(0) == NULL);
+        CHECK(table.find(42) == NULL);
+        CHECK(table.findLeastRecentlyUsed() == NULL);
+    }
+
+    SECTION("Insertion and lookup")
+    {
+        sf::priv::GlyphTable table;
+
+        sf::priv::GlyphTable::Entry& entry = table.insert(42, makeGlyph(42));
+        CHECK(entry.key == 42);
+        CHECK(entry.glyph.advance == 42.f);
+        CHECK(entry.lastUse == 0);
+        CHECK(table.getSize() == 1);
+        CHECK(table.find(42) == &entry);
+        CHECK(table.find(43) == NULL);
+    }
+
+    SECTION("Growth")
+    {
+        // 1000 glyphs make the table grow from 128 to 2048 slots
+        sf::priv::GlyphTable table;
+        std::vector<sf::Uint64> keys;
+        std::vector<sf::priv::GlyphTable::Entry*> entries;
+
+        for (sf::Uint64 key = 0; key < 1000; ++key)
+        {
+            keys.push_back(key * 3);
+            entries.push_back(&table.insert(key * 3, makeGlyph(key * 3)));
+        }
+
+        CHECK(table.getSize() == 1000);
+        CHECK(containsAll(table, keys));
+        CHECK(table.find(1) == NULL);
+        CHECK(table.find(3000) == NULL);
+
+        // The entries stay at the same address whatever the table does
+        bool stable = true;
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            stable = stable && (table.find(keys[i]) == entries[i]);
+        CHECK(stable);
+    }
+
+    SECTION("Erasure")
+    {
+        SECTION("Erased entries are reused")
+        {
+            sf::priv::GlyphTable table;
+            sf::priv::GlyphTable::Entry* first = &table.insert(1, makeGlyph(1));
+            sf::priv::GlyphTable::Entry* second = &table.insert(2, makeGlyph(2));
+
+            table.erase(first);
+            CHECK(table.getSize() == 1);
+            CHECK(table.find(1) == NULL);
+            CHECK(table.find(2) == second);
+
+            sf::priv::GlyphTable::Entry* third = &table.insert(3, makeGlyph(3));
+            CHECK(third == first);
+            CHECK(third->key == 3);
+            CHECK(third->lastUse == 0);
+            CHECK(table.find(2) == second);
+        }
+
+        SECTION("Erasure inside clusters wrapping around the end of the table")
+        {
+            // Clusters starting at the last two slots continue at the beginning
+            std::vector<sf::Uint64> keys = findKeys(126, 4);
+            std::vector<sf::Uint64> next = findKeys(127, 2);
+            std::vector<sf::Uint64> first = findKeys(0, 2);
+            keys.insert(keys.end(), next.begin(), next.end());
+            keys.insert(keys.end(), first.begin(), first.end());
+
+            for (std::size_t removed = 0; removed < keys.size(); ++removed)
+            {
+                sf::priv::GlyphTable table;
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                    table.insert(keys[i], makeGlyph(keys[i]));
+
+                // Erase one key, then the others in an order going back and forth in the cluster
+                std::vector<sf::Uint64> remaining = keys;
+                std::size_t index = removed;
+                while (!remaining.empty())
+                {
+                    sf::priv::GlyphTable::Entry* entry = table.find(remaining[index]);
+                    REQUIRE(entry != NULL);
+                    table.erase(entry);
+
+                    CHECK(table.find(remaining[index]) == NULL);
+                    remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(index));
+
+                    CHECK(table.getSize() == remaining.size());
+                    CHECK(containsAll(table, remaining));
+
+                    if (!remaining.empty())
+                        index = (index + 3) % remaining.size();
+                }
+            }
+        }
+
+        SECTION("Erasure after growth")
+        {
+            sf::priv::GlyphTable table;
+            std::vector<sf::Uint64> keys;
+            for (sf::Uint64 key = 0; key < 300; ++key)
+            {
+                keys.push_back(key * 7 + 1);
+                table.insert(keys.back(), makeGlyph(keys.back()));
+            }
+
+            // Erase every other key from the middle of the table
+            std::vector<sf::Uint64> remaining;
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                if ((i % 2 == 0) && (i > 50) && (i < 250))
+                    table.erase(table.find(keys[i]));
+                else
+                    remaining.push_back(keys[i]);
+            }
+
+            CHECK(table.getSize() == remaining.size());
+            CHECK(containsAll(table, remaining));
+        }
+    }
+
+    SECTION("findLeastRecentlyUsed")
+    {
+        sf::priv::GlyphTable table;
+        for (sf::Uint64 key = 0; key < 100; ++key)
+            table.insert(key, makeGlyph(key)).lastUse = 1000 - key * 5 % 97;
+
+        sf::priv::GlyphTable::Entry* coldest = table.findLeastRecentlyUsed();
+        REQUIRE(coldest != NULL);
+        CHECK(coldest->lastUse == 1000 - 96);
+
+        table.erase(coldest);
+        coldest = table.findLeastRecentlyUsed();
+        REQUIRE(coldest != NULL);
+        CHECK(coldest->lastUse == 1000 - 95);
+    }
+}
@@ -0,0 +1,444 @@
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Widths around the sizes of the vectorized loops, to cover their remainders
+    const unsigned int widths[] = {1, 3, 4, 7, 8, 9, 17, 33};
+    const unsigned int height = 3;
+
+    // Generate reproducible pixels, with a lot of fully opaque and fully transparent ones
+    std::vector<sf::Uint8> makePixels(unsigned int width, unsigned int seed)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        sf::Uint32 state = seed * 2654435761u + 1;
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            sf::Uint8 value = static_cast<sf::Uint8>(state >> 24);
+            switch ((state >> 8) % 8)
+            {
+                case 0:  pixels[i] = 0;     break;
+                case 1:  pixels[i] = 255;   break;
+                default: pixels[i] = value; break;
+            }
+        }
+
+        return pixels;
+    }
+
+    sf::Uint8 divide255(unsigned int value)
+    {
+        return static_cast<sf::Uint8>(value / 255);
+    }
+
+    sf::Uint8 divide255Rounded(unsigned int value)
+    {
+        return static_cast<sf::Uint8>((value + 127) / 255);
+    }
+
+    sf::Uint8 saturate(unsigned int value)
+    {
+        return static_cast<sf::Uint8>(value > 255 ? 255 : value);
+    }
+
+    // Scalar version of the blending equations of sf::Image::blit
+    void blend(const sf::Uint8* src, const sf::Uint8* dst, sf::Image::Blending blending, sf::Uint8* result)
+    {
+        unsigned int alpha = src[3];
+        for (int i = 0; i < 4; ++i)
+        {
+            switch (blending)
+            {
+                case sf::Image::Replace:
+                    result[i] = src[i];
+                    break;
+
+                case sf::Image::Alpha:
+                    if (i < 3)
+                        result[i] = divide255(src[i] * alpha + dst[i] * (255 - alpha));
+                    else
+                        result[i] = static_cast<sf::Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+                    break;
+
+                case sf::Image::Add:
+                    result[i] = saturate(dst[i] + (i < 3 ? divide255Rounded(src[i] * alpha) : alpha));
+                    break;
+
+                case sf::Image::Multiply:
+                    result[i] = divide255Rounded(src[i] * dst[i]);
+                    break;
+
+                case sf::Image::PremultipliedAlpha:
+                    result[i] = saturate(src[i] + divide255Rounded(dst[i] * (255 - alpha)));
+                    break;
+            }
+        }
+    }
+
+    // Check every pixel of an image against the expected components
+    bool hasPixels(const sf::Image& image, const std::vector<sf::Uint8>& expected)
+    {
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if (pixels[i] != expected[i])
+                return false;
+        }
+
+        return expected.size() == image.getSize().x * image.getSize().y * 4;
+    }
+}
+
+TEST_CASE("sf::Image class - pixel operations", "[graphics]")
+{
+    SECTION("blit")
+    {
+        const sf::Image::Blending modes[] = {sf::Image::Replace, sf::Image::Alpha, sf::Image::Add, sf::Image::Multiply, sf::Image::PremultipliedAlpha};
+
+        for (std::size_t m = 0; m < 5; ++m)
+        {
+            for (std::size_t w = 0; w < 8; ++w)
+            {
+                const unsigned int width = widths[w];
+                std::vector<sf::Uint8> src = makePixels(width, 1);
+                std::vector<sf::Uint8> dst = makePixels(width, 2);
+
+                std::vector<sf::Uint8> expected(dst.size());
+                for (std::size_t i = 0; i < dst.size(); i += 4)
+                    blend(&src[i], &dst[i], modes[m], &expected[i]);
+
+                sf::Image source;
+                sf::Image destination;
+                source.create(width, height, &src[0]);
+                destination.create(width, height, &dst[0]);
+                destination.blit(source, 0, 0, sf::IntRect(0, 0, 0, 0), modes[m]);
+
+                INFO("Blending " << m << ", width " << width);
+                CHECK(hasPixels(destination, expected));
+            }
+        }
+    }
+
+    SECTION("blit of a sub-rectangle")
+    {
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const unsigned int width = widths[w];
+            std::vector<sf::Uint8> src = makePixels(width + 2, 3);
+            std::vector<sf::Uint8> dst = makePixels(width + 1, 4);
+
+            // Copy the source without its first column and first row, one pixel to the right
+            std::vector<sf::Uint8> expected = dst;
+            for (unsigned int y = 0; y < height - 1; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    std::size_t from = ((y + 1) * (width + 2) + x + 1) * 4;
+                    std::size_t to = (y * (width + 1) + x + 1) * 4;
+                    blend(&src[from], &dst[to], sf::Image::Alpha, &expected[to]);
+                }
+            }
+
+            sf::Image source;
+            sf::Image destination;
+            source.create(width + 2, height, &src[0]);
+            destination.create(width + 1, height, &dst[0]);
+            destination.blit(source, 1, 0, sf::IntRect(1, 1, width, height - 1));
+
+            INFO("Width " << width);
+            CHECK(hasPixels(destination, expected));
+
+            // copy with applyAlpha is the same as blit with the Alpha equation
+            sf::Image copied;
+            copied.create(width + 1, height, &dst[0]);
+            copied.copy(source, 1, 0, sf::IntRect(1, 1, width, height - 1), true);
+            CHECK(hasPixels(copied, expected));
+        }
+    }
+
+    SECTION("createMaskFromColor")
+    {
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const unsigned int width = widths[w];
+            std::vector<sf::Uint8> pixels = makePixels(width, 5);
+
+            // Make one pixel out of three match the key color
+            for (std::size_t i = 0; i < pixels.size(); i += 12)
+            {
+                pixels[i]     = 10;
+                pixels[i + 1] = 20;
+                pixels[i + 2] = 30;
+                pixels[i + 3] = 40;
+            }
+
+            // Pixels differing only by their alpha are not masked
+            pixels[pixels.size() - 4] = 10;
+            pixels[pixels.size() - 3] = 20;
+            pixels[pixels.size() - 2] = 30;
+            pixels[pixels.size() - 1] = 41;
+
+            std::vector<sf::Uint8> expected = pixels;
+            for (std::size_t i = 0; i < expected.size(); i += 4)
+            {
+                if ((pixels[i] == 10) && (pixels[i + 1] == 20) && (pixels[i + 2] == 30) && (pixels[i + 3] == 40))
+                    expected[i + 3] = 77;
+            }
+
+            sf::Image image;
+            image.create(width, height, &pixels[0]);
+            image.createMaskFromColor(sf::Color(10, 20, 30, 40), 77);
+
+            INFO("Width " << width);
+            CHECK(hasPixels(image, expected));
+        }
+    }
+
+    SECTION("flipHorizontally")
+    {
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const unsigned int width = widths[w];
+            std::vector<sf::Uint8> pixels = makePixels(width, 6);
+
+            std::vector<sf::Uint8> expected(pixels.size());
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int x = 0; x < width; ++x)
+                {
+                    for (unsigned int i = 0; i < 4; ++i)
+                        expected[(y * width + x) * 4 + i] = pixels[(y * width + width - 1 - x) * 4 + i];
+                }
+            }
+
+            sf::Image image;
+            image.create(width, height, &pixels[0]);
+            image.flipHorizontally();
+
+            INFO("Width " << width);
+            CHECK(hasPixels(image, expected));
+        }
+    }
+
+    SECTION("flipVertically")
+    {
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const unsigned int width = widths[w];
+            std::vector<sf::Uint8> pixels = makePixels(width, 7);
+
+            std::vector<sf::Uint8> expected(pixels.size());
+            for (unsigned int y = 0; y < height; ++y)
+            {
+                for (unsigned int i = 0; i < width * 4; ++i)
+                    expected[y * width * 4 + i] = pixels[(height - 1 - y) * width * 4 + i];
+            }
+
+            sf::Image image;
+            image.create(width, height, &pixels[0]);
+            image.flipVertically();
+
+            INFO("Width " << width);
+            CHECK(hasPixels(image, expected));
+        }
+    }
+
+    SECTION("premultiplyAlpha")
+    {
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const unsigned int width = widths[w];
+            std::vector<sf::Uint8> pixels = makePixels(width, 8);
+
+            std::vector<sf::Uint8> expected = pixels;
+            for (std::size_t i = 0; i < expected.size(); i += 4)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                    expected[i + j] = divide255Rounded(pixels[i + j] * pixels[i + 3]);
+            }
+
+            sf::Image image;
+            image.create(width, height, &pixels[0]);
+            image.premultiplyAlpha();
+
+            INFO("Width " << width);
+            CHECK(hasPixels(image, expected));
+        }
+    }
+
+    SECTION("swizzleChannels")
+    {
+        const unsigned int orders[][4] = {{2, 1, 0, 3}, {3, 2, 1, 0}, {0, 0, 0, 3}, {2, 3, 0, 0}, {0, 1, 2, 3}};
+
+        for (std::size_t o = 0; o < 5; ++o)
+        {
+            const unsigned int* order = orders[o];
+            for (std::size_t w = 0; w < 8; ++w)
+            {
+                const unsigned int width = widths[w];
+                std::vector<sf::Uint8> pixels = makePixels(width, 9);
+
+                std::vector<sf::Uint8> expected(pixels.size());
+                for (std::size_t i = 0; i < expected.size(); i += 4)
+                {
+                    for (std::size_t j = 0; j < 4; ++j)
+                        expected[i + j] = pixels[i + order[j]];
+                }
+
+                sf::Image image;
+                image.create(width, height, &pixels[0]);
+                image.swizzleChannels(order[0], order[1], order[2], order[3]);
+
+                INFO("Order " << o << ", width " << width);
+                CHECK(hasPixels(image, expected));
+            }
+        }
+
+        SECTION("Invalid index")
+        {
+            std::vector<sf::Uint8> pixels = makePixels(9, 10);
+
+            sf::Image image;
+            image.create(9, height, &pixels[0]);
+            image.swizzleChannels(0, 1, 4, 3);
+
+            CHECK(hasPixels(image, pixels));
+        }
+    }
+
+    SECTION("fillRect")
+    {
+        const sf::Color background(9, 8, 7, 6);
+        const sf::Color color(1, 2, 3, 4);
+
+        for (std::size_t w = 0; w < 8; ++w)
+        {
+            const int width = static_cast<int>(widths[w]);
+
+            // Inside the image, then clipped on each side, then completely outside
+            const sf::IntRect rectangles[] =
+            {
+                sf::IntRect(0, 0, width, static_cast<int>(height)),
+                sf::IntRect(width / 2, 1, (width + 1) / 2, 1),
+                sf::IntRect(-2, 1, width / 2 + 3, 2),
+                sf::IntRect(width / 3, -1, width, 2),
+                sf::IntRect(-5, -5, width + 10, static_cast<int>(height) + 10),
+                sf::IntRect(width, 0, 4, 1),
+                sf::IntRect(0, static_cast<int>(height), width, 1),
+                sf::IntRect(-4, 0, 4, 1)
+            };
+
+            for (std::size_t r = 0; r < 8; ++r)
+            {
+                const sf::IntRect& rectangle = rectangles[r];
+
+                std::vector<sf::Uint8> expected;
+                for (int y = 0; y < static_cast<int>(height); ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const sf::Color& pixel = rectangle.contains(x, y) ? color : background;
+                        expected.push_back(pixel.r);
+                        expected.push_back(pixel.g);
+                        expected.push_back(pixel.b);
+                        expected.push_back(pixel.a);
+                    }
+                }
+
+                sf::Image image;
+                image.create(static_cast<unsigned int>(width), height, background);
+                image.fillRect(rectangle, color);
+
+                INFO("Rectangle " << r << ", width " << width);
+                CHECK(hasPixels(image, expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("sf::Image class - loadFromFiles", "[graphics]")
+{
+    const std::string directory = std::filesystem::temp_directory_path().string() + "/";
+    const std::string first     = directory + "sfml-test-loadFromFiles-first.png";
+    const std::string second    = directory + "sfml-test-loadFromFiles-second.png";
+    const std::string missing   = directory + "sfml-test-loadFromFiles-missing.png";
+    const std::string corrupt   = directory + "sfml-test-loadFromFiles-corrupt.png";
+
+    const std::vector<sf::Uint8> firstPixels  = makePixels(4, 1);
+    const std::vector<sf::Uint8> secondPixels = makePixels(7, 2);
+
+    sf::Image image;
+    image.create(4, height, firstPixels.data());
+    REQUIRE(image.saveToFile(first));
+    image.create(7, height, secondPixels.data());
+    REQUIRE(image.saveToFile(second));
+
+    {
+        std::ofstream file(corrupt.c_str(), std::ios::binary);
+        file << "\x89PNG, but not really";
+    }
+    std::remove(missing.c_str());
+
+    // With as many threads as files, or fewer, or more
+    const unsigned int threadCounts[] = {0, 1, 2, 3, 8};
+
+    SECTION("All files valid")
+    {
+        std::vector<std::string> filenames;
+        filenames.push_back(first);
+        filenames.push_back(second);
+
+        for (std::size_t t = 0; t < 5; ++t)
+        {
+            INFO("Thread count " << threadCounts[t]);
+
+            std::vector<sf::Image> images;
+            CHECK(sf::Image::loadFromFiles(filenames, images, threadCounts[t]));
+            REQUIRE(images.size() == 2);
+            CHECK(hasPixels(images[0], firstPixels));
+            CHECK(hasPixels(images[1], secondPixels));
+        }
+    }
+
+    SECTION("Missing or corrupt file in the middle of the list")
+    {
+        std::vector<std::string> filenames;
+        filenames.push_back(first);
+        filenames.push_back(missing);
+        filenames.push_back(second);
+        filenames.push_back(corrupt);
+        filenames.push_back(first);
+
+        for (std::size_t t = 0; t < 5; ++t)
+        {
+            INFO("Thread count " << threadCounts[t]);
+
+            // The failure is reported, and the other files are still loaded
+            std::vector<sf::Image> images;
+            CHECK_FALSE(sf::Image::loadFromFiles(filenames, images, threadCounts[t]));
+            REQUIRE(images.size() == 5);
+            CHECK(hasPixels(images[0], firstPixels));
+            CHECK(images[1].getSize() == sf::Vector2u(0, 0));
+            CHECK(hasPixels(images[2], secondPixels));
+            CHECK(images[3].getSize() == sf::Vector2u(0, 0));
+            CHECK(hasPixels(images[4], firstPixels));
+        }
+    }
+
+    SECTION("Empty list")
+    {
+        std::vector<sf::Image> images(2);
+        CHECK(sf::Image::loadFromFiles(std::vector<std::string>(), images));
+        CHECK(images.empty());
+    }
+
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+    std::remove(corrupt.c_str());
+}
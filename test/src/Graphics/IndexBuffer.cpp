@@ -0,0 +1,108 @@
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::IndexBuffer class - storage", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    REQUIRE(sf::IndexBuffer::isAvailable());
+
+    const sf::Uint16 indices16[6] = {0, 1, 2, 2, 1, 3};
+    const sf::Uint32 indices32[6] = {0, 1, 2, 2, 1, 3};
+
+    sf::IndexBuffer buffer(sf::IndexBuffer::Index16, sf::VertexBuffer::Static);
+    REQUIRE(buffer.create(6));
+    CHECK(buffer.getIndexCount() == 6);
+
+    SECTION("Updates must match the index type")
+    {
+        CHECK(buffer.update(indices16, 6));
+        CHECK(buffer.update(indices16, 3, 3));
+        CHECK_FALSE(buffer.update(indices32, 6));
+        CHECK_FALSE(buffer.update(indices16, 3, 4));
+    }
+
+    SECTION("Changing the index type discards the contents")
+    {
+        buffer.setIndexType(sf::IndexBuffer::Index32);
+        CHECK(buffer.getIndexType() == sf::IndexBuffer::Index32);
+        CHECK(buffer.getIndexCount() == 0);
+
+        // The previous index type is refused, and nothing fits at an offset until the buffer is created again
+        CHECK_FALSE(buffer.update(indices16, 6));
+        CHECK_FALSE(buffer.update(indices32, 3, 3));
+
+        REQUIRE(buffer.create(6));
+        CHECK(buffer.update(indices32, 6));
+        CHECK(buffer.update(indices32, 3, 3));
+    }
+
+    SECTION("Copies between buffers")
+    {
+        REQUIRE(buffer.update(indices16, 6));
+
+        sf::IndexBuffer larger(sf::IndexBuffer::Index16);
+        REQUIRE(larger.create(12));
+
+        sf::IndexBuffer other(sf::IndexBuffer::Index32);
+        REQUIRE(other.create(6));
+
+        CHECK(larger.update(buffer));
+        CHECK_FALSE(buffer.update(larger));
+        CHECK_FALSE(other.update(buffer));
+
+        sf::IndexBuffer copy(buffer);
+        CHECK(copy.getIndexType() == sf::IndexBuffer::Index16);
+        CHECK(copy.getIndexCount() == 6);
+    }
+}
+
+TEST_CASE("sf::IndexBuffer class - indexed drawing", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    REQUIRE(sf::IndexBuffer::isAvailable());
+
+    // A quad of 4 vertices, split in two triangles along its diagonal
+    const sf::Vertex vertices[4] =
+    {
+        sf::Vertex(sf::Vector2f(0.f,  0.f),  sf::Colors::Red),
+        sf::Vertex(sf::Vector2f(32.f, 0.f),  sf::Colors::Red),
+        sf::Vertex(sf::Vector2f(0.f,  32.f), sf::Colors::Red),
+        sf::Vertex(sf::Vector2f(32.f, 32.f), sf::Colors::Red)
+    };
+    const sf::Uint16 indices[6] = {0, 1, 2, 2, 1, 3};
+
+    sf::VertexBuffer vertexBuffer(sf::Triangles, sf::VertexBuffer::Static);
+    REQUIRE(vertexBuffer.create(4));
+    REQUIRE(vertexBuffer.update(vertices));
+
+    sf::IndexBuffer indexBuffer(sf::IndexBuffer::Index16, sf::VertexBuffer::Static);
+    REQUIRE(indexBuffer.create(6));
+    REQUIRE(indexBuffer.update(indices, 6));
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(32, 32));
+    target.clear(sf::Colors::Transparent);
+
+    SECTION("Whole buffer")
+    {
+        target.draw(vertexBuffer, indexBuffer);
+        target.display();
+
+        sf::Image image = target.getTexture().copyToImage();
+        CHECK(image.getPixel(4, 4) == sf::Colors::Red);
+        CHECK(image.getPixel(27, 27) == sf::Colors::Red);
+    }
+
+    SECTION("Index range")
+    {
+        // Only the second triangle, below the diagonal
+        target.draw(vertexBuffer, indexBuffer, 3, 3);
+        target.display();
+
+        sf::Image image = target.getTexture().copyToImage();
+        CHECK(image.getPixel(4, 4) == sf::Colors::Transparent);
+        CHECK(image.getPixel(27, 27) == sf::Colors::Red);
+    }
+}
@@ -0,0 +1,96 @@
+#include <SFML/Graphics/InstanceBuffer.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include "GraphicsUtil.hpp"
+
+namespace
+{
+    // Instances are 4x4 squares placed every 8 pixels on a row
+    sf::InstanceBuffer::Instance makeInstance(unsigned int column, const sf::Color& color)
+    {
+        sf::Transform transform;
+        transform.translate(static_cast<float>(column * 8), 0.f);
+        return sf::InstanceBuffer::Instance(transform, color);
+    }
+
+    sf::Image render(const sf::VertexBuffer& mesh, const sf::InstanceBuffer& instances)
+    {
+        sf::RenderTexture target;
+        REQUIRE(target.create(64, 4));
+
+        target.clear(sf::Colors::Transparent);
+        target.drawInstanced(mesh, instances);
+        target.display();
+
+        return target.getTexture().copyToImage();
+    }
+
+    sf::Color getColumnColor(const sf::Image& image, unsigned int column)
+    {
+        return image.getPixel(column * 8 + 2, 2);
+    }
+}
+
+TEST_CASE("sf::InstanceBuffer class - uploads", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    const sf::Vertex vertices[6] =
+    {
+        sf::Vertex(sf::Vector2f(0.f, 0.f)),
+        sf::Vertex(sf::Vector2f(4.f, 0.f)),
+        sf::Vertex(sf::Vector2f(0.f, 4.f)),
+        sf::Vertex(sf::Vector2f(0.f, 4.f)),
+        sf::Vertex(sf::Vector2f(4.f, 0.f)),
+        sf::Vertex(sf::Vector2f(4.f, 4.f))
+    };
+
+    sf::VertexBuffer mesh(sf::Triangles, sf::VertexBuffer::Static);
+    REQUIRE(mesh.create(6));
+    REQUIRE(mesh.update(vertices));
+
+    sf::InstanceBuffer instances;
+    for (unsigned int i = 0; i < 4; ++i)
+        instances.append(makeInstance(i, sf::Colors::Red));
+
+    sf::Image image = render(mesh, instances);
+    for (unsigned int i = 0; i < 4; ++i)
+        CHECK(getColumnColor(image, i) == sf::Colors::Red);
+    CHECK(getColumnColor(image, 4) == sf::Colors::Transparent);
+
+    // Shrinking reuses the storage, only the remaining instances are drawn
+    instances.resize(2);
+    CHECK(instances.getInstanceCount() == 2);
+
+    image = render(mesh, instances);
+    CHECK(getColumnColor(image, 0) == sf::Colors::Red);
+    CHECK(getColumnColor(image, 1) == sf::Colors::Red);
+    CHECK(getColumnColor(image, 2) == sf::Colors::Transparent);
+    CHECK(getColumnColor(image, 3) == sf::Colors::Transparent);
+
+    // Growing past the previous size
+    for (unsigned int i = 2; i < 7; ++i)
+        instances.append(makeInstance(i, sf::Colors::Green));
+    CHECK(instances.getInstanceCount() == 7);
+
+    image = render(mesh, instances);
+    CHECK(getColumnColor(image, 0) == sf::Colors::Red);
+    CHECK(getColumnColor(image, 1) == sf::Colors::Red);
+    for (unsigned int i = 2; i < 7; ++i)
+        CHECK(getColumnColor(image, i) == sf::Colors::Green);
+    CHECK(getColumnColor(image, 7) == sf::Colors::Transparent);
+
+    // Modifying an instance uploads it again
+    instances.setInstance(0, makeInstance(7, sf::Colors::Blue));
+
+    image = render(mesh, instances);
+    CHECK(getColumnColor(image, 0) == sf::Colors::Transparent);
+    CHECK(getColumnColor(image, 7) == sf::Colors::Blue);
+
+    // Nothing is drawn once cleared
+    instances.clear();
+
+    image = render(mesh, instances);
+    for (unsigned int i = 0; i < 8; ++i)
+        CHECK(getColumnColor(image, i) == sf::Colors::Transparent);
+}
@@ -0,0 +1,56 @@
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/OpenGL.hpp>
+#include "GraphicsUtil.hpp"
+
+namespace
+{
+    bool isDepthMaskEnabled()
+    {
+        GLboolean mask = GL_FALSE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+        return mask == GL_TRUE;
+    }
+}
+
+TEST_CASE("sf::RenderTarget class - depth states", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    sf::ContextSettings settings;
+    settings.depthBits = 24;
+
+    sf::RenderTexture target;
+    REQUIRE(target.create(16, 16, settings));
+
+    sf::RectangleShape shape(sf::Vector2f(8, 8));
+
+    SECTION("Depth writes are left enabled by default draws")
+    {
+        target.draw(shape);
+        target.flush();
+        REQUIRE(target.setActive(true));
+        CHECK(isDepthMaskEnabled());
+
+        target.resetGLStates();
+        CHECK(isDepthMaskEnabled());
+    }
+
+    SECTION("Read-only depth modes disable depth writes until the next mode")
+    {
+        sf::RenderStates states;
+        states.depthMode = sf::DepthMode(sf::DepthMode::LessEqual, false);
+
+        target.draw(shape, states);
+        target.flush();
+        REQUIRE(target.setActive(true));
+        CHECK(!isDepthMaskEnabled());
+
+        // Clearing doesn't change the mask of the current mode
+        target.clear();
+        CHECK(!isDepthMaskEnabled());
+
+        target.draw(shape);
+        target.flush();
+        REQUIRE(target.setActive(true));
+        CHECK(isDepthMaskEnabled());
+    }
+}
@@ -0,0 +1,202 @@
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Insert rectangles until the packer is full, and return their areas
+    std::vector<sf::IntRect> fill(sf::priv::SkylinePacker& packer, const std::vector<sf::Vector2u>& sizes)
+    {
+        std::vector<sf::IntRect> rectangles;
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            sf::Vector2u position;
+            if (packer.insert(sizes[i], position))
+                rectangles.push_back(sf::IntRect(position.x, position.y, sizes[i].x, sizes[i].y));
+        }
+
+        return rectangles;
+    }
+
+    // Check that the rectangles are inside the area and don't overlap each other
+    bool arePacked(const std::vector<sf::IntRect>& rectangles, const sf::Vector2u& size)
+    {
+        for (std::size_t i = 0; i < rectangles.size(); ++i)
+        {
+            const sf::IntRect& rectangle = rectangles[i];
+            if ((rectangle.left < 0) || (rectangle.top < 0) ||
+                (rectangle.left + rectangle.width > static_cast<int>(size.x)) ||
+                (rectangle.top + rectangle.height > static_cast<int>(size.y)))
+                return false;
+
+            for (std::size_t j = i + 1; j < rectangles.size(); ++j)
+            {
+                if (rectangle.intersects(rectangles[j]))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+TEST_CASE("sf::priv::SkylinePacker class", "[graphics]")
+{
+    SECTION("Construction")
+    {
+        SECTION("Default constructor")
+        {
+            sf::priv::SkylinePacker packer;
+            sf::Vector2u position;
+
+            CHECK(packer.getSize() == sf::Vector2u(0, 0));
+            CHECK(packer.getUsedHeight() == 0);
+            CHECK(packer.insert(sf::Vector2u(1, 1), position) == false);
+        }
+
+        SECTION("Size constructor")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 32));
+
+            CHECK(packer.getSize() == sf::Vector2u(64, 32));
+            CHECK(packer.getUsedHeight() == 0);
+        }
+    }
+
+    SECTION("Insertion")
+    {
+        SECTION("Exact fit")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 32));
+            sf::Vector2u position(1, 1);
+
+            CHECK(packer.insert(sf::Vector2u(64, 32), position) == true);
+            CHECK(position == sf::Vector2u(0, 0));
+            CHECK(packer.getUsedHeight() == 32);
+            CHECK(packer.insert(sf::Vector2u(1, 1), position) == false);
+        }
+
+        SECTION("Exact fit of a grid of rectangles")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 64));
+            std::vector<sf::IntRect> rectangles = fill(packer, std::vector<sf::Vector2u>(16, sf::Vector2u(16, 16)));
+
+            CHECK(rectangles.size() == 16);
+            CHECK(arePacked(rectangles, packer.getSize()));
+            CHECK(packer.getUsedHeight() == 64);
+        }
+
+        SECTION("Rejection of empty rectangles")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 64));
+            sf::Vector2u position;
+
+            CHECK(packer.insert(sf::Vector2u(0, 16), position) == false);
+            CHECK(packer.insert(sf::Vector2u(16, 0), position) == false);
+        }
+
+        SECTION("Rejection of rectangles larger than the area")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 32));
+            sf::Vector2u position;
+
+            CHECK(packer.insert(sf::Vector2u(65, 1), position) == false);
+            CHECK(packer.insert(sf::Vector2u(1, 33), position) == false);
+            CHECK(packer.getUsedHeight() == 0);
+        }
+
+        SECTION("Rejection when full")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(32, 32));
+            sf::Vector2u position;
+
+            CHECK(packer.insert(sf::Vector2u(32, 20), position) == true);
+            CHECK(packer.insert(sf::Vector2u(32, 13), position) == false);
+            CHECK(packer.insert(sf::Vector2u(32, 12), position) == true);
+            CHECK(position == sf::Vector2u(0, 20));
+            CHECK(packer.insert(sf::Vector2u(1, 1), position) == false);
+        }
+
+        SECTION("Rectangles never overlap")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(128, 128));
+
+            std::vector<sf::Vector2u> sizes;
+            for (unsigned int i = 0; i < 200; ++i)
+                sizes.push_back(sf::Vector2u(1 + (i * 7) % 23, 1 + (i * 11) % 17));
+
+            std::vector<sf::IntRect> rectangles = fill(packer, sizes);
+
+            CHECK(rectangles.size() > 20);
+            CHECK(arePacked(rectangles, packer.getSize()));
+        }
+
+        SECTION("Padding")
+        {
+            // Like sf::TextureAtlas: the padding is reserved on the right and
+            // bottom of each rectangle, so the visible parts are kept apart
+            const unsigned int padding = 2;
+            sf::priv::SkylinePacker packer(sf::Vector2u(64, 64));
+
+            std::vector<sf::Vector2u> sizes;
+            for (unsigned int i = 0; i < 40; ++i)
+                sizes.push_back(sf::Vector2u(3 + i % 5 + padding, 2 + i % 7 + padding));
+
+            std::vector<sf::IntRect> rectangles = fill(packer, sizes);
+            REQUIRE(rectangles.size() > 10);
+            CHECK(arePacked(rectangles, packer.getSize()));
+
+            for (std::size_t i = 0; i < rectangles.size(); ++i)
+            {
+                sf::IntRect visible(rectangles[i].left, rectangles[i].top, rectangles[i].width - padding, rectangles[i].height - padding);
+                for (std::size_t j = 0; j < rectangles.size(); ++j)
+                {
+                    if (i == j)
+                        continue;
+
+                    // Growing the visible part by the padding on every side
+                    // must still not reach the visible part of another rectangle
+                    sf::IntRect other(rectangles[j].left, rectangles[j].top, rectangles[j].width - padding, rectangles[j].height - padding);
+                    sf::IntRect grown(visible.left - static_cast<int>(padding), visible.top - static_cast<int>(padding),
+                                      visible.width + 2 * static_cast<int>(padding), visible.height + 2 * static_cast<int>(padding));
+                    CHECK(grown.intersects(other) == false);
+                }
+            }
+        }
+    }
+
+    SECTION("Reset and growth")
+    {
+        SECTION("reset")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(16, 16));
+            sf::Vector2u position;
+
+            CHECK(packer.insert(sf::Vector2u(16, 16), position) == true);
+            packer.reset(sf::Vector2u(32, 32));
+            CHECK(packer.getSize() == sf::Vector2u(32, 32));
+            CHECK(packer.getUsedHeight() == 0);
+            CHECK(packer.insert(sf::Vector2u(32, 32), position) == true);
+        }
+
+        SECTION("grow")
+        {
+            sf::priv::SkylinePacker packer(sf::Vector2u(16, 16));
+            sf::Vector2u position;
+
+            CHECK(packer.insert(sf::Vector2u(16, 16), position) == true);
+            packer.grow(sf::Vector2u(32, 32));
+            CHECK(packer.getSize() == sf::Vector2u(32, 32));
+
+            // The existing rectangle keeps its place, the new space is usable
+            std::vector<sf::IntRect> rectangles(1, sf::IntRect(0, 0, 16, 16));
+            std::vector<sf::IntRect> added = fill(packer, std::vector<sf::Vector2u>(3, sf::Vector2u(16, 16)));
+            rectangles.insert(rectangles.end(), added.begin(), added.end());
+
+            CHECK(added.size() == 3);
+            CHECK(arePacked(rectangles, packer.getSize()));
+            CHECK(packer.insert(sf::Vector2u(1, 1), position) == false);
+        }
+    }
+}
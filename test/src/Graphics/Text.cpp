@@ -0,0 +1,197 @@
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include "GraphicsUtil.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // All the characters used by the tests, loaded beforehand so that the
+    // font texture doesn't change and the edits are applied in place
+    const char* const characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ .,!\n";
+
+    sf::Text makeText(const sf::Font& font, const sf::String& string, sf::Uint32 style, float outlineThickness)
+    {
+        sf::Text text(string, font, 24);
+        text.setStyle(style);
+        text.setOutlineThickness(outlineThickness);
+        return text;
+    }
+
+    sf::Image render(const sf::Text& text)
+    {
+        sf::RenderTexture target;
+        REQUIRE(target.create(512, 256));
+
+        target.clear(sf::Colors::Transparent);
+        target.draw(text);
+        target.display();
+
+        return target.getTexture().copyToImage();
+    }
+
+    bool haveSamePixels(const sf::Image& left, const sf::Image& right)
+    {
+        return (left.getSize() == right.getSize()) &&
+               (std::memcmp(left.getPixelsPtr(), right.getPixelsPtr(), left.getSize().x * left.getSize().y * 4) == 0);
+    }
+
+    // Check that an edited text is the same as a text built from its whole string
+    void checkSameAsRebuilt(const sf::Text& edited)
+    {
+        sf::Text rebuilt = makeText(*edited.getFont(), edited.getString(), edited.getStyle(), edited.getOutlineThickness());
+
+        sf::FloatRect editedBounds  = edited.getLocalBounds();
+        sf::FloatRect rebuiltBounds = rebuilt.getLocalBounds();
+        CHECK(editedBounds.left == Approx(rebuiltBounds.left));
+        CHECK(editedBounds.top == Approx(rebuiltBounds.top));
+        CHECK(editedBounds.width == Approx(rebuiltBounds.width));
+        CHECK(editedBounds.height == Approx(rebuiltBounds.height));
+
+        for (std::size_t i = 0; i <= edited.getString().getSize(); ++i)
+        {
+            CHECK(edited.findCharacterPos(i).x == Approx(rebuilt.findCharacterPos(i).x));
+            CHECK(edited.findCharacterPos(i).y == Approx(rebuilt.findCharacterPos(i).y));
+        }
+
+        // The same pixels are drawn if the same vertices were generated
+        CHECK(haveSamePixels(render(edited), render(rebuilt)));
+    }
+
+    // Apply edits to a text, and compare it with a text built from the edited string after each one
+    void checkEdits(sf::Uint32 style, float outlineThickness)
+    {
+        sf::Font font;
+        REQUIRE(font.loadFromFile("resources/tuffy.ttf"));
+
+        // Load the glyphs, at the size and with the outline of the tested texts
+        makeText(font, characters, style, outlineThickness).getLocalBounds();
+
+        sf::Text text = makeText(font, "First line\nSecond line\nThird", style, outlineThickness);
+        text.getLocalBounds();
+
+        SECTION("Append")
+        {
+            text.appendString(" line");
+            checkSameAsRebuilt(text);
+
+            text.appendString("\nFourth, with a longer line than the others");
+            checkSameAsRebuilt(text);
+
+            text.appendString("\n\nLast.\n");
+            checkSameAsRebuilt(text);
+        }
+
+        SECTION("Insert")
+        {
+            text.insertString(0, "Zero\n");
+            checkSameAsRebuilt(text);
+
+            text.insertString(text.getString().find("Second"), "Between first and second\n");
+            checkSameAsRebuilt(text);
+
+            text.insertString(text.getString().find("line"), "long ");
+            checkSameAsRebuilt(text);
+
+            text.insertString(text.getString().getSize(), "!");
+            checkSameAsRebuilt(text);
+        }
+
+        SECTION("Erase")
+        {
+            // Join two lines
+            text.eraseString(text.getString().find("\n"), 1);
+            checkSameAsRebuilt(text);
+
+            // Remove the widest line
+            text.eraseString(0, text.getString().find("\n") + 1);
+            checkSameAsRebuilt(text);
+
+            text.eraseString(text.getString().getSize() - 2, 2);
+            checkSameAsRebuilt(text);
+
+            text.eraseString(0, text.getString().getSize());
+            checkSameAsRebuilt(text);
+            CHECK(text.getLocalBounds() == sf::FloatRect());
+        }
+    }
+
+    // Draw a text through a view which covers a horizontal strip of its local coordinates
+    sf::Image renderStrip(const sf::Text& text, float top, float bottom)
+    {
+        sf::RenderTexture target;
+        REQUIRE(target.create(64, 16));
+
+        sf::FloatRect bounds = text.getLocalBounds();
+        target.setView(sf::View(sf::FloatRect(bounds.left, top, bounds.width, bottom - top)));
+        target.clear(sf::Colors::Transparent);
+        target.draw(text);
+        target.display();
+
+        return target.getTexture().copyToImage();
+    }
+
+    unsigned int countPixels(const sf::Image& image, sf::Uint8 minAlpha)
+    {
+        unsigned int count = 0;
+        for (unsigned int y = 0; y < image.getSize().y; ++y)
+            for (unsigned int x = 0; x < image.getSize().x; ++x)
+                if (image.getPixel(x, y).a >= minAlpha)
+                    ++count;
+
+        return count;
+    }
+}
+
+TEST_CASE("sf::Text class - string edits", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    SECTION("Regular")
+    {
+        checkEdits(sf::Text::Regular, 0.f);
+    }
+
+    SECTION("Underlined, strike through and outlined")
+    {
+        checkEdits(sf::Text::Underlined | sf::Text::StrikeThrough, 2.f);
+    }
+}
+
+TEST_CASE("sf::Text class - culling", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile("resources/tuffy.ttf"));
+
+    const unsigned int characterSize    = 48;
+    const float        outlineThickness = 3.f;
+
+    // No descender, so that the underline is drawn below the glyphs
+    sf::Text text("ace", font, characterSize);
+    text.setStyle(sf::Text::Underlined | sf::Text::StrikeThrough);
+    text.setOutlineThickness(outlineThickness);
+
+    sf::FloatRect bounds = text.getLocalBounds();
+    float glyphsTop      = bounds.top;
+    float glyphsBottom   = bounds.top + bounds.height;
+
+    // Same computation as the text, the outline grows the underline on both sides
+    float thickness       = font.getUnderlineThickness(characterSize);
+    float underlineTop    = std::floor(static_cast<float>(characterSize) + font.getUnderlinePosition(characterSize) - thickness / 2 + 0.5f);
+    float underlineBottom = underlineTop + std::floor(thickness + 0.5f) + outlineThickness;
+    REQUIRE(underlineBottom > glyphsBottom + 2.f);
+
+    SECTION("View just above the text")
+    {
+        CHECK(countPixels(renderStrip(text, glyphsTop - 10.f, glyphsTop - 2.f), 1) == 0);
+        CHECK(countPixels(renderStrip(text, glyphsTop - 10.f, glyphsTop + 2.f), 128) > 0);
+    }
+
+    SECTION("View just below the text")
+    {
+        // Only the underline and its outline are drawn below the glyphs
+        CHECK(countPixels(renderStrip(text, glyphsBottom + 0.5f, underlineBottom + 8.f), 128) > 0);
+        CHECK(countPixels(renderStrip(text, underlineBottom + 2.f, underlineBottom + 10.f), 1) == 0);
+    }
+}
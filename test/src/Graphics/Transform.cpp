@@ -0,0 +1,158 @@
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Vertex3D.hpp>
+#include "GraphicsUtil.hpp"
+#include <vector>
+
+namespace
+{
+    // Point counts around the widths of the SSE, AVX and NEON kernels
+    const std::size_t counts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 17};
+
+    sf::Transform makeAffineTransform()
+    {
+        sf::Transform transform;
+        transform.translate(12.5f, -3.25f).rotate(30.f).scale(1.5f, -0.75f);
+        return transform;
+    }
+
+    // All the elements of the matrix are used, including the projection row
+    sf::Transform makeNonAffineTransform()
+    {
+        float matrix[16];
+        for (int i = 0; i < 16; ++i)
+            matrix[i] = 0.5f + static_cast<float>(i) * 0.25f - static_cast<float>(i % 3);
+
+        sf::Transform transform;
+        transform.setMatrix(matrix);
+        return transform;
+    }
+
+    float coordinate(std::size_t index, int component)
+    {
+        return static_cast<float>(index) * 3.75f - 20.f + static_cast<float>(component) * 1.125f;
+    }
+
+    void checkPoints(const sf::Transform& transform, std::size_t offset)
+    {
+        for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+        {
+            std::size_t count = counts[c];
+
+            // The arrays are offset from the start of their storage, so that they aren't aligned for SIMD loads and stores
+            std::vector<sf::Vector2f> points(count + offset);
+            std::vector<sf::Vector2f> result(count + offset, sf::Vector2f(-1.f, -1.f));
+            for (std::size_t i = 0; i < count; ++i)
+                points[offset + i] = sf::Vector2f(coordinate(i, 0), coordinate(i, 1));
+
+            transform.transformPoints(points.data() + offset, result.data() + offset, count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                sf::Vector2f expected = transform.transformPoint(points[offset + i]);
+                CHECK(result[offset + i].x == Approx(expected.x));
+                CHECK(result[offset + i].y == Approx(expected.y));
+            }
+
+            // Nothing is written outside of the result
+            for (std::size_t i = 0; i < offset; ++i)
+                CHECK(result[i] == sf::Vector2f(-1.f, -1.f));
+
+            // In place
+            std::vector<sf::Vector2f> inPlace(points);
+            transform.transformPoints(inPlace.data() + offset, inPlace.data() + offset, count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                CHECK(inPlace[offset + i].x == Approx(result[offset + i].x));
+                CHECK(inPlace[offset + i].y == Approx(result[offset + i].y));
+            }
+        }
+    }
+
+    void checkVertices(const sf::Transform& transform, std::size_t offset)
+    {
+        for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+        {
+            std::size_t count = counts[c];
+
+            std::vector<sf::Vertex> vertices(count + offset);
+            std::vector<sf::Vertex> result(count + offset);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                vertices[offset + i] = sf::Vertex(sf::Vector2f(coordinate(i, 0), coordinate(i, 1)),
+                                                  sf::Color(static_cast<sf::Uint8>(i), 20, 30, 40),
+                                                  sf::Vector2f(coordinate(i, 2), coordinate(i, 3)));
+            }
+
+            transform.transformPoints(vertices.data() + offset, result.data() + offset, count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const sf::Vertex& vertex = vertices[offset + i];
+                sf::Vector2f expected = transform.transformPoint(vertex.position);
+                CHECK(result[offset + i].position.x == Approx(expected.x));
+                CHECK(result[offset + i].position.y == Approx(expected.y));
+                CHECK(result[offset + i].color == vertex.color);
+                CHECK(result[offset + i].texCoords == vertex.texCoords);
+            }
+        }
+    }
+
+    void checkVertices3D(const sf::Transform& transform, std::size_t offset)
+    {
+        for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+        {
+            std::size_t count = counts[c];
+
+            std::vector<sf::Vertex3D> vertices(count + offset);
+            std::vector<sf::Vertex3D> result(count + offset);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                vertices[offset + i] = sf::Vertex3D(sf::Vector3f(coordinate(i, 0), coordinate(i, 1), coordinate(i, 2)),
+                                                    sf::Color(static_cast<sf::Uint8>(i), 20, 30, 40),
+                                                    sf::Vector2f(coordinate(i, 3), coordinate(i, 4)));
+            }
+
+            transform.transformPoints(vertices.data() + offset, result.data() + offset, count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const sf::Vertex3D& vertex = vertices[offset + i];
+                sf::Vector3f expected = transform.transformPoint(vertex.position);
+                CHECK(result[offset + i].position.x == Approx(expected.x));
+                CHECK(result[offset + i].position.y == Approx(expected.y));
+                CHECK(result[offset + i].position.z == Approx(expected.z));
+                CHECK(result[offset + i].color == vertex.color);
+                CHECK(result[offset + i].texCoords == vertex.texCoords);
+            }
+        }
+    }
+}
+
+TEST_CASE("sf::Transform class - batch transforms", "[graphics]")
+{
+    SECTION("Points")
+    {
+        checkPoints(makeAffineTransform(), 0);
+        checkPoints(makeAffineTransform(), 1);
+        checkPoints(makeNonAffineTransform(), 0);
+        checkPoints(makeNonAffineTransform(), 1);
+    }
+
+    SECTION("Vertices")
+    {
+        checkVertices(makeAffineTransform(), 0);
+        checkVertices(makeAffineTransform(), 1);
+        checkVertices(makeNonAffineTransform(), 0);
+        checkVertices(makeNonAffineTransform(), 1);
+    }
+
+    SECTION("3D vertices")
+    {
+        checkVertices3D(makeAffineTransform(), 0);
+        checkVertices3D(makeAffineTransform(), 1);
+        checkVertices3D(makeNonAffineTransform(), 0);
+        checkVertices3D(makeNonAffineTransform(), 1);
+    }
+}
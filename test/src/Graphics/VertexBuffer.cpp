@@ -0,0 +1,50 @@
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Vertex3D.hpp>
+#include "GraphicsUtil.hpp"
+
+TEST_CASE("sf::VertexBuffer class - vertex layout", "[graphics]" SFML_DISPLAY_TEST_TAG)
+{
+    REQUIRE(sf::VertexBuffer::isAvailable());
+
+    sf::Vertex vertices[4];
+    sf::Vertex3D vertices3D[4];
+
+    sf::VertexBuffer buffer(sf::Triangles, sf::VertexBuffer::Static);
+    CHECK(buffer.getVertexLayout() == sf::VertexBuffer::Layout2D);
+    CHECK(buffer.getVertexSize() == sizeof(sf::Vertex));
+
+    REQUIRE(buffer.create(4));
+    REQUIRE(buffer.update(vertices));
+    CHECK(buffer.getVertexCount() == 4);
+
+    SECTION("Setting the same layout keeps the contents")
+    {
+        buffer.setVertexLayout(sf::VertexBuffer::Layout2D);
+        CHECK(buffer.getVertexCount() == 4);
+        CHECK(buffer.update(vertices, 2, 2));
+    }
+
+    SECTION("Changing the layout discards the contents")
+    {
+        buffer.setVertexLayout(sf::VertexBuffer::Layout3D);
+        CHECK(buffer.getVertexLayout() == sf::VertexBuffer::Layout3D);
+        CHECK(buffer.getVertexSize() == sizeof(sf::Vertex3D));
+        CHECK(buffer.getVertexCount() == 0);
+
+        // The vertices of the previous layout are rejected
+        CHECK_FALSE(buffer.update(vertices, 4, 0));
+
+        // Nothing is copied without a vertex count, and nothing fits at an offset
+        CHECK(buffer.update(vertices3D));
+        CHECK(buffer.getVertexCount() == 0);
+        CHECK_FALSE(buffer.update(vertices3D, 2, 2));
+
+        // The buffer can be updated again once created with the new layout
+        REQUIRE(buffer.create(4));
+        CHECK(buffer.getVertexCount() == 4);
+        CHECK(buffer.update(vertices3D));
+        CHECK(buffer.update(vertices3D, 2, 2));
+        CHECK(buffer.getVertexCount() == 4);
+    }
+}
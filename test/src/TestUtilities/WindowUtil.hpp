@@ -10,6 +10,14 @@
 
 #include <SFML/Graphics/Rect.hpp>
 
+// Tag of the test cases which need a display and a graphics context;
+// they are hidden (not run by default) unless SFML_RUN_DISPLAY_TESTS is enabled
+#ifdef SFML_RUN_DISPLAY_TESTS
+    #define SFML_DISPLAY_TEST_TAG "[display]"
+#else
+    #define SFML_DISPLAY_TEST_TAG "[.display]"
+#endif
+
 // Forward declarations for non-template types
 namespace sf
 {